@@ -1,48 +0,0 @@
-#ifndef PERSONA_H
-#define PERSONA_H
-
-#include <string>
-#include <iostream>
-#include <iomanip>
-#include <tuple>
-// Estructura que representa una persona con datos personales y fiscales
-struct Persona {
-    // Datos básicos de identificación
-    std::string nombre;           // Nombre de pila
-    std::string apellido;         // Apellidos
-    std::string id;               // Identificador único
-    std::string ciudadResidencia; // Ciudad de residencia en Colombia
-    std::tuple<int,int,int> fechaNacimiento;  // Fecha de nacimiento en formato DD/MM/AAAA
-    
-    // Datos fiscales y económicos
-    double ingresosAnuales;       // Ingresos anuales en pesos colombianos
-    double patrimonio;            // Valor total de bienes y activos
-    double deudas;                // Deudas pendientes
-    std::string grupoDeclaracion; // Grupo de declaracion(A/B/C)
-
-    // --- Métodos de visualización ---
-    void mostrar() const;         // Muestra todos los detalles completos
-    void mostrarResumen() const;  // Muestra versión compacta para listados
-};
-
-// Implementación de métodos inline para mantener la estructura simple
-inline void Persona::mostrar() const {
-    std::cout << "-------------------------------------\n";
-    std::cout << "[" << id << "] Nombre: " << nombre << " " << apellido << "\n";
-    std::cout << "   - Ciudad de nacimiento: " << ciudadResidencia << "\n";
-    std::cout << "   - Fecha de nacimiento: " << std::get<0>(fechaNacimiento) <<"/"<<std::get<1>(fechaNacimiento)<<"/"<<std::get<2>(fechaNacimiento)<<"\n";
-    std::cout << std::fixed << std::setprecision(2);
-    std::cout << "   - Ingresos anuales: $" << ingresosAnuales << "\n";
-    std::cout << "   - Patrimonio: $" << patrimonio << "\n";
-    std::cout << "   - Deudas: $" << deudas << "\n";
-    std::cout << "   - Grupo de declaracion: " << (grupoDeclaracion) << "\n";
-}
-
-inline void Persona::mostrarResumen() const {
-    std::cout << "[" << id << "] " << nombre << " " << apellido
-              << " | " << ciudadResidencia
-              << " | $" << std::fixed << std::setprecision(2) << ingresosAnuales
-              << " | " << "Grupo renta:" << grupoDeclaracion;
-}
-
-#endif // PERSONA_H
\ No newline at end of file
@@ -0,0 +1,207 @@
+#include "agregados.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+const size_t NINGUNO = static_cast<size_t>(-1);
+
+// Bytes por fila de ColumnasPersona (id, nombre, apellido, ciudad, grupo, fecha y tres montos)
+const size_t BYTES_POR_FILA = sizeof(uint64_t) + 2 * sizeof(uint32_t) + sizeof(uint16_t) +
+                              sizeof(uint8_t) + sizeof(int32_t) + 3 * sizeof(double);
+
+// Conserva en actual el candidato con mayor clave; en empate, el que llegó primero
+void mejorar(Extremo& actual, Extremo&& candidato) {
+    if (!candidato.vacio && (actual.vacio || actual.clave < candidato.clave)) {
+        actual = std::move(candidato);
+    }
+}
+
+Extremo extremo(const ColumnasPersona& segmento, size_t fila, double clave) {
+    Extremo resultado;
+    resultado.clave = clave;
+    resultado.persona = segmento.materializar(fila);
+    resultado.vacio = false;
+    return resultado;
+}
+
+// Deja las limite filas de mayor patrimonio; el orden estable conserva la llegada en los empates
+void recortar(std::vector<FilaUmbral>& lista, size_t limite) {
+    std::stable_sort(lista.begin(), lista.end(),
+                     [](const FilaUmbral& a, const FilaUmbral& b) { return a.patrimonio > b.patrimonio; });
+    if (lista.size() > limite) {
+        lista.resize(limite);
+        lista.shrink_to_fit();
+    }
+}
+
+void mostrarPorClave(const MapaPlano<std::string, Extremo>& mapa) {
+    for (const auto& par : mapa) {
+        std::cout << "\n" << par.first << ":";
+        par.second.persona.mostrar();
+    }
+}
+
+} // namespace
+
+/**
+ * Implementación de EstadoAgregado::agregar.
+ *
+ * POR QUÉ: Buscar cada fila en un mapa de textos sería el costo dominante.
+ * CÓMO: Los códigos de ciudad y grupo indexan arreglos del tamaño del diccionario;
+ *       el recorrido solo guarda índices y al final se materializan los ganadores
+ *       en un estado del segmento que se combina con este.
+ * PARA QUÉ: Que el costo por fila sea el de un recorrido por columnas.
+ */
+void EstadoAgregado::agregar(const ColumnasPersona& segmento) {
+    const size_t n = segmento.tamano();
+    if (n == 0) return;
+    const Diccionarios& d = *segmento.diccionarios;
+    std::vector<size_t> longeva(d.ciudades.tamano(), NINGUNO);
+    std::vector<size_t> rica(d.ciudades.tamano(), NINGUNO);
+    std::vector<long double> total(d.ciudades.tamano(), 0.0L);
+    std::vector<size_t> ricaGrupo(d.grupos.tamano(), NINGUNO);
+    std::vector<size_t> sobreUmbral;
+    size_t longevaP = 0, ricaP = 0, deudaP = 0;
+
+    auto neto = [&](size_t i) { return segmento.patrimonio[i] - segmento.deudas[i]; };
+    for (size_t i = 0; i < n; ++i) {
+        uint16_t c = segmento.ciudad[i];
+        uint8_t g = segmento.grupo[i];
+        if (longeva[c] == NINGUNO || segmento.fecha[i] < segmento.fecha[longeva[c]]) longeva[c] = i;
+        if (rica[c] == NINGUNO || neto(rica[c]) < neto(i)) rica[c] = i;
+        if (ricaGrupo[g] == NINGUNO || neto(ricaGrupo[g]) < neto(i)) ricaGrupo[g] = i;
+        total[c] += segmento.patrimonio[i];
+        if (segmento.fecha[i] < segmento.fecha[longevaP]) longevaP = i;
+        if (neto(ricaP) < neto(i)) ricaP = i;
+        if (segmento.deudas[deudaP] < segmento.deudas[i]) deudaP = i;
+        if (segmento.patrimonio[i] > umbral) sobreUmbral.push_back(i);
+    }
+
+    EstadoAgregado parcial;
+    parcial.umbral = umbral;
+    parcial.limiteListado = limiteListado;
+    parcial.diccionarios = segmento.diccionarios;
+    parcial.filas = n;
+    parcial.longevaPais = extremo(segmento, longevaP, -segmento.fecha[longevaP]);
+    parcial.mayorPatrimonioPais = extremo(segmento, ricaP, neto(ricaP));
+    parcial.mayorDeudaPais = extremo(segmento, deudaP, segmento.deudas[deudaP]);
+    for (uint32_t c = 0; c < longeva.size(); ++c) {
+        if (longeva[c] == NINGUNO) continue;
+        const std::string& ciudad = d.ciudades.valor(c);
+        parcial.longevaPorCiudad.insertar(ciudad, extremo(segmento, longeva[c], -segmento.fecha[longeva[c]]));
+        parcial.mayorPatrimonioPorCiudad.insertar(ciudad, extremo(segmento, rica[c], neto(rica[c])));
+        parcial.patrimonioPorCiudad.insertar(ciudad, total[c]);
+    }
+    for (uint32_t g = 0; g < ricaGrupo.size(); ++g) {
+        if (ricaGrupo[g] == NINGUNO) continue;
+        parcial.mayorPatrimonioPorGrupo.insertar(d.grupos.valor(g), extremo(segmento, ricaGrupo[g], neto(ricaGrupo[g])));
+    }
+    for (size_t i : sobreUmbral) {
+        parcial.patrimonioMayorUmbral[d.ciudades.valor(segmento.ciudad[i])].push_back(
+            FilaUmbral{segmento.nombre[i], segmento.apellido[i], segmento.patrimonio[i]});
+    }
+    for (const auto& par : parcial.patrimonioMayorUmbral) parcial.cantidadMayorUmbral.insertar(par.first, par.second.size());
+    combinar(std::move(parcial));
+}
+
+void EstadoAgregado::combinar(EstadoAgregado&& otro) {
+    filas += otro.filas;
+    mejorar(longevaPais, std::move(otro.longevaPais));
+    mejorar(mayorPatrimonioPais, std::move(otro.mayorPatrimonioPais));
+    mejorar(mayorDeudaPais, std::move(otro.mayorDeudaPais));
+    for (auto& par : otro.longevaPorCiudad) mejorar(longevaPorCiudad[par.first], std::move(par.second));
+    for (auto& par : otro.mayorPatrimonioPorCiudad) mejorar(mayorPatrimonioPorCiudad[par.first], std::move(par.second));
+    for (auto& par : otro.mayorPatrimonioPorGrupo) mejorar(mayorPatrimonioPorGrupo[par.first], std::move(par.second));
+    for (const auto& par : otro.patrimonioPorCiudad) patrimonioPorCiudad[par.first] += par.second;
+    for (const auto& par : otro.cantidadMayorUmbral) cantidadMayorUmbral[par.first] += par.second;
+    if (!diccionarios) diccionarios = otro.diccionarios;
+    if (otro.diccionarios && otro.diccionarios != diccionarios) {
+        const Diccionarios& suyos = *otro.diccionarios;
+        for (auto& par : otro.patrimonioMayorUmbral) {
+            for (FilaUmbral& fila : par.second) {
+                fila.nombre = diccionarios->nombres.codificar(suyos.nombres.valor(fila.nombre));
+                fila.apellido = diccionarios->apellidos.codificar(suyos.apellidos.valor(fila.apellido));
+            }
+        }
+    }
+    for (auto& par : otro.patrimonioMayorUmbral) {
+        auto& lista = patrimonioMayorUmbral[par.first];
+        if (lista.empty()) {
+            lista = std::move(par.second);
+        } else {
+            lista.insert(lista.end(), std::make_move_iterator(par.second.begin()),
+                         std::make_move_iterator(par.second.end()));
+        }
+        if (limiteListado != SIN_LIMITE) recortar(lista, limiteListado);
+    }
+}
+
+std::pair<std::string, long double> EstadoAgregado::ciudadMayorPatrimonio() const {
+    std::pair<std::string, long double> mejor{"", 0};
+    for (const auto& par : patrimonioPorCiudad) {
+        if (par.second > mejor.second) mejor = par;
+    }
+    return mejor;
+}
+
+void mostrarReporte(const EstadoAgregado& estado) {
+    std::cout << "\n=== REPORTE COMPLETO (" << estado.filas << " personas) ===\n";
+    if (estado.filas == 0) return;
+    std::cout << "\nPersona mas longeva en el país:\n";
+    estado.longevaPais.persona.mostrar();
+    std::cout << "\nPersona mas longeva por ciudad:";
+    mostrarPorClave(estado.longevaPorCiudad);
+    std::cout << "\nPersona con mayor patrimonio en el país:\n";
+    estado.mayorPatrimonioPais.persona.mostrar();
+    std::cout << "\nPersona con mayor patrimonio por ciudad:";
+    mostrarPorClave(estado.mayorPatrimonioPorCiudad);
+    std::cout << "\nPersona con mayor patrimonio por grupo de declaración:";
+    mostrarPorClave(estado.mayorPatrimonioPorGrupo);
+    std::cout << "\nPersona con mayor endeudamiento en el país:\n";
+    estado.mayorDeudaPais.persona.mostrar();
+    auto ciudad = estado.ciudadMayorPatrimonio();
+    std::cout << "Ciudad con mayor patrimonio: " << ciudad.first << " = " << ciudad.second << "\n";
+    std::cout << "Personas con patrimonio superior a " << estado.umbral << "\n";
+    for (const auto& par : estado.patrimonioMayorUmbral) {
+        std::cout << "Ciudad:" << par.first;
+        if (estado.limiteListado != EstadoAgregado::SIN_LIMITE) {
+            std::cout << " (" << estado.cantidadMayorUmbral.buscar(par.first)->second << " personas";
+            if (!par.second.empty()) std::cout << "; las " << par.second.size() << " de mayor patrimonio";
+            std::cout << ")";
+        }
+        std::cout << "\n";
+        for (const FilaUmbral& fila : par.second) {
+            std::cout << estado.diccionarios->nombres.valor(fila.nombre) << " "
+                      << estado.diccionarios->apellidos.valor(fila.apellido)
+                      << " Patrimonio: " << fila.patrimonio << "\n";
+        }
+    }
+}
+
+bool reporteFueraDeMemoria(const std::string& archivo, size_t presupuesto, EstadoAgregado& estado,
+                           EstadisticasCsv& estadisticas, std::string& error) {
+    if (presupuesto < (1u << 20)) {
+        error = "El presupuesto de memoria debe ser de al menos 1 MB";
+        return false;
+    }
+    // Un cuarto del presupuesto (hasta 4 MB) para el búfer de lectura; el resto, filas
+    size_t bloque = std::min<size_t>(presupuesto / 4, 4 << 20);
+    size_t filasPorSegmento = (presupuesto - bloque) / BYTES_POR_FILA;
+
+    LectorCsvPersonas lector(bloque);
+    if (!lector.abrir(archivo)) {
+        error = lector.mensajeError();
+        estadisticas = lector.estadisticas();
+        return false;
+    }
+    ColumnasPersona segmento;
+    segmento.reservar(filasPorSegmento);
+    while (lector.leer(segmento, filasPorSegmento) > 0) {
+        estado.agregar(segmento);
+        segmento.vaciar();
+    }
+    estadisticas = lector.estadisticas();
+    error = lector.mensajeError();
+    return !lector.hayError();
+}
@@ -0,0 +1,114 @@
+#ifndef AGREGADOS_H
+#define AGREGADOS_H
+
+#include "persona.h"
+#include "columnas.h"
+#include "csv_personas.h"
+#include "mapa_plano.h"
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Mejor persona encontrada hasta ahora para un máximo.
+ *
+ * POR QUÉ: Las filas de un segmento se descartan al pasar al siguiente, así que
+ *          el ganador debe guardarse completo y no como índice.
+ * CÓMO: La persona materializada junto al valor con el que se compara; los mínimos
+ *       (como la fecha de la más longeva) se guardan con la clave negada.
+ * PARA QUÉ: Que todas las agregaciones de máximo se combinen con la misma regla.
+ */
+struct Extremo {
+    double clave = 0;      // Valor comparado
+    Persona persona;
+    bool vacio = true;
+};
+
+/**
+ * Persona del listado por umbral, guardada con códigos de diccionario.
+ *
+ * POR QUÉ: El listado crece con el resultado (la mitad de la población supera el
+ *          umbral en los datos generados); una Persona completa por fila lo volvería
+ *          el mayor consumo de memoria del reporte.
+ * CÓMO: Solo los campos que se imprimen, 16 bytes por fila.
+ * PARA QUÉ: Que el listado ocupe una fracción de lo que ocuparían las filas leídas.
+ */
+struct FilaUmbral {
+    uint32_t nombre;       // Código en diccionarios->nombres
+    uint32_t apellido;     // Código en diccionarios->apellidos
+    double patrimonio;
+};
+
+/**
+ * Estado parcial combinable del reporte completo.
+ *
+ * POR QUÉ: Un conjunto de cientos de millones de filas no cabe en memoria, pero
+ *          las consultas del reporte son máximos, sumas y listados, que se pueden
+ *          calcular por partes y combinar.
+ * CÓMO: agregar() resume un segmento de columnas con arreglos indexados por código
+ *       de ciudad y de grupo, y solo materializa a los ganadores; combinar() une
+ *       dos estados conservando el primero en caso de empate, igual que las
+ *       consultas en memoria.
+ * PARA QUÉ: Ejecutar longeva, mayor patrimonio por ciudad y grupo, totales por
+ *           ciudad y el listado por umbral sobre datos que se leen por segmentos.
+ */
+struct EstadoAgregado {
+    static constexpr size_t SIN_LIMITE = static_cast<size_t>(-1);
+
+    double umbral = 1'000'000'000.0;   // Patrimonio mínimo del listado
+    size_t limiteListado = SIN_LIMITE; // Filas del listado por ciudad (las de mayor patrimonio)
+    size_t filas = 0;
+    Extremo longevaPais;
+    Extremo mayorPatrimonioPais;
+    Extremo mayorDeudaPais;
+    MapaPlano<std::string, Extremo> longevaPorCiudad;
+    MapaPlano<std::string, Extremo> mayorPatrimonioPorCiudad;
+    MapaPlano<std::string, Extremo> mayorPatrimonioPorGrupo;
+    MapaPlano<std::string, long double> patrimonioPorCiudad;
+    MapaPlano<std::string, std::vector<FilaUmbral>> patrimonioMayorUmbral;
+    MapaPlano<std::string, size_t> cantidadMayorUmbral;   // Todas las personas sobre el umbral, por ciudad
+    std::shared_ptr<Diccionarios> diccionarios;   // Textos de los códigos del listado
+
+    /**
+     * Agrega las filas de un segmento (posteriores a las ya agregadas).
+     */
+    void agregar(const ColumnasPersona& segmento);
+
+    /**
+     * Agrega otro estado cuyas filas van después de las de este.
+     * Si usan diccionarios distintos, los códigos del listado se traducen. Con
+     * limiteListado, cada ciudad conserva solo sus limiteListado filas de mayor
+     * patrimonio (en empate, las que llegaron primero) ordenadas de mayor a menor.
+     */
+    void combinar(EstadoAgregado&& otro);
+
+    /**
+     * Ciudad con mayor patrimonio agregado y su total.
+     */
+    std::pair<std::string, long double> ciudadMayorPatrimonio() const;
+};
+
+/**
+ * Imprime el reporte completo con el formato de las opciones del menú.
+ */
+void mostrarReporte(const EstadoAgregado& estado);
+
+/**
+ * Ejecuta el reporte completo sobre un CSV sin cargarlo entero en memoria.
+ *
+ * POR QUÉ: El conjunto vigente (std::vector<Persona>) exige tener todas las filas
+ *          en RAM; 500 millones de filas no caben en una máquina de 32 GB.
+ * CÓMO: LectorCsvPersonas lee segmentos de tamaño fijo sobre las mismas columnas
+ *       (se vacían entre segmentos y conservan los diccionarios) y cada segmento
+ *       se agrega al estado. El tamaño del segmento sale del presupuesto de memoria.
+ * PARA QUÉ: Que la memoria de la consulta dependa del presupuesto y del tamaño del
+ *           resultado, no del tamaño del archivo.
+ * @param presupuesto Bytes para el búfer de lectura y el segmento de columnas
+ *                    (mínimo 1 MB); el estado y los diccionarios van aparte.
+ * @return false si el archivo no se pudo leer; el motivo queda en error.
+ */
+bool reporteFueraDeMemoria(const std::string& archivo, size_t presupuesto, EstadoAgregado& estado,
+                           EstadisticasCsv& estadisticas, std::string& error);
+
+#endif // AGREGADOS_H
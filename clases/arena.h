@@ -0,0 +1,42 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+
+/**
+ * Arena que guarda los textos de todas las personas de un conjunto de datos.
+ *
+ * POR QUÉ: Cada Persona reservaba sus textos largos (apellidos compuestos) con malloc.
+ * CÓMO: Un monotonic_buffer_resource que entrega memoria por bloques crecientes
+ *       y nunca libera individualmente.
+ * PARA QUÉ: Generar millones de personas sin una llamada a malloc por texto y
+ *           liberar todo el conjunto de una vez al destruir la arena.
+ */
+using ArenaDatos = std::pmr::monotonic_buffer_resource;
+
+/**
+ * Arena temporal para los mapas y vectores que construye una consulta.
+ *
+ * POR QUÉ: Los resultados agrupados reservan un nodo por llave y crecen sus vectores.
+ * CÓMO: Un búfer inicial propio seguido de bloques del heap; reiniciar() descarta
+ *       todo lo reservado de una vez.
+ * PARA QUÉ: Reutilizar la misma memoria consulta tras consulta.
+ */
+class ArenaConsulta {
+public:
+    ArenaConsulta() : recurso_(bufferInicial, sizeof(bufferInicial)) {}
+    ArenaConsulta(const ArenaConsulta&) = delete;
+    ArenaConsulta& operator=(const ArenaConsulta&) = delete;
+
+    std::pmr::memory_resource* recurso() { return &recurso_; }
+
+    // Solo debe llamarse cuando ya no existe ningún objeto reservado en la arena
+    void reiniciar() { recurso_.release(); }
+
+private:
+    alignas(std::max_align_t) std::byte bufferInicial[64 * 1024]; // Primeros 64 KB sin heap
+    std::pmr::monotonic_buffer_resource recurso_;
+};
+
+#endif // ARENA_H
@@ -0,0 +1,156 @@
+#include "benchmark_layouts.h"
+#include "layouts.h"
+#include "consultas.h"
+#include "kernels.h"
+#include <iostream>
+#include <string>
+
+namespace {
+
+/**
+ * Mide una consulta y registra su resultado.
+ *
+ * POR QUÉ: Todas las mediciones siguen el mismo patrón que el menú principal.
+ * CÓMO: Cronómetro y memoria de Monitor alrededor de la consulta; el resumen
+ *       del resultado se imprime para verificar que todos los layouts coinciden.
+ * PARA QUÉ: Evitar repetir el bloque de medición en cada consulta.
+ */
+template <class Consulta, class Describir>
+void medir(Monitor& monitor, const std::string& operacion, const char* layout,
+           Consulta consulta, Describir describir) {
+    long memoria_inicio = monitor.obtener_memoria();
+    monitor.iniciar_tiempo();
+    auto resultado = consulta();
+    double tiempo = monitor.detener_tiempo();
+    long memoria = monitor.obtener_memoria() - memoria_inicio;
+
+    std::string nombre = operacion + " [" + layout + "]";
+    monitor.registrar(nombre, tiempo, memoria);
+    std::cout << nombre << ": " << tiempo << " ms, " << memoria << " KB -> " << describir(resultado) << "\n";
+}
+
+/**
+ * Consultas propias de un layout, además de las genéricas.
+ *
+ * POR QUÉ: Algunos layouts tienen operaciones que las políticas no pueden expresar,
+ *          como los filtros sobre datos comprimidos.
+ * CÓMO: Por defecto no hace nada; cada layout con operaciones propias la especializa.
+ * PARA QUÉ: Medirlas junto a las consultas genéricas del mismo almacén.
+ */
+template <class L>
+void medirPropias(const typename L::Almacen&, Monitor&) {}
+
+template <>
+void medirPropias<LayoutColumnas>(const ColumnasPersona& almacen, Monitor& monitor) {
+    auto fila = [&](size_t i) { return LayoutColumnas::descripcion(almacen, i); };
+    std::vector<NivelSimd> niveles{NivelSimd::Escalar};
+    if (nivelSimdDisponible() != NivelSimd::Escalar) niveles.push_back(NivelSimd::Avx2);
+    if (nivelSimdDisponible() == NivelSimd::Avx512) niveles.push_back(NivelSimd::Avx512);
+    for (NivelSimd nivel : niveles) {
+        std::string nombre = std::string("Columnas, núcleo ") + nombreNivel(nivel);
+        size_t n = almacen.tamano();
+        medir(monitor, "Longeva país", nombre.c_str(),
+              [&] { return argminFecha(almacen.fecha.data(), n, nivel); }, fila);
+        medir(monitor, "Mayor patrimonio país", nombre.c_str(),
+              [&] { return argmaxNeto(almacen.patrimonio.data(), almacen.deudas.data(), n, nivel); }, fila);
+        medir(monitor, "Mayor deuda país", nombre.c_str(),
+              [&] { return argmaxValor(almacen.deudas.data(), n, nivel); }, fila);
+        medir(monitor, "Patrimonio mayor a 1.000 millones", nombre.c_str(),
+              [&] {
+                  std::vector<uint32_t> filas;
+                  filtrarMayor(almacen.patrimonio.data(), n, 1'000'000'000.0, filas, nivel);
+                  return filas;
+              },
+              [](const std::vector<uint32_t>& filas) { return std::to_string(filas.size()) + " personas"; });
+    }
+}
+
+template <>
+void medirPropias<LayoutComprimido>(const ColumnasComprimidas& almacen, Monitor& monitor) {
+    const char* nombre = "Comprimido, sin decodificar";
+    std::cout << "Columnas comprimidas: " << almacen.bytes() << " bytes ("
+              << (almacen.tamano() ? almacen.bytes() / almacen.tamano() : 0) << " por fila; montos "
+              << (almacen.patrimonio.enCentavos() ? "en centavos" : "sin comprimir") << ")\n";
+    medir(monitor, "Longeva país", nombre,
+          [&] { return almacen.longeva(); },
+          [&](size_t i) { return LayoutComprimido::descripcion(almacen, i); });
+    medir(monitor, "Patrimonio mayor a 1.000 millones", nombre,
+          [&] {
+              std::vector<uint32_t> filas;
+              almacen.patrimonio.filtrarMayor(1'000'000'000.0, filas);
+              return filas;
+          },
+          [](const std::vector<uint32_t>& filas) { return std::to_string(filas.size()) + " personas"; });
+    medir(monitor, "Personas de una ciudad", nombre,
+          [&] {
+              std::vector<uint32_t> filas;
+              almacen.filtrarCiudad(0, filas);
+              return filas;
+          },
+          [&](const std::vector<uint32_t>& filas) {
+              return std::to_string(filas.size()) + " en " + LayoutComprimido::textoCiudad(almacen, 0);
+          });
+}
+
+/**
+ * Construye el layout L y ejecuta sobre él cada consulta.
+ */
+template <class L>
+void medirLayout(const std::vector<Persona>& personas, Monitor& monitor) {
+    long memoria_inicio = monitor.obtener_memoria();
+    monitor.iniciar_tiempo();
+    const typename L::Almacen almacen = L::construir(personas);
+    double tiempo = monitor.detener_tiempo();
+    long memoria = monitor.obtener_memoria() - memoria_inicio;
+    monitor.registrar(std::string("Construir layout [") + L::nombre + "]", tiempo, memoria);
+    std::cout << "\n--- " << L::nombre << ": construido en " << tiempo << " ms, " << memoria << " KB ---\n";
+
+    auto fila = [&](size_t i) { return L::descripcion(almacen, i); };
+    auto grupos = [&](const auto& mapa) { return std::to_string(mapa.size()) + " llaves"; };
+
+    medir(monitor, "Longeva país", L::nombre,
+          [&] { return longevaPais<L>(almacen); }, fila);
+    medir(monitor, "Longeva por ciudad", L::nombre,
+          [&] { return longevaPorCiudad<L>(almacen); }, grupos);
+    medir(monitor, "Mayor patrimonio país", L::nombre,
+          [&] { return mayorPatrimonioPais<L>(almacen); }, fila);
+    medir(monitor, "Mayor patrimonio por ciudad", L::nombre,
+          [&] { return mayorPatrimonioPorCiudad<L>(almacen); }, grupos);
+    medir(monitor, "Mayor patrimonio por grupo", L::nombre,
+          [&] { return mayorPatrimonioPorGrupo<L>(almacen); }, grupos);
+    medir(monitor, "Listar por grupo", L::nombre,
+          [&] { return listarPorGrupo<L>(almacen); }, grupos);
+    medir(monitor, "Mayor deuda país", L::nombre,
+          [&] { return mayorDeudaPais<L>(almacen); }, fila);
+    medir(monitor, "Ciudad mayor patrimonio", L::nombre,
+          [&] { return ciudadMayorPatrimonio<L>(almacen); },
+          [&](const auto& par) { return L::textoCiudad(almacen, par.first); });
+    medir(monitor, "Patrimonio mayor a 1.000 millones", L::nombre,
+          [&] { return listarPatrimonioMayor<L>(almacen, 1'000'000'000.0); },
+          [](const auto& mapa) {
+              size_t total = 0;
+              for (const auto& par : mapa) total += par.second.size();
+              return std::to_string(total) + " personas";
+          });
+    medirPropias<L>(almacen, monitor);
+}
+
+/**
+ * Lista de layouts que participan en la comparación.
+ */
+template <class... Layouts>
+struct ListaLayouts {
+    static void medirTodos(const std::vector<Persona>& personas, Monitor& monitor) {
+        (medirLayout<Layouts>(personas, monitor), ...);
+    }
+};
+
+using TodosLosLayouts = ListaLayouts<LayoutEstructura, LayoutClase, LayoutColumnas, LayoutCompacto,
+                                     LayoutComprimido>;
+
+} // namespace
+
+void compararLayouts(const std::vector<Persona>& personas, Monitor& monitor) {
+    std::cout << "\n=== COMPARACIÓN DE LAYOUTS (" << personas.size() << " personas) ===\n";
+    TodosLosLayouts::medirTodos(personas, monitor);
+}
@@ -0,0 +1,20 @@
+#ifndef BENCHMARK_LAYOUTS_H
+#define BENCHMARK_LAYOUTS_H
+
+#include "persona.h"
+#include "monitor.h"
+#include <vector>
+
+/**
+ * Ejecuta todas las consultas de consultas.h sobre cada layout de layouts.h.
+ *
+ * POR QUÉ: Comparar struct, clase, columnas y filas compactas en el mismo binario
+ *          y con los mismos datos, en lugar de mantener un programa por layout.
+ * CÓMO: Convierte el vector a cada layout y mide construcción y consultas con Monitor.
+ * PARA QUÉ: Generar automáticamente la tabla de análisis del README.
+ * @param personas Conjunto de datos generado en la opción 0.
+ * @param monitor Monitor donde se registran los tiempos y la memoria.
+ */
+void compararLayouts(const std::vector<Persona>& personas, Monitor& monitor);
+
+#endif // BENCHMARK_LAYOUTS_H
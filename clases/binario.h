@@ -0,0 +1,84 @@
+#ifndef BINARIO_H
+#define BINARIO_H
+
+#include "persona.h"
+#include "columnas.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+// Codificación binaria compacta para mensajes entre procesos del mismo anfitrión
+// (servidor de consultas, ejecutor con fork): enteros y doubles en el orden de
+// bytes nativo, textos como u16 longitud y bytes, y personas campo por campo.
+
+// Agrega valores al final de un búfer
+class EscritorBinario {
+public:
+    template <class T>
+    void valor(T v) { bytes.append(reinterpret_cast<const char*>(&v), sizeof(v)); }
+
+    void texto(std::string_view t) {
+        uint16_t n = static_cast<uint16_t>(std::min<size_t>(t.size(), UINT16_MAX));
+        valor(n);
+        bytes.append(t.data(), n);
+    }
+
+    void persona(const Persona& p) {
+        texto(p.getId());
+        texto(p.getNombre());
+        texto(p.getApellido());
+        texto(p.getCiudadNacimiento());
+        texto(p.getGrupoDeclaracion());
+        valor<int32_t>(empaquetarFecha(p.getFechaNacimiento()));
+        valor(p.getIngresosAnuales());
+        valor(p.getPatrimonio());
+        valor(p.getDeudas());
+    }
+
+    std::string bytes;
+};
+
+// Lee valores de un búfer; cada lectura falla si no quedan bytes suficientes
+class LectorBinario {
+public:
+    LectorBinario(const char* datos, size_t n) : p(datos), fin(datos + n) {}
+
+    template <class T>
+    bool valor(T& v) {
+        if (static_cast<size_t>(fin - p) < sizeof(T)) return false;
+        std::memcpy(&v, p, sizeof(T));
+        p += sizeof(T);
+        return true;
+    }
+
+    bool texto(std::string& t) {
+        uint16_t n;
+        if (!valor(n) || static_cast<size_t>(fin - p) < n) return false;
+        t.assign(p, n);
+        p += n;
+        return true;
+    }
+
+    bool persona(Persona& destino) {
+        std::string id, nombre, apellido, ciudad, grupo;
+        int32_t fecha;
+        double ingresos, patrimonio, deudas;
+        if (!texto(id) || !texto(nombre) || !texto(apellido) || !texto(ciudad) || !texto(grupo) ||
+            !valor(fecha) || !valor(ingresos) || !valor(patrimonio) || !valor(deudas)) {
+            return false;
+        }
+        destino = Persona(nombre, apellido, id, ciudad, desempaquetarFecha(fecha), ingresos, patrimonio,
+                          deudas, grupo);
+        return true;
+    }
+
+    size_t restantes() const { return static_cast<size_t>(fin - p); }
+
+private:
+    const char* p;
+    const char* fin;
+};
+
+#endif // BINARIO_H
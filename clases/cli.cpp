@@ -0,0 +1,381 @@
+#include "cli.h"
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+// Convierte un texto a entero no negativo; false si no es un número completo
+bool leerEntero(const std::string& texto, long long& valor) {
+    try {
+        size_t usados = 0;
+        valor = std::stoll(texto, &usados);
+        return usados == texto.size() && valor >= 0;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+} // namespace
+
+bool analizarArgumentos(int argc, char* argv[], OpcionesCli& opciones, std::string& error) {
+    bool sesgoIndicado = false;   // Se dio --zipf o --duplicates
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        // Devuelve el siguiente argumento como valor de la bandera actual
+        auto valor = [&](std::string& destino) {
+            if (i + 1 >= argc) {
+                error = "Falta el valor de " + arg;
+                return false;
+            }
+            destino = argv[++i];
+            return true;
+        };
+        std::string texto;
+        long long numero = 0;
+
+        if (arg == "--help" || arg == "-h") {
+            opciones.ayuda = true;
+        } else if (arg == "--generate") {
+            if (!valor(texto)) return false;
+            if (!leerEntero(texto, numero) || numero <= 0 || numero > 2147483647LL) {
+                error = "Número de personas inválido: " + texto;
+                return false;
+            }
+            opciones.generar = static_cast<int>(numero);
+        } else if (arg == "--seed") {
+            if (!valor(texto)) return false;
+            if (!leerEntero(texto, numero) || numero > 4294967295LL) {
+                error = "Semilla inválida: " + texto;
+                return false;
+            }
+            opciones.conSemilla = true;
+            opciones.semilla = static_cast<unsigned>(numero);
+        } else if (arg == "--profile") {
+            if (!valor(opciones.perfil)) return false;
+            if (opciones.perfil != "uniform" && opciones.perfil != "skewed") {
+                error = "Perfil inválido (use uniform o skewed): " + opciones.perfil;
+                return false;
+            }
+        } else if (arg == "--zipf" || arg == "--duplicates") {
+            if (!valor(texto)) return false;
+            double real = -1;
+            try {
+                real = std::stod(texto);
+            } catch (const std::exception&) {
+            }
+            bool esZipf = arg == "--zipf";
+            if (real < 0 || (!esZipf && real > 1) || (esZipf && real > 10)) {
+                error = "Valor inválido para " + arg + ": " + texto;
+                return false;
+            }
+            (esZipf ? opciones.zipf : opciones.duplicados) = real;
+            sesgoIndicado = true;
+        } else if (arg == "--import") {
+            if (!valor(opciones.importar)) return false;
+        } else if (arg == "--export-data") {
+            if (!valor(opciones.exportarDatos)) return false;
+        } else if (arg == "--threads") {
+            if (!valor(texto)) return false;
+            if (!leerEntero(texto, numero) || numero <= 0 || numero > 1024) {
+                error = "Número de hilos inválido: " + texto;
+                return false;
+            }
+            opciones.hilos = static_cast<unsigned>(numero);
+        } else if (arg == "--out-of-core") {
+            if (!valor(opciones.fueraDeMemoria)) return false;
+        } else if (arg == "--memory-budget") {
+            if (!valor(texto)) return false;
+            if (!leerEntero(texto, numero) || numero <= 0 || numero > (1LL << 30)) {
+                error = "Presupuesto de memoria inválido: " + texto;
+                return false;
+            }
+            opciones.presupuestoMB = static_cast<size_t>(numero);
+        } else if (arg == "--updates") {
+            if (!valor(texto)) return false;
+            if (!leerEntero(texto, numero) || numero <= 0) {
+                error = "Número de cambios inválido: " + texto;
+                return false;
+            }
+            opciones.cambios = static_cast<size_t>(numero);
+        } else if (arg == "--background") {
+            opciones.segundoPlano = true;
+        } else if (arg == "--reload") {
+            if (!valor(texto)) return false;
+            if (!leerEntero(texto, numero) || numero <= 0 || numero > 2147483647LL) {
+                error = "Número de personas inválido: " + texto;
+                return false;
+            }
+            opciones.recargar = static_cast<int>(numero);
+        } else if (arg == "--serve") {
+            if (!valor(opciones.servir)) return false;
+        } else if (arg == "--workers") {
+            if (!valor(texto)) return false;
+            if (!leerEntero(texto, numero) || numero <= 0 || numero > 1024) {
+                error = "Número de trabajadores inválido: " + texto;
+                return false;
+            }
+            opciones.trabajadores = static_cast<unsigned>(numero);
+        } else if (arg == "--ask") {
+            if (!valor(opciones.preguntar) || !valor(texto)) return false;
+            size_t separador = texto.find(':');
+            if (!leerEntero(texto.substr(0, separador), numero) || numero > 255) {
+                error = "Consulta inválida en --ask: " + texto;
+                return false;
+            }
+            opciones.consultaRemota = static_cast<int>(numero);
+            if (separador != std::string::npos) {
+                try {
+                    opciones.umbralRemoto = std::stod(texto.substr(separador + 1));
+                } catch (const std::exception&) {
+                    error = "Umbral inválido en --ask: " + texto;
+                    return false;
+                }
+            }
+        } else if (arg == "--publish-shm") {
+            if (!valor(opciones.publicarCompartida)) return false;
+        } else if (arg == "--attach-shm") {
+            if (!valor(opciones.adjuntarCompartida)) return false;
+        } else if (arg == "--unlink-shm") {
+            if (!valor(opciones.retirarCompartida)) return false;
+        } else if (arg == "--processes") {
+            if (!valor(texto)) return false;
+            if (!leerEntero(texto, numero) || numero <= 0 || numero > 1024) {
+                error = "Número de procesos inválido: " + texto;
+                return false;
+            }
+            opciones.procesos = static_cast<unsigned>(numero);
+        } else if (arg == "--tasks") {
+            if (!valor(texto)) return false;
+            if (!leerEntero(texto, numero) || numero <= 0 || numero > 1024) {
+                error = "Número de hilos inválido: " + texto;
+                return false;
+            }
+            opciones.tareas = static_cast<unsigned>(numero);
+        } else if (arg == "--grain") {
+            if (!valor(texto)) return false;
+            if (!leerEntero(texto, numero) || numero <= 0) {
+                error = "Tamaño de tarea inválido: " + texto;
+                return false;
+            }
+            opciones.grano = static_cast<size_t>(numero);
+        } else if (arg == "--virtual") {
+            if (!valor(texto)) return false;
+            if (!leerEntero(texto, numero) || numero <= 0) {
+                error = "Número de filas virtuales inválido: " + texto;
+                return false;
+            }
+            opciones.filasVirtuales = static_cast<unsigned long long>(numero);
+        } else if (arg == "--virtual-threshold") {
+            if (!valor(texto)) return false;
+            try {
+                opciones.umbralVirtual = std::stod(texto);
+            } catch (const std::exception&) {
+                error = "Umbral inválido: " + texto;
+                return false;
+            }
+        } else if (arg == "--virtual-top") {
+            if (!valor(texto)) return false;
+            if (!leerEntero(texto, numero) || numero < 0) {
+                error = "Tamaño de listado inválido: " + texto;
+                return false;
+            }
+            opciones.listadoVirtual = static_cast<size_t>(numero);
+        } else if (arg == "--numa") {
+            opciones.numa = true;
+        } else if (arg == "--numa-threads") {
+            if (!valor(texto)) return false;
+            if (!leerEntero(texto, numero) || numero <= 0 || numero > 1024) {
+                error = "Número de hilos por nodo inválido: " + texto;
+                return false;
+            }
+            opciones.numa = true;
+            opciones.hilosNuma = static_cast<unsigned>(numero);
+        } else if (arg == "--approx") {
+            if (!valor(opciones.aproximado)) return false;
+            if (opciones.aproximado != "uniform" && opciones.aproximado != "stratified") {
+                error = "Tipo de muestra inválido (use uniform o stratified): " + opciones.aproximado;
+                return false;
+            }
+        } else if (arg == "--sample-size") {
+            if (!valor(texto)) return false;
+            if (!leerEntero(texto, numero) || numero <= 0) {
+                error = "Tamaño de muestra inválido: " + texto;
+                return false;
+            }
+            opciones.tamanoMuestra = static_cast<size_t>(numero);
+        } else if (arg == "--approx-threshold") {
+            if (!valor(texto)) return false;
+            try {
+                opciones.umbralAproximado = std::stod(texto);
+            } catch (const std::exception&) {
+                error = "Umbral inválido: " + texto;
+                return false;
+            }
+        } else if (arg == "--quantiles") {
+            opciones.cuantiles = true;
+        } else if (arg == "--quantile-k") {
+            if (!valor(texto)) return false;
+            if (!leerEntero(texto, numero) || numero < 8 || numero > 65536) {
+                error = "Tamaño de sketch inválido (8 a 65536): " + texto;
+                return false;
+            }
+            opciones.kCuantiles = static_cast<unsigned>(numero);
+        } else if (arg == "--distinct") {
+            opciones.distintos = true;
+        } else if (arg == "--distinct-bits") {
+            if (!valor(texto)) return false;
+            if (!leerEntero(texto, numero) || numero < 4 || numero > 16) {
+                error = "Precisión inválida (4 a 16): " + texto;
+                return false;
+            }
+            opciones.distintos = true;
+            opciones.precisionDistintos = static_cast<unsigned>(numero);
+        } else if (arg == "--huge-pages") {
+            if (!valor(opciones.paginasGrandes)) return false;
+            if (opciones.paginasGrandes != "thp" && opciones.paginasGrandes != "explicit") {
+                error = "Modo de páginas inválido (use thp o explicit): " + opciones.paginasGrandes;
+                return false;
+            }
+        } else if (arg == "--prefault") {
+            opciones.prellenar = true;
+        } else if (arg == "--mlock") {
+            opciones.bloquearMemoria = true;
+        } else if (arg == "--run") {
+            if (!valor(texto)) return false;
+            std::stringstream lista(texto);
+            std::string elemento;
+            while (std::getline(lista, elemento, ',')) {
+                if (!leerEntero(elemento, numero)) {
+                    error = "Opción inválida en --run: " + elemento;
+                    return false;
+                }
+                opciones.consultas.push_back(static_cast<int>(numero));
+            }
+        } else if (arg == "--repeat") {
+            if (!valor(texto)) return false;
+            if (!leerEntero(texto, numero) || numero <= 0) {
+                error = "Número de repeticiones inválido: " + texto;
+                return false;
+            }
+            opciones.repeticiones = static_cast<int>(numero);
+        } else if (arg == "--cache") {
+            opciones.cache = true;
+        } else if (arg == "--csv") {
+            if (!valor(opciones.archivoCsv)) return false;
+        } else if (arg == "--output") {
+            if (!valor(opciones.archivoSalida)) return false;
+        } else if (arg == "--quiet") {
+            opciones.silencioso = true;
+        } else if (arg == "--compare") {
+            if (!valor(opciones.compararBase) || !valor(opciones.compararNuevo)) return false;
+        } else if (arg == "--threshold") {
+            if (!valor(texto)) return false;
+            try {
+                opciones.umbral = std::stod(texto);
+            } catch (const std::exception&) {
+                error = "Umbral inválido: " + texto;
+                return false;
+            }
+        } else {
+            error = "Argumento desconocido: " + arg;
+            return false;
+        }
+    }
+
+    if (sesgoIndicado && opciones.perfil != "skewed") {
+        error = "--zipf y --duplicates solo aplican con --profile skewed";
+        return false;
+    }
+    bool hayDatos = opciones.generar > 0 || !opciones.importar.empty();
+    bool adjunto = !opciones.adjuntarCompartida.empty();
+    if ((opciones.generar > 0) + !opciones.importar.empty() + adjunto > 1) {
+        error = "--generate, --import y --attach-shm no se pueden combinar";
+        return false;
+    }
+    if ((adjunto && opciones.procesos > 0) || (adjunto && opciones.tareas > 0) ||
+        (opciones.procesos > 0 && opciones.tareas > 0)) {
+        error = "--processes, --tasks y --attach-shm no se pueden combinar";
+        return false;
+    }
+    if (opciones.segundoPlano &&
+        (opciones.generar <= 0 || opciones.cambios > 0 || !opciones.exportarDatos.empty() ||
+         !opciones.publicarCompartida.empty() || opciones.recargar > 0 || opciones.tareas > 0)) {
+        error = "--background necesita --generate N y no se combina con --updates, --export-data, --publish-shm, --reload ni --tasks";
+        return false;
+    }
+    if (!opciones.consultas.empty() && !hayDatos && !adjunto) {
+        error = "--run necesita un conjunto de datos (use --generate N, --import archivo o --attach-shm nombre)";
+        return false;
+    }
+    if ((!opciones.exportarDatos.empty() || opciones.cambios > 0 || !opciones.servir.empty() ||
+         !opciones.publicarCompartida.empty() || opciones.numa || !opciones.aproximado.empty() ||
+         opciones.cuantiles || opciones.distintos) && !hayDatos) {
+        error = "--export-data, --updates, --serve, --publish-shm, --numa, --approx, --quantiles y --distinct necesitan un conjunto de datos (use --generate N o --import archivo)";
+        return false;
+    }
+    return true;
+}
+
+void mostrarAyuda(const char* programa) {
+    std::cout << "Uso: " << programa << " [opciones]\n"
+              << "Sin opciones se abre el menú interactivo.\n\n"
+              << "  --generate N          Generar N personas\n"
+              << "  --seed S              Semilla para una generación reproducible\n"
+              << "  --profile P           Distribuciones de la generación: uniform (por defecto) o\n"
+              << "                        skewed (ciudades Zipf, ingresos log-normales, patrimonio\n"
+              << "                        Pareto, deudas correlacionadas, nombres repetidos)\n"
+              << "  --zipf S              Exponente de Zipf de las ciudades con skewed (por defecto 1.1)\n"
+              << "  --duplicates P        Fracción de nombres completos repetidos con skewed (0.05)\n"
+              << "  --import archivo      Cargar las personas desde un CSV\n"
+              << "  --export-data archivo Guardar las personas en un CSV\n"
+              << "  --threads N           Hilos para --import (por defecto todos los núcleos)\n"
+              << "  --out-of-core archivo Reporte completo leyendo el CSV por segmentos\n"
+              << "  --memory-budget MB    Memoria por segmento de --out-of-core (por defecto 256)\n"
+              << "  --updates N           Aplicar N altas, cambios y bajas aleatorios (opción 27)\n"
+              << "  --reload N            Generar N personas en segundo plano mientras corre --run\n"
+              << "  --background          Generar --generate en segundo plano; --run consulta los\n"
+              << "                        segmentos ya generados y muestra el progreso\n"
+              << "  --serve ruta          Atender consultas por un socket Unix hasta Ctrl+C\n"
+              << "  --workers N           Hilos de consulta de --serve (por defecto todos los núcleos)\n"
+              << "  --ask ruta C[:U]      Pedir la consulta C (0, 2, 4, 6, 8, 10, 14, 16, 18) a un\n"
+              << "                        servidor; U es el umbral de la 18\n"
+              << "  --publish-shm nombre  Copiar el conjunto a un segmento de memoria compartida\n"
+              << "  --attach-shm nombre   Ejecutar --run sobre un segmento publicado (2, 4, 6, 8,\n"
+              << "                        10, 14, 16, 18)\n"
+              << "  --unlink-shm nombre   Eliminar un segmento publicado\n"
+              << "  --processes N         Ejecutar --run repartiendo las filas en N procesos hijos\n"
+              << "                        (2, 4, 6, 8, 10, 14, 16, 18)\n"
+              << "  --tasks N             Generar y ejecutar --run con N hilos y robo de trabajo\n"
+              << "                        (2, 4, 6, 8, 10, 14, 16, 18)\n"
+              << "  --grain G             Filas por tarea de --tasks (por defecto 65536)\n"
+              << "  --virtual N           Reporte completo sobre N filas calculadas a pedido con\n"
+              << "                        --seed, sin guardarlas (usa --tasks y --grain)\n"
+              << "  --virtual-threshold U Patrimonio mínimo del listado de --virtual (1.000 millones)\n"
+              << "  --virtual-top K       Personas de mayor patrimonio listadas por ciudad en\n"
+              << "                        --virtual (10); de las demás solo se cuentan\n"
+              << "  --numa                Reporte completo con las filas repartidas por nodo NUMA\n"
+              << "  --numa-threads N      Hilos por nodo de --numa (por defecto uno por procesador)\n"
+              << "  --approx T            Reporte aproximado con intervalos del 95% sobre la muestra\n"
+              << "                        tomada al cargar: uniform o stratified (por ciudad)\n"
+              << "  --sample-size K       Filas de cada reservorio de la muestra (por defecto 10000)\n"
+              << "  --approx-threshold U  Umbral del conteo de --approx (1.000 millones)\n"
+              << "  --quantiles           Mediana, p90 y p99 de patrimonio neto, ingresos y deudas por\n"
+              << "                        ciudad y grupo con sketches KLL (usa --tasks y --grain)\n"
+              << "  --quantile-k K        Tamaño de los sketches de --quantiles (por defecto 200)\n"
+              << "  --distinct            Nombres completos y pares de apellidos distintos por ciudad\n"
+              << "                        con HyperLogLog (usa --tasks y --grain)\n"
+              << "  --distinct-bits P     2^P registros por estimador de --distinct (4 a 16, por\n"
+              << "                        defecto 12: 4 KB y 1.6% de error típico)\n"
+              << "  --huge-pages M        Respaldar el conjunto con páginas de 2 MB: thp (madvise)\n"
+              << "                        o explicit (MAP_HUGETLB, necesita vm.nr_hugepages)\n"
+              << "  --prefault            Crear las tablas de páginas al cargar, no en la 1.a consulta\n"
+              << "  --mlock               Fijar el conjunto en RAM (limitado por ulimit -l)\n"
+              << "  --run 2,4,6           Opciones del menú a ejecutar (1-19, 23)\n"
+              << "  --repeat R            Repetir cada opción R veces (por defecto 1)\n"
+              << "  --cache               Servir las repeticiones desde la caché de resultados\n"
+              << "  --csv archivo         Exportar las estadísticas a CSV\n"
+              << "  --output archivo      Escribir la salida de las consultas en un archivo\n"
+              << "  --quiet               No imprimir la salida de las consultas\n"
+              << "  --compare base nuevo  Comparar dos CSV de estadísticas\n"
+              << "  --threshold P         Porcentaje de regresión tolerado (por defecto 5)\n";
+}
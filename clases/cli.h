@@ -0,0 +1,82 @@
+#ifndef CLI_H
+#define CLI_H
+
+#include <string>
+#include <vector>
+
+/**
+ * Opciones de la línea de comandos para ejecuciones sin menú.
+ *
+ * POR QUÉ: El menú interactivo no sirve en cron ni en pipelines de carga.
+ * CÓMO: Cada bandera de la línea de comandos llena un campo de esta estructura.
+ * PARA QUÉ: Ejecutar generación, consultas y exportación de forma reproducible.
+ */
+struct OpcionesCli {
+    bool ayuda = false;             // --help
+    int generar = 0;                // --generate N: personas a generar
+    bool conSemilla = false;        // Se indicó --seed
+    unsigned semilla = 0;           // --seed S: semilla de la generación
+    std::string perfil = "uniform"; // --profile uniform|skewed: distribuciones de la generación
+    double zipf = 1.1;              // --zipf S: exponente de Zipf de las ciudades (perfil skewed)
+    double duplicados = 0.05;       // --duplicates P: fracción de nombres completos repetidos (perfil skewed)
+    std::string importar;           // --import archivo: cargar personas desde CSV
+    std::string exportarDatos;      // --export-data archivo: guardar las personas en CSV
+    unsigned hilos = 0;             // --threads N: hilos de la carga (0 = todos los núcleos)
+    std::string fueraDeMemoria;     // --out-of-core archivo: reporte completo leyendo por segmentos
+    size_t presupuestoMB = 256;     // --memory-budget MB: memoria por segmento del reporte
+    size_t cambios = 0;             // --updates N: cambios aleatorios con agregados incrementales
+    int recargar = 0;               // --reload N: generar N personas en segundo plano durante --run
+    bool segundoPlano = false;      // --background: --generate en segundo plano, --run sobre lo ya generado
+    std::string servir;             // --serve ruta: atender consultas por un socket Unix
+    unsigned trabajadores = 0;      // --workers N: hilos de consulta del servidor (0 = todos los núcleos)
+    std::string preguntar;          // --ask ruta consulta[:umbral]: cliente del servidor
+    int consultaRemota = 0;
+    double umbralRemoto = 1'000'000'000.0;
+    std::string publicarCompartida; // --publish-shm nombre: copiar el conjunto a memoria compartida
+    std::string adjuntarCompartida; // --attach-shm nombre: consultar un conjunto publicado por otro proceso
+    std::string retirarCompartida;  // --unlink-shm nombre: eliminar el segmento
+    unsigned procesos = 0;          // --processes N: ejecutar --run en N procesos hijos (fork)
+    unsigned tareas = 0;            // --tasks N: generar y ejecutar --run con N hilos y robo de trabajo
+    size_t grano = 65536;           // --grain G: filas por tarea de --tasks
+    unsigned long long filasVirtuales = 0; // --virtual N: reporte completo sobre N filas calculadas a pedido
+    double umbralVirtual = 1'000'000'000.0; // --virtual-threshold U: patrimonio mínimo del listado de --virtual
+    size_t listadoVirtual = 10;             // --virtual-top K: filas del listado de --virtual por ciudad
+    bool numa = false;              // --numa: reporte completo con las filas repartidas por nodo NUMA
+    unsigned hilosNuma = 0;         // --numa-threads N: hilos por nodo (0 = uno por procesador)
+    std::string aproximado;         // --approx uniform|stratified: reporte aproximado con la muestra
+    size_t tamanoMuestra = 10000;   // --sample-size K: filas de cada reservorio de la muestra
+    double umbralAproximado = 1'000'000'000.0; // --approx-threshold U: umbral del conteo de --approx
+    bool cuantiles = false;         // --quantiles: p50, p90 y p99 por ciudad y grupo con sketches KLL
+    unsigned kCuantiles = 200;      // --quantile-k K: tamaño de los sketches (error de rango ~1.7/K)
+    bool distintos = false;         // --distinct: nombres completos y apellidos distintos por ciudad (HyperLogLog)
+    unsigned precisionDistintos = 12; // --distinct-bits P: 2^P registros por estimador
+    std::string paginasGrandes;     // --huge-pages thp|explicit: respaldo del conjunto con páginas de 2 MB
+    bool prellenar = false;         // --prefault: crear las tablas de páginas al cargar
+    bool bloquearMemoria = false;   // --mlock: fijar el conjunto en RAM
+    std::vector<int> consultas;     // --run 2,4,6: opciones del menú a ejecutar
+    int repeticiones = 1;           // --repeat R: veces que se ejecuta cada consulta
+    bool cache = false;             // --cache: repetir consultas desde la caché de resultados
+    std::string archivoCsv;         // --csv archivo: exportar estadísticas
+    bool silencioso = false;        // --quiet: suprimir la salida de las consultas
+    std::string archivoSalida;      // --output archivo: redirigir la salida de las consultas
+    std::string compararBase;       // --compare base.csv nuevo.csv
+    std::string compararNuevo;
+    double umbral = 5.0;            // --threshold P: porcentaje de regresión tolerado
+};
+
+/**
+ * Interpreta los argumentos de main.
+ *
+ * POR QUÉ: Validar la entrada antes de empezar a medir.
+ * CÓMO: Recorre argv y convierte cada valor; se detiene en el primer error.
+ * PARA QUÉ: Fallar con un mensaje claro en vez de ejecutar algo distinto a lo pedido.
+ * @return false si algún argumento es inválido; el motivo queda en error.
+ */
+bool analizarArgumentos(int argc, char* argv[], OpcionesCli& opciones, std::string& error);
+
+/**
+ * Muestra el uso de la línea de comandos.
+ */
+void mostrarAyuda(const char* programa);
+
+#endif // CLI_H
@@ -0,0 +1,78 @@
+#include "columnas.h"
+#include <stdexcept>
+
+/**
+ * Implementación de Diccionario::codificar.
+ *
+ * POR QUÉ: Cada texto nuevo necesita un código estable.
+ * CÓMO: Si ya existe devuelve su código; si no, lo agrega al final.
+ * PARA QUÉ: Construir las columnas de códigos.
+ */
+uint32_t Diccionario::codificar(std::string_view valor) {
+    auto [entrada, nuevo] = codigos.insertar(valor, static_cast<uint32_t>(valores.size()));
+    if (nuevo) {
+        valores.emplace_back(valor);
+    }
+    return entrada->second;
+}
+
+bool Diccionario::buscar(std::string_view valor, uint32_t& codigo) const {
+    auto* entrada = codigos.buscar(valor);
+    if (entrada == nullptr) return false;
+    codigo = entrada->second;
+    return true;
+}
+
+void ColumnasPersona::reservar(size_t n) {
+    id.reserve(n);
+    nombre.reserve(n);
+    apellido.reserve(n);
+    ciudad.reserve(n);
+    grupo.reserve(n);
+    fecha.reserve(n);
+    ingresos.reserve(n);
+    patrimonio.reserve(n);
+    deudas.reserve(n);
+}
+
+void ColumnasPersona::vaciar() {
+    id.clear();
+    nombre.clear();
+    apellido.clear();
+    ciudad.clear();
+    grupo.clear();
+    fecha.clear();
+    ingresos.clear();
+    patrimonio.clear();
+    deudas.clear();
+}
+
+void ColumnasPersona::agregar(const Persona& persona) {
+    // Los códigos se validan antes de agregar nada para no desalinear las columnas
+    uint64_t cedula = std::stoull(persona.getId());
+    CodigoCiudad codigoCiudad;
+    CodigoGrupo codigoGrupo;
+    if (!convertirCodigo(diccionarios->ciudades.codificar(persona.getCiudadNacimiento()), codigoCiudad) ||
+        !convertirCodigo(diccionarios->grupos.codificar(persona.getGrupoDeclaracion()), codigoGrupo)) {
+        throw std::length_error("Hay más ciudades o grupos distintos de los que caben en sus columnas");
+    }
+    id.push_back(cedula);
+    nombre.push_back(diccionarios->nombres.codificar(persona.getNombre()));
+    apellido.push_back(diccionarios->apellidos.codificar(persona.getApellido()));
+    ciudad.push_back(codigoCiudad);
+    grupo.push_back(codigoGrupo);
+    fecha.push_back(empaquetarFecha(persona.getFechaNacimiento()));
+    ingresos.push_back(persona.getIngresosAnuales());
+    patrimonio.push_back(persona.getPatrimonio());
+    deudas.push_back(persona.getDeudas());
+}
+
+Persona ColumnasPersona::materializar(size_t i, std::pmr::memory_resource* recurso) const {
+    return Persona(diccionarios->nombres.valor(nombre[i]),
+                   diccionarios->apellidos.valor(apellido[i]),
+                   std::to_string(id[i]),
+                   diccionarios->ciudades.valor(ciudad[i]),
+                   desempaquetarFecha(fecha[i]),
+                   ingresos[i], patrimonio[i], deudas[i],
+                   diccionarios->grupos.valor(grupo[i]), recurso);
+}
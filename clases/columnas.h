@@ -0,0 +1,148 @@
+#ifndef COLUMNAS_H
+#define COLUMNAS_H
+
+#include "persona.h"
+#include "mapa_plano.h"
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+/**
+ * Diccionario que asigna un código entero a cada texto distinto.
+ *
+ * POR QUÉ: Ciudades, nombres y grupos se repiten millones de veces.
+ * CÓMO: Vector de valores (código -> texto) y tabla plana (texto -> código) que
+ *       se consulta con std::string_view, sin construir un std::string por búsqueda.
+ * PARA QUÉ: Guardar cada texto una sola vez y comparar enteros en las consultas.
+ */
+class Diccionario {
+public:
+    Diccionario() = default;
+    // La copia vuelve a codificar los textos en orden, así conserva los códigos
+    Diccionario(const Diccionario& otro) { *this = otro; }
+    Diccionario& operator=(const Diccionario& otro) {
+        if (this != &otro) {
+            valores.clear();
+            codigos = MapaPlano<std::string, uint32_t>();
+            for (const auto& valor : otro.valores) codificar(valor);
+        }
+        return *this;
+    }
+    Diccionario(Diccionario&&) = default;
+    Diccionario& operator=(Diccionario&&) = default;
+
+    uint32_t codificar(std::string_view valor);
+    bool buscar(std::string_view valor, uint32_t& codigo) const;
+    const std::string& valor(uint32_t codigo) const { return valores[codigo]; }
+    size_t tamano() const { return valores.size(); }
+
+private:
+    std::vector<std::string> valores;           // Texto de cada código
+    MapaPlano<std::string, uint32_t> codigos;   // Código de cada texto
+};
+
+/**
+ * Diccionarios compartidos por todas las columnas de un conjunto de datos.
+ */
+struct Diccionarios {
+    Diccionario nombres;
+    Diccionario apellidos;
+    Diccionario ciudades;
+    Diccionario grupos;
+};
+
+/**
+ * Empaqueta una fecha (día, mes, año) como entero AAAAMMDD.
+ *
+ * POR QUÉ: Comparar tuplas campo a campo es más lento que comparar un entero.
+ * CÓMO: anio * 10000 + mes * 100 + dia conserva el orden cronológico.
+ * PARA QUÉ: Que "más longeva" sea simplemente la fecha mínima.
+ */
+inline int32_t empaquetarFecha(const std::tuple<int,int,int>& fecha) {
+    return std::get<2>(fecha) * 10000 + std::get<1>(fecha) * 100 + std::get<0>(fecha);
+}
+
+inline std::tuple<int,int,int> desempaquetarFecha(int32_t fecha) {
+    return {fecha % 100, (fecha / 100) % 100, fecha / 10000};
+}
+
+/**
+ * Convierte un código de diccionario al tipo de su columna.
+ *
+ * POR QUÉ: Ciudad y grupo se guardan en 16 y 8 bits; con más textos distintos de
+ *          los que caben, un static_cast truncaría el código en silencio y la fila
+ *          mostraría otro texto (el grupo 256 como el 0).
+ * CÓMO: Compara el código con std::numeric_limits<T>::max() antes de convertirlo.
+ * PARA QUÉ: Que quien llena columnas de códigos rechace los datos en lugar de corromperlos.
+ * @return false, sin modificar destino, si el código no cabe en T.
+ */
+template <class T>
+bool convertirCodigo(uint32_t codigo, T& destino) {
+    if (codigo > std::numeric_limits<T>::max()) return false;
+    destino = static_cast<T>(codigo);
+    return true;
+}
+
+/**
+ * Conjunto de personas almacenado por columnas (Structure of Arrays).
+ *
+ * POR QUÉ: Las consultas recorren uno o dos campos, no la persona completa.
+ * CÓMO: Un vector por atributo; los textos se guardan como códigos de diccionario.
+ * PARA QUÉ: Recorridos secuenciales que solo traen a caché los bytes usados.
+ */
+struct ColumnasPersona {
+    using CodigoCiudad = uint16_t;
+    using CodigoGrupo = uint8_t;
+
+    std::vector<uint64_t> id;        // Cédula numérica
+    std::vector<uint32_t> nombre;    // Código en diccionarios->nombres
+    std::vector<uint32_t> apellido;  // Código en diccionarios->apellidos
+    std::vector<CodigoCiudad> ciudad; // Código en diccionarios->ciudades
+    std::vector<CodigoGrupo> grupo;   // Código en diccionarios->grupos
+    std::vector<int32_t> fecha;      // Fecha de nacimiento AAAAMMDD
+    std::vector<double> ingresos;    // Ingresos anuales
+    std::vector<double> patrimonio;  // Patrimonio total
+    std::vector<double> deudas;      // Deudas totales
+    std::shared_ptr<Diccionarios> diccionarios = std::make_shared<Diccionarios>();
+
+    size_t tamano() const { return id.size(); }
+    void reservar(size_t n);
+    void agregar(const Persona& persona);   // std::length_error si una ciudad o grupo nuevo no cabe
+    void vaciar();  // Quita las filas y conserva los diccionarios
+
+    /**
+     * Reconstruye la persona de la fila i.
+     *
+     * POR QUÉ: El menú y las funciones de generador.h trabajan con objetos Persona.
+     * CÓMO: Decodificando los diccionarios y desempaquetando la fecha.
+     * PARA QUÉ: Mostrar resultados o reutilizar las consultas existentes.
+     * @param recurso Recurso para los textos de la persona (p. ej. una ArenaDatos).
+     */
+    Persona materializar(size_t i, std::pmr::memory_resource* recurso = std::pmr::get_default_resource()) const;
+};
+
+/**
+ * Conjunto de personas formado por varios segmentos de columnas.
+ *
+ * POR QUÉ: La carga paralela produce un segmento por hilo y unirlos en uno solo
+ *          obligaría a copiar todas las columnas.
+ * CÓMO: Los segmentos se guardan tal cual y comparten el mismo objeto Diccionarios,
+ *       así un código significa lo mismo en cualquiera de ellos.
+ * PARA QUÉ: Recorrer el conjunto completo segmento por segmento.
+ */
+struct SegmentosPersona {
+    std::vector<ColumnasPersona> segmentos;
+
+    size_t tamano() const {
+        size_t total = 0;
+        for (const auto& segmento : segmentos) total += segmento.tamano();
+        return total;
+    }
+};
+
+#endif // COLUMNAS_H
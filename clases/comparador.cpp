@@ -0,0 +1,212 @@
+#include "comparador.h"
+#include <algorithm> // std::find
+#include <charconv>  // std::from_chars
+#include <cmath>     // std::sqrt, std::fabs
+#include <fstream>
+#include <iomanip>   // std::setprecision
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+/**
+ * Media y desviación estándar muestral de un conjunto de tiempos.
+ *
+ * POR QUÉ: La prueba t necesita ambos valores por lado.
+ * CÓMO: Dos pasadas sobre el vector (media y luego varianza con n-1).
+ * PARA QUÉ: Resumir las repeticiones de una operación.
+ */
+struct Resumen {
+    double media = 0;
+    double varianza = 0;
+    size_t n = 0;
+};
+
+Resumen resumir(const std::vector<double>& muestras) {
+    Resumen r;
+    r.n = muestras.size();
+    if (r.n == 0) return r;
+    for (double m : muestras) r.media += m;
+    r.media /= r.n;
+    if (r.n > 1) {
+        for (double m : muestras) r.varianza += (m - r.media) * (m - r.media);
+        r.varianza /= (r.n - 1);
+    }
+    return r;
+}
+
+/**
+ * Valor crítico bilateral de la distribución t al 95%.
+ *
+ * POR QUÉ: Decidir si la diferencia de medias es significativa.
+ * CÓMO: Tabla para pocos grados de libertad y aproximación normal desde 30.
+ * PARA QUÉ: Evitar depender de una biblioteca estadística externa.
+ */
+double valorCriticoT(double gl) {
+    static const double tabla[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    if (gl < 1) return tabla[0];
+    if (gl >= 30) return 1.96;
+    return tabla[static_cast<int>(gl) - 1];
+}
+
+// Convierte un campo completo; false si está vacío, no es un número o le sobran caracteres
+template <class T>
+bool leerNumero(const std::string& campo, T& valor) {
+    const char* fin = campo.data() + campo.size();
+    auto [resto, codigo] = std::from_chars(campo.data(), fin, valor);
+    return codigo == std::errc() && resto == fin;
+}
+
+// Junta las muestras de cada operación con cualquier tamaño bajo el tamaño 0
+ResultadosCsv soloPorNombre(const ResultadosCsv& resultados) {
+    ResultadosCsv porNombre;
+    for (const auto& [clave, muestras] : resultados) {
+        auto& destino = porNombre[{clave.first, 0}];
+        destino.insert(destino.end(), muestras.begin(), muestras.end());
+    }
+    return porNombre;
+}
+
+} // namespace
+
+bool cargarResultadosCsv(const std::string& nombre_archivo, ResultadosCsv& resultados, bool* conTamano) {
+    std::ifstream archivo(nombre_archivo);
+    if (!archivo) {
+        std::cerr << "Error al abrir archivo: " << nombre_archivo << std::endl;
+        return false;
+    }
+
+    // Las columnas después del nombre salen de la cabecera: los CSV viejos no tienen
+    // Tamano ni las columnas de fallos
+    std::string linea;
+    std::vector<std::string> columnas;
+    size_t numeroLinea = 1;
+    if (std::getline(archivo, linea)) {
+        if (!linea.empty() && linea.back() == '\r') linea.pop_back();
+        std::stringstream cabecera(linea);
+        std::string columna;
+        while (std::getline(cabecera, columna, ',')) columnas.push_back(columna);
+    }
+    auto posicion = [&](const std::string& nombre) {
+        auto it = std::find(columnas.begin(), columnas.end(), nombre);
+        return it == columnas.end() ? 0 : static_cast<size_t>(it - columnas.begin());
+    };
+    size_t colTamano = posicion("Tamano");
+    if (conTamano) *conTamano = colTamano > 0;
+    size_t colTiempo = posicion("Tiempo(ms)");
+    size_t numericas = columnas.size() > 1 ? columnas.size() - 1 : 2;
+    if (colTiempo == 0) colTiempo = colTamano > 0 ? 2 : 1;
+
+    while (std::getline(archivo, linea)) {
+        ++numeroLinea;
+        if (!linea.empty() && linea.back() == '\r') linea.pop_back();
+        if (linea.empty()) continue;
+
+        // Los campos numéricos van al final; el nombre puede contener comas
+        std::vector<std::string> campos(numericas);
+        size_t finNombre = linea.size();
+        bool completa = true;
+        for (size_t k = numericas; k-- > 0;) {
+            size_t coma = finNombre == 0 ? std::string::npos : linea.rfind(',', finNombre - 1);
+            if (coma == std::string::npos || coma == 0) {
+                completa = false;
+                break;
+            }
+            campos[k] = linea.substr(coma + 1, finNombre - coma - 1);
+            finNombre = coma;
+        }
+        if (!completa) continue;
+        size_t tamano = 0;
+        double tiempo = 0;
+        if ((colTamano > 0 && !leerNumero(campos[colTamano - 1], tamano)) ||
+            !leerNumero(campos[colTiempo - 1], tiempo)) {
+            std::cerr << "Valor inválido en " << nombre_archivo << ", línea " << numeroLinea << std::endl;
+            return false;
+        }
+        resultados[{linea.substr(0, finNombre), tamano}].push_back(tiempo);
+    }
+    return true;
+}
+
+int compararResultados(const std::string& archivo_base, const std::string& archivo_nuevo,
+                       double umbral_porcentaje) {
+    ResultadosCsv base, nuevo;
+    bool baseConTamano = false, nuevoConTamano = false;
+    if (!cargarResultadosCsv(archivo_base, base, &baseConTamano) ||
+        !cargarResultadosCsv(archivo_nuevo, nuevo, &nuevoConTamano)) {
+        return 2;
+    }
+
+    int regresiones = 0;
+    int faltantes = 0;
+    std::cout << "\n=== COMPARACIÓN CONTRA LÍNEA BASE (umbral " << umbral_porcentaje << "%) ===\n";
+    // Un CSV sin Tamano deja todo con tamaño 0 y ninguna clave coincidiría con las del otro
+    bool porTamano = baseConTamano && nuevoConTamano;
+    if (!porTamano) {
+        std::cout << "Sin columna Tamano en uno de los archivos: se emparejan las operaciones solo por nombre\n";
+        base = soloPorNombre(base);
+        nuevo = soloPorNombre(nuevo);
+    }
+    auto etiqueta = [&](const std::pair<std::string, size_t>& clave) {
+        return porTamano ? clave.first + " [n=" + std::to_string(clave.second) + "]" : clave.first;
+    };
+    std::cout << std::fixed << std::setprecision(3);
+    for (const auto& [clave, muestrasBase] : base) {
+        auto it = nuevo.find(clave);
+        if (it == nuevo.end()) {
+            std::cout << etiqueta(clave) << ": sin datos en la ejecución nueva\n";
+            ++faltantes;
+            continue;
+        }
+        Resumen rb = resumir(muestrasBase);
+        Resumen rn = resumir(it->second);
+        double cambio = rb.media > 0 ? (rn.media - rb.media) / rb.media * 100.0 : 0.0;
+        double aceleracion = rn.media > 0 ? rb.media / rn.media : 0.0;
+
+        // Prueba t de Welch; sin repeticiones no hay forma de medir el ruido
+        bool evaluable = rb.n > 1 && rn.n > 1;
+        bool significativo = !evaluable;
+        double t = 0;
+        if (evaluable) {
+            double eb = rb.varianza / rb.n;
+            double en = rn.varianza / rn.n;
+            double error = std::sqrt(eb + en);
+            if (error > 0) {
+                t = (rn.media - rb.media) / error;
+                double gl = (eb + en) * (eb + en) /
+                            (eb * eb / (rb.n - 1) + en * en / (rn.n - 1));
+                significativo = std::fabs(t) > valorCriticoT(gl);
+            } else {
+                significativo = rn.media != rb.media;
+            }
+        }
+
+        bool regresion = cambio > umbral_porcentaje && significativo;
+        if (regresion) ++regresiones;
+
+        std::cout << etiqueta(clave) << ": "
+                  << rb.media << " ms (" << rb.n << ") -> "
+                  << rn.media << " ms (" << rn.n << ") | "
+                  << std::showpos << cambio << std::noshowpos << "% | x" << aceleracion;
+        if (evaluable) {
+            std::cout << " | t=" << t << (significativo ? " significativo" : " no significativo");
+        } else {
+            std::cout << " | sin repeticiones";
+        }
+        std::cout << (regresion ? " | REGRESIÓN" : "") << "\n";
+    }
+    for (const auto& par : nuevo) {
+        if (base.count(par.first) == 0) {
+            std::cout << etiqueta(par.first) << ": sin datos en la línea base\n";
+        }
+    }
+    std::cout << std::defaultfloat;
+    std::cout << "Regresiones detectadas: " << regresiones << "\n";
+    std::cout << "Operaciones sin datos en la ejecución nueva: " << faltantes << "\n";
+    if (regresiones > 0) return 1;
+    return faltantes > 0 ? 3 : 0;
+}
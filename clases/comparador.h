@@ -0,0 +1,50 @@
+#ifndef COMPARADOR_H
+#define COMPARADOR_H
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Muestras de tiempo de una operación, agrupadas por nombre y tamaño.
+ *
+ * POR QUÉ: Una misma operación se repite varias veces en una ejecución.
+ * CÓMO: Clave (operación, tamaño del conjunto) con la lista de tiempos en ms.
+ * PARA QUÉ: Calcular media y dispersión de cada operación al comparar ejecuciones.
+ */
+using ResultadosCsv = std::map<std::pair<std::string, size_t>, std::vector<double>>;
+
+/**
+ * Carga un archivo CSV exportado por Monitor::exportar_csv.
+ *
+ * POR QUÉ: Los resultados de ejecuciones anteriores solo existen como CSV.
+ * CÓMO: Leyendo línea a línea; acepta el formato con columna Tamano y el antiguo sin ella.
+ * PARA QUÉ: Tener las muestras de tiempo listas para comparar.
+ * @param nombre_archivo Ruta del CSV.
+ * @param resultados Estructura donde se acumulan las muestras.
+ * @param conTamano Si no es nullptr, indica si el archivo tiene la columna Tamano;
+ *                  sin ella todas las muestras quedan con tamaño 0.
+ * @return false si el archivo no se pudo abrir o un tamaño o tiempo no es un número.
+ */
+bool cargarResultadosCsv(const std::string& nombre_archivo, ResultadosCsv& resultados, bool* conTamano = nullptr);
+
+/**
+ * Compara una ejecución nueva contra una línea base y muestra el reporte.
+ *
+ * POR QUÉ: Detectar regresiones de rendimiento antes de actualizar la herramienta.
+ * CÓMO: Empareja operaciones por nombre y tamaño (solo por nombre si alguno de los
+ *       archivos no tiene la columna Tamano), calcula el cambio de la media y
+ *       aplica la prueba t de Welch cuando hay al menos dos muestras por lado.
+ * PARA QUÉ: Servir como compuerta automática (código de salida distinto de cero).
+ * @param archivo_base CSV de la línea base.
+ * @param archivo_nuevo CSV de la ejecución nueva.
+ * @param umbral_porcentaje Porcentaje de lentitud tolerado antes de declarar regresión.
+ * @return 0 sin regresiones, 1 si hay regresiones, 2 si algún archivo no se pudo leer,
+ *         3 si no hay regresiones pero a la ejecución nueva le faltan operaciones de
+ *         la línea base (la compuerta no debe aprobar lo que no midió).
+ */
+int compararResultados(const std::string& archivo_base, const std::string& archivo_nuevo,
+                       double umbral_porcentaje = 5.0);
+
+#endif // COMPARADOR_H
@@ -0,0 +1,216 @@
+#include "compartida.h"
+#include "paginas.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char FIRMA[8] = {'P', 'E', 'R', 'S', 'O', 'N', 'A', 'S'};
+const uint32_t FORMATO = 1;
+const uint64_t ALINEACION = 64;
+
+uint64_t alinear(uint64_t desplazamiento) { return (desplazamiento + ALINEACION - 1) & ~(ALINEACION - 1); }
+
+// shm_open exige un nombre que empiece con '/'
+std::string nombrePosix(const std::string& nombre) { return nombre.empty() || nombre[0] != '/' ? "/" + nombre : nombre; }
+
+/**
+ * Reserva los bloques del segmento en orden y recuerda el desplazamiento de cada uno.
+ */
+struct Distribucion {
+    uint64_t fin = alinear(sizeof(CabeceraCompartida));
+
+    uint64_t reservar(uint64_t bytes) {
+        uint64_t inicio = fin;
+        fin = alinear(fin + bytes);
+        return inicio;
+    }
+
+    TextosCompartidos reservar(const Diccionario& diccionario) {
+        TextosCompartidos textos{};
+        textos.cantidad = static_cast<uint32_t>(diccionario.tamano());
+        uint64_t caracteres = 0;
+        for (uint32_t c = 0; c < textos.cantidad; ++c) caracteres += diccionario.valor(c).size();
+        textos.inicios = reservar((uint64_t{textos.cantidad} + 1) * sizeof(uint32_t));
+        textos.caracteres = reservar(caracteres);
+        return textos;
+    }
+};
+
+template <class T>
+void copiarColumna(char* base, uint64_t desplazamiento, const std::vector<T>& columna) {
+    if (!columna.empty()) std::memcpy(base + desplazamiento, columna.data(), columna.size() * sizeof(T));
+}
+
+void copiarTextos(char* base, const TextosCompartidos& textos, const Diccionario& diccionario) {
+    uint32_t* inicios = reinterpret_cast<uint32_t*>(base + textos.inicios);
+    char* caracteres = base + textos.caracteres;
+    uint32_t posicion = 0;
+    for (uint32_t c = 0; c < textos.cantidad; ++c) {
+        const std::string& valor = diccionario.valor(c);
+        inicios[c] = posicion;
+        std::memcpy(caracteres + posicion, valor.data(), valor.size());
+        posicion += static_cast<uint32_t>(valor.size());
+    }
+    inicios[textos.cantidad] = posicion;
+}
+
+// true si [desplazamiento, desplazamiento + bytes) queda dentro del segmento
+bool dentro(uint64_t desplazamiento, uint64_t bytes, uint64_t total) {
+    return desplazamiento >= sizeof(CabeceraCompartida) && desplazamiento <= total && bytes <= total - desplazamiento;
+}
+
+} // namespace
+
+bool publicarCompartido(const std::string& nombre, const std::vector<Persona>& personas, uint64_t version,
+                        size_t& bytes, std::string& error) {
+    ColumnasPersona columnas;
+    columnas.reservar(personas.size());
+    for (const auto& persona : personas) columnas.agregar(persona);
+    const Diccionarios& d = *columnas.diccionarios;
+
+    uint64_t filas = personas.size();
+    CabeceraCompartida cabecera{};
+    cabecera.formato = FORMATO;
+    cabecera.version = version;
+    cabecera.filas = filas;
+    Distribucion distribucion;
+    cabecera.id = distribucion.reservar(filas * sizeof(uint64_t));
+    cabecera.nombre = distribucion.reservar(filas * sizeof(uint32_t));
+    cabecera.apellido = distribucion.reservar(filas * sizeof(uint32_t));
+    cabecera.ciudad = distribucion.reservar(filas * sizeof(uint16_t));
+    cabecera.grupo = distribucion.reservar(filas * sizeof(uint8_t));
+    cabecera.fecha = distribucion.reservar(filas * sizeof(int32_t));
+    cabecera.ingresos = distribucion.reservar(filas * sizeof(double));
+    cabecera.patrimonio = distribucion.reservar(filas * sizeof(double));
+    cabecera.deudas = distribucion.reservar(filas * sizeof(double));
+    cabecera.nombres = distribucion.reservar(d.nombres);
+    cabecera.apellidos = distribucion.reservar(d.apellidos);
+    cabecera.ciudades = distribucion.reservar(d.ciudades);
+    cabecera.grupos = distribucion.reservar(d.grupos);
+    cabecera.bytes = distribucion.fin;
+
+    // Los procesos que tienen proyectado el segmento anterior lo conservan hasta soltarlo
+    std::string posix = nombrePosix(nombre);
+    shm_unlink(posix.c_str());
+    int fd = shm_open(posix.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        error = "No se pudo crear el segmento " + posix + ": " + std::strerror(errno);
+        return false;
+    }
+    void* mapa = MAP_FAILED;
+    if (ftruncate(fd, static_cast<off_t>(cabecera.bytes)) == 0) {
+        mapa = mmap(nullptr, cabecera.bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (mapa == MAP_FAILED) {
+        error = "No se pudo reservar el segmento " + posix + ": " + std::strerror(errno);
+        shm_unlink(posix.c_str());
+        return false;
+    }
+
+    char* base = static_cast<char*>(mapa);
+    copiarColumna(base, cabecera.id, columnas.id);
+    copiarColumna(base, cabecera.nombre, columnas.nombre);
+    copiarColumna(base, cabecera.apellido, columnas.apellido);
+    copiarColumna(base, cabecera.ciudad, columnas.ciudad);
+    copiarColumna(base, cabecera.grupo, columnas.grupo);
+    copiarColumna(base, cabecera.fecha, columnas.fecha);
+    copiarColumna(base, cabecera.ingresos, columnas.ingresos);
+    copiarColumna(base, cabecera.patrimonio, columnas.patrimonio);
+    copiarColumna(base, cabecera.deudas, columnas.deudas);
+    copiarTextos(base, cabecera.nombres, d.nombres);
+    copiarTextos(base, cabecera.apellidos, d.apellidos);
+    copiarTextos(base, cabecera.ciudades, d.ciudades);
+    copiarTextos(base, cabecera.grupos, d.grupos);
+    std::memcpy(base, &cabecera, sizeof(cabecera));
+    // La firma va al final: solo entonces el segmento es válido para los lectores
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    std::memcpy(base, FIRMA, sizeof(FIRMA));
+
+    munmap(mapa, cabecera.bytes);
+    bytes = static_cast<size_t>(cabecera.bytes);
+    return true;
+}
+
+bool retirarCompartido(const std::string& nombre, std::string& error) {
+    std::string posix = nombrePosix(nombre);
+    if (shm_unlink(posix.c_str()) != 0) {
+        error = "No se pudo eliminar el segmento " + posix + ": " + std::strerror(errno);
+        return false;
+    }
+    return true;
+}
+
+ConjuntoCompartido::~ConjuntoCompartido() { desadjuntar(); }
+
+void ConjuntoCompartido::desadjuntar() {
+    if (base != nullptr) munmap(const_cast<char*>(base), longitud);
+    base = nullptr;
+    longitud = 0;
+}
+
+bool ConjuntoCompartido::adjuntar(const std::string& nombre, std::string& error) {
+    desadjuntar();
+    std::string posix = nombrePosix(nombre);
+    int fd = shm_open(posix.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        error = "No se pudo abrir el segmento " + posix + ": " + std::strerror(errno);
+        return false;
+    }
+    struct stat info;
+    void* mapa = MAP_FAILED;
+    size_t total = 0;
+    if (fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= sizeof(CabeceraCompartida)) {
+        total = static_cast<size_t>(info.st_size);
+        // Con --prefault las tablas de páginas se crean aquí y no en la primera consulta
+        int banderas = MAP_SHARED | (politicaPaginas().prellenar ? MAP_POPULATE : 0);
+        mapa = mmap(nullptr, total, PROT_READ, banderas, fd, 0);
+    }
+    close(fd);
+    if (mapa == MAP_FAILED) {
+        error = "El segmento " + posix + " no contiene un conjunto de datos";
+        return false;
+    }
+    base = static_cast<const char*>(mapa);
+    longitud = total;
+    prepararRegion(base, longitud, true);
+
+    // Antes de exponer las columnas se comprueba que todas quepan en el segmento
+    const CabeceraCompartida& c = cabecera();
+    uint64_t n = c.filas;
+    bool valida = std::memcmp(c.firma, FIRMA, sizeof(FIRMA)) == 0 && c.formato == FORMATO && c.bytes == total &&
+                  n <= total && dentro(c.id, n * sizeof(uint64_t), total) &&
+                  dentro(c.nombre, n * sizeof(uint32_t), total) && dentro(c.apellido, n * sizeof(uint32_t), total) &&
+                  dentro(c.ciudad, n * sizeof(uint16_t), total) && dentro(c.grupo, n, total) &&
+                  dentro(c.fecha, n * sizeof(int32_t), total) && dentro(c.ingresos, n * sizeof(double), total) &&
+                  dentro(c.patrimonio, n * sizeof(double), total) && dentro(c.deudas, n * sizeof(double), total);
+    for (const TextosCompartidos* t : {&c.nombres, &c.apellidos, &c.ciudades, &c.grupos}) {
+        valida = valida && dentro(t->inicios, (uint64_t{t->cantidad} + 1) * sizeof(uint32_t), total) &&
+                 dentro(t->caracteres, 0, total);
+    }
+    if (!valida) {
+        error = "El segmento " + posix + " no es válido o aún se está publicando";
+        desadjuntar();
+        return false;
+    }
+    return true;
+}
+
+std::string_view ConjuntoCompartido::texto(const TextosCompartidos& textos, uint32_t codigo) const {
+    if (codigo >= textos.cantidad) return {};
+    const uint32_t* inicios = columna<uint32_t>(textos.inicios);
+    uint64_t disponibles = longitud - textos.caracteres;
+    if (inicios[codigo] > inicios[codigo + 1] || inicios[codigo + 1] > disponibles) return {};
+    return std::string_view(base + textos.caracteres + inicios[codigo], inicios[codigo + 1] - inicios[codigo]);
+}
+
+Persona ConjuntoCompartido::materializar(size_t i) const {
+    return Persona(textoNombre(nombre()[i]), textoApellido(apellido()[i]), std::to_string(id()[i]),
+                   textoCiudad(ciudad()[i]), desempaquetarFecha(fecha()[i]), ingresos()[i], patrimonio()[i],
+                   deudas()[i], textoGrupo(grupo()[i]));
+}
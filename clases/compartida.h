@@ -0,0 +1,146 @@
+#ifndef COMPARTIDA_H
+#define COMPARTIDA_H
+
+#include "persona.h"
+#include "columnas.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Conjunto de datos en un segmento de memoria compartida POSIX.
+//
+// El segmento no contiene punteros ni std::string: todo se ubica con desplazamientos
+// desde su inicio, así cada proceso puede proyectarlo en cualquier dirección.
+//   Cabecera | columnas id, nombre, apellido, ciudad, grupo, fecha, ingresos,
+//   patrimonio, deudas | por diccionario: u32 inicios[cantidad + 1] y caracteres
+// Cada bloque empieza alineado a 64 bytes (una línea de caché).
+
+/**
+ * Textos de un diccionario dentro del segmento: el texto c ocupa los caracteres
+ * [inicios[c], inicios[c + 1]).
+ */
+struct TextosCompartidos {
+    uint64_t inicios;      // Desplazamiento de u32 inicios[cantidad + 1]
+    uint64_t caracteres;   // Desplazamiento de los caracteres
+    uint32_t cantidad;
+    uint32_t reservado;
+};
+
+/**
+ * Cabecera del segmento. La firma se escribe al final de la publicación, así un
+ * lector que se adjunta antes de tiempo la rechaza en vez de leer columnas a medias.
+ */
+struct CabeceraCompartida {
+    char firma[8];
+    uint32_t formato;
+    uint32_t reservado;
+    uint64_t version;      // Versión del conjunto publicado (ver instantaneas.h)
+    uint64_t filas;
+    uint64_t bytes;        // Tamaño total del segmento
+    uint64_t id, nombre, apellido, ciudad, grupo, fecha, ingresos, patrimonio, deudas;   // Desplazamientos
+    TextosCompartidos nombres, apellidos, ciudades, grupos;
+};
+
+/**
+ * Copia las personas a un segmento de memoria compartida nuevo.
+ *
+ * POR QUÉ: Varios procesos de consulta por máquina tenían cada uno su copia de
+ *          cientos de MB de los mismos datos.
+ * CÓMO: Codifica las personas por columnas con diccionarios, calcula el tamaño,
+ *       crea el segmento con shm_open + ftruncate y escribe todo con mmap. Si ya
+ *       existía uno con ese nombre se desvincula primero: los procesos que lo tienen
+ *       proyectado siguen leyendo la versión anterior hasta que se desadjuntan.
+ * PARA QUÉ: Que los lectores compartan las mismas páginas físicas.
+ * @param nombre Nombre POSIX del segmento ("/personas"; se agrega la barra si falta).
+ * @param bytes Tamaño del segmento creado.
+ * @return false si no se pudo crear; el motivo queda en error.
+ */
+bool publicarCompartido(const std::string& nombre, const std::vector<Persona>& personas, uint64_t version,
+                        size_t& bytes, std::string& error);
+
+/**
+ * Elimina el nombre del segmento; la memoria se libera cuando se desadjunta el último lector.
+ */
+bool retirarCompartido(const std::string& nombre, std::string& error);
+
+/**
+ * Vista de solo lectura de un segmento publicado con publicarCompartido.
+ *
+ * POR QUÉ: Leer los datos sin copiarlos al espacio del proceso.
+ * CÓMO: Proyecta el segmento con PROT_READ y valida la cabecera y que cada bloque
+ *       quede dentro del segmento; las columnas se exponen como arreglos.
+ * PARA QUÉ: Ejecutar las consultas de consultas.h con LayoutCompartido.
+ */
+class ConjuntoCompartido {
+public:
+    ConjuntoCompartido() = default;
+    ~ConjuntoCompartido();
+    ConjuntoCompartido(const ConjuntoCompartido&) = delete;
+    ConjuntoCompartido& operator=(const ConjuntoCompartido&) = delete;
+
+    /**
+     * Se adjunta al segmento (y suelta el anterior, si había uno).
+     * @return false si no existe o no es válido; el motivo queda en error.
+     */
+    bool adjuntar(const std::string& nombre, std::string& error);
+    void desadjuntar();
+
+    size_t tamano() const { return static_cast<size_t>(cabecera().filas); }
+    uint64_t version() const { return cabecera().version; }
+    size_t bytes() const { return longitud; }
+
+    const uint64_t* id() const { return columna<uint64_t>(cabecera().id); }
+    const uint32_t* nombre() const { return columna<uint32_t>(cabecera().nombre); }
+    const uint32_t* apellido() const { return columna<uint32_t>(cabecera().apellido); }
+    const uint16_t* ciudad() const { return columna<uint16_t>(cabecera().ciudad); }
+    const uint8_t* grupo() const { return columna<uint8_t>(cabecera().grupo); }
+    const int32_t* fecha() const { return columna<int32_t>(cabecera().fecha); }
+    const double* ingresos() const { return columna<double>(cabecera().ingresos); }
+    const double* patrimonio() const { return columna<double>(cabecera().patrimonio); }
+    const double* deudas() const { return columna<double>(cabecera().deudas); }
+
+    // Texto del código en el diccionario (vacío si el código no existe)
+    std::string_view texto(const TextosCompartidos& textos, uint32_t codigo) const;
+    std::string_view textoNombre(uint32_t c) const { return texto(cabecera().nombres, c); }
+    std::string_view textoApellido(uint32_t c) const { return texto(cabecera().apellidos, c); }
+    std::string_view textoCiudad(uint32_t c) const { return texto(cabecera().ciudades, c); }
+    std::string_view textoGrupo(uint32_t c) const { return texto(cabecera().grupos, c); }
+
+    /**
+     * Reconstruye la persona de la fila i (para mostrar resultados).
+     */
+    Persona materializar(size_t i) const;
+
+private:
+    const CabeceraCompartida& cabecera() const { return *reinterpret_cast<const CabeceraCompartida*>(base); }
+
+    template <class T>
+    const T* columna(uint64_t desplazamiento) const { return reinterpret_cast<const T*>(base + desplazamiento); }
+
+    const char* base = nullptr;
+    size_t longitud = 0;
+};
+
+// Layout de consultas.h sobre un segmento adjunto. No tiene construir(): el almacén
+// lo publica otro proceso, así que no participa en la comparación de layouts.
+struct LayoutCompartido {
+    static constexpr const char* nombre = "Memoria compartida";
+    using Almacen = ConjuntoCompartido;
+    using Clave = uint32_t;
+
+    static size_t tamano(const Almacen& a) { return a.tamano(); }
+    static Clave ciudad(const Almacen& a, size_t i) { return a.ciudad()[i]; }
+    static Clave grupo(const Almacen& a, size_t i) { return a.grupo()[i]; }
+    static int32_t fecha(const Almacen& a, size_t i) { return a.fecha()[i]; }
+    static double patrimonio(const Almacen& a, size_t i) { return a.patrimonio()[i]; }
+    static double deudas(const Almacen& a, size_t i) { return a.deudas()[i]; }
+    static std::string textoCiudad(const Almacen& a, Clave c) { return std::string(a.textoCiudad(c)); }
+    static std::string textoGrupo(const Almacen& a, Clave c) { return std::string(a.textoGrupo(c)); }
+    static std::string descripcion(const Almacen& a, size_t i) {
+        return "[" + std::to_string(a.id()[i]) + "] " + std::string(a.textoNombre(a.nombre()[i])) + " " +
+               std::string(a.textoApellido(a.apellido()[i]));
+    }
+};
+
+#endif // COMPARTIDA_H
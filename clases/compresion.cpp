@@ -0,0 +1,171 @@
+#include "compresion.h"
+#include "simd.h"
+#include <cmath>
+#include <limits>
+#include <string>
+
+#ifdef SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Filas que se decodifican por bloque en los recorridos sobre códigos
+const size_t FILAS_POR_BLOQUE = 1024;
+
+#ifdef SIMD_X86
+/**
+ * Decodificación de 8 códigos por iteración con AVX2.
+ *
+ * POR QUÉ: Con anchos de hasta 25 bits, cada código cabe en la palabra de 32 bits
+ *          que empieza en su primer byte.
+ * CÓMO: Calcula la posición en bits de 8 filas consecutivas, lee las 8 palabras con
+ *       una lectura gather, las desplaza con srlv y aplica la máscara del ancho.
+ * PARA QUÉ: Decodificar sin una rama ni un desplazamiento escalar por fila.
+ */
+__attribute__((target("avx2")))
+size_t decodificarAvx2(const uint8_t* datos, unsigned ancho, size_t inicio, size_t n, uint32_t* salida) {
+    const __m256i mascara = _mm256_set1_epi32(static_cast<int>((1u << ancho) - 1));
+    const __m256i siete = _mm256_set1_epi32(7);
+    const __m256i pasos = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                             _mm256_set1_epi32(static_cast<int>(ancho)));
+    size_t k = 0;
+    for (; k + 8 <= n; k += 8) {
+        size_t bit = (inicio + k) * ancho;
+        const int* base = reinterpret_cast<const int*>(datos + (bit >> 3));
+        __m256i bits = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(bit & 7)), pasos);
+        __m256i palabras = _mm256_i32gather_epi32(base, _mm256_srli_epi32(bits, 3), 1);
+        __m256i valores = _mm256_and_si256(_mm256_srlv_epi32(palabras, _mm256_and_si256(bits, siete)), mascara);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(salida + k), valores);
+    }
+    return k;
+}
+#endif
+
+} // namespace
+
+void ColumnaEmpaquetada::escribir(size_t i, uint64_t codigo) {
+    size_t bit = i * ancho;
+    uint8_t* p = datos.data() + (bit >> 3);
+    unsigned desplazamiento = bit & 7;
+    uint64_t palabra;
+    std::memcpy(&palabra, p, sizeof(palabra));
+    palabra |= codigo << desplazamiento;
+    std::memcpy(p, &palabra, sizeof(palabra));
+    if (ancho + desplazamiento > 64) p[8] |= static_cast<uint8_t>(codigo >> (64 - desplazamiento));
+}
+
+void ColumnaEmpaquetada::decodificar(size_t inicio, size_t n, uint32_t* salida) const {
+    size_t k = 0;
+#ifdef SIMD_X86
+    if (ancho <= 25 && tieneAvx2()) k = decodificarAvx2(datos.data(), ancho, inicio, n, salida);
+#endif
+    for (; k < n; ++k) salida[k] = static_cast<uint32_t>(codigo(inicio + k));
+}
+
+void ColumnaMonto::comprimir(const std::vector<double>& valores) {
+    std::vector<int64_t> enteros;
+    enteros.reserve(valores.size());
+    empaquetada = true;
+    for (double v : valores) {
+        // Fuera de ±2^53 centavos la conversión ya no es exacta
+        if (!(std::fabs(v) < 9e13)) {
+            empaquetada = false;
+            break;
+        }
+        int64_t c = std::llround(v * 100.0);
+        if (static_cast<double>(c) / 100.0 != v) {
+            empaquetada = false;
+            break;
+        }
+        enteros.push_back(c);
+    }
+    if (empaquetada) {
+        centavos.comprimir(enteros);
+        crudos.clear();
+        crudos.shrink_to_fit();
+    } else {
+        crudos = valores;
+    }
+}
+
+void ColumnaMonto::filtrarMayor(double umbral, std::vector<uint32_t>& filas) const {
+    if (!empaquetada) {
+        for (size_t i = 0; i < crudos.size(); ++i) {
+            if (crudos[i] > umbral) filas.push_back(static_cast<uint32_t>(i));
+        }
+        return;
+    }
+    // Menor cantidad de centavos cuyo valor supera el umbral
+    double aproximado = std::floor(umbral * 100.0);
+    if (aproximado < -9e13) aproximado = -9e13;
+    if (aproximado > 9e13) return;
+    int64_t limite = static_cast<int64_t>(aproximado);
+    while (static_cast<double>(limite) / 100.0 > umbral) --limite;
+    while (static_cast<double>(limite) / 100.0 <= umbral) ++limite;
+    if (limite < centavos.referencia()) limite = centavos.referencia();
+    uint64_t codigoLimite = static_cast<uint64_t>(limite - centavos.referencia());
+    for (size_t i = 0; i < centavos.tamano(); ++i) {
+        if (centavos.codigo(i) >= codigoLimite) filas.push_back(static_cast<uint32_t>(i));
+    }
+}
+
+ColumnasComprimidas ColumnasComprimidas::comprimir(const ColumnasPersona& columnas) {
+    ColumnasComprimidas c;
+    c.id.comprimir(columnas.id);
+    c.nombre.comprimir(columnas.nombre);
+    c.apellido.comprimir(columnas.apellido);
+    c.ciudad.comprimir(columnas.ciudad);
+    c.grupo.comprimir(columnas.grupo);
+    c.fecha.comprimir(columnas.fecha);
+    c.ingresos.comprimir(columnas.ingresos);
+    c.patrimonio.comprimir(columnas.patrimonio);
+    c.deudas.comprimir(columnas.deudas);
+    c.diccionarios = columnas.diccionarios;
+    return c;
+}
+
+size_t ColumnasComprimidas::bytes() const {
+    return id.bytes() + nombre.bytes() + apellido.bytes() + ciudad.bytes() + grupo.bytes() +
+           fecha.bytes() + ingresos.bytes() + patrimonio.bytes() + deudas.bytes();
+}
+
+Persona ColumnasComprimidas::materializar(size_t i, std::pmr::memory_resource* recurso) const {
+    return Persona(diccionarios->nombres.valor(static_cast<uint32_t>(nombre.valor(i))),
+                   diccionarios->apellidos.valor(static_cast<uint32_t>(apellido.valor(i))),
+                   std::to_string(id.valor(i)),
+                   diccionarios->ciudades.valor(static_cast<uint32_t>(ciudad.valor(i))),
+                   desempaquetarFecha(static_cast<int32_t>(fecha.valor(i))),
+                   ingresos.valor(i), patrimonio.valor(i), deudas.valor(i),
+                   diccionarios->grupos.valor(static_cast<uint32_t>(grupo.valor(i))), recurso);
+}
+
+size_t ColumnasComprimidas::longeva() const {
+    uint32_t codigos[FILAS_POR_BLOQUE];
+    size_t mejor = 0;
+    uint32_t mejorCodigo = std::numeric_limits<uint32_t>::max();
+    for (size_t inicio = 0; inicio < tamano(); inicio += FILAS_POR_BLOQUE) {
+        size_t n = std::min(FILAS_POR_BLOQUE, tamano() - inicio);
+        fecha.decodificar(inicio, n, codigos);
+        for (size_t k = 0; k < n; ++k) {
+            if (codigos[k] < mejorCodigo) {
+                mejorCodigo = codigos[k];
+                mejor = inicio + k;
+            }
+        }
+    }
+    return mejor;
+}
+
+void ColumnasComprimidas::filtrarCiudad(uint32_t codigoCiudad, std::vector<uint32_t>& filas) const {
+    if (codigoCiudad < ciudad.referencia() || ((codigoCiudad - ciudad.referencia()) >> ciudad.bits()) != 0) return;
+    uint32_t buscado = static_cast<uint32_t>(codigoCiudad - ciudad.referencia());
+    uint32_t codigos[FILAS_POR_BLOQUE];
+    for (size_t inicio = 0; inicio < tamano(); inicio += FILAS_POR_BLOQUE) {
+        size_t n = std::min(FILAS_POR_BLOQUE, tamano() - inicio);
+        ciudad.decodificar(inicio, n, codigos);
+        for (size_t k = 0; k < n; ++k) {
+            if (codigos[k] == buscado) filas.push_back(static_cast<uint32_t>(inicio + k));
+        }
+    }
+}
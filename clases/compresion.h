@@ -0,0 +1,165 @@
+#ifndef COMPRESION_H
+#define COMPRESION_H
+
+#include "persona.h"
+#include "columnas.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * Columna de enteros con referencia de marco y empaquetado de bits.
+ *
+ * POR QUÉ: Las cédulas son consecutivas, las fechas caen en un rango de un siglo y
+ *          los códigos de ciudad caben en 5 bits, pero se guardan en 8, 4 y 2 bytes.
+ * CÓMO: Se resta el mínimo de la columna (la base) y cada diferencia ocupa exactamente
+ *       los bits necesarios para la mayor, una tras otra en un arreglo de bytes.
+ *       Como la resta conserva el orden, comparar códigos equivale a comparar valores.
+ * PARA QUÉ: Reducir la memoria y el ancho de banda de los recorridos; los mínimos,
+ *           máximos y filtros de igualdad se evalúan sin reconstruir los valores.
+ */
+class ColumnaEmpaquetada {
+public:
+    template <class T>
+    void comprimir(const std::vector<T>& valores) {
+        cantidad = valores.size();
+        base = 0;
+        ancho = 0;
+        if (cantidad == 0) {
+            datos.assign(RELLENO, 0);
+            return;
+        }
+        auto [minimo, maximo] = std::minmax_element(valores.begin(), valores.end());
+        base = static_cast<int64_t>(*minimo);
+        uint64_t rango = static_cast<uint64_t>(static_cast<int64_t>(*maximo) - base);
+        while (ancho < 64 && (rango >> ancho) != 0) ++ancho;
+        datos.assign((cantidad * ancho + 7) / 8 + RELLENO, 0);
+        for (size_t i = 0; i < cantidad; ++i) {
+            escribir(i, static_cast<uint64_t>(static_cast<int64_t>(valores[i]) - base));
+        }
+    }
+
+    size_t tamano() const { return cantidad; }
+    unsigned bits() const { return ancho; }
+    int64_t referencia() const { return base; }
+    size_t bytes() const { return datos.size(); }
+
+    // Código (valor - referencia) de la fila i
+    uint64_t codigo(size_t i) const {
+        size_t bit = i * ancho;
+        uint64_t palabra;
+        std::memcpy(&palabra, datos.data() + (bit >> 3), sizeof(palabra));
+        unsigned desplazamiento = bit & 7;
+        uint64_t valor = palabra >> desplazamiento;
+        if (ancho + desplazamiento > 64) valor |= uint64_t(datos[(bit >> 3) + 8]) << (64 - desplazamiento);
+        return ancho == 64 ? valor : valor & ((uint64_t(1) << ancho) - 1);
+    }
+
+    int64_t valor(size_t i) const { return base + static_cast<int64_t>(codigo(i)); }
+
+    /**
+     * Decodifica los códigos de [inicio, inicio + n) en salida (requiere bits() <= 32).
+     *
+     * POR QUÉ: Extraer los bits fila por fila no aprovecha el procesador.
+     * CÓMO: Con AVX2 (si la CPU lo tiene y bits() <= 25) se leen 8 códigos por
+     *       iteración con una lectura gather y desplazamientos variables; si no, escalar.
+     * PARA QUÉ: Recorrer la columna por bloques sin volver al ancho original.
+     */
+    void decodificar(size_t inicio, size_t n, uint32_t* salida) const;
+
+private:
+    // Bytes extra al final para que las lecturas de 8 bytes (y de 9 en el peor caso) no se salgan
+    static constexpr size_t RELLENO = 16;
+
+    void escribir(size_t i, uint64_t codigo);
+
+    std::vector<uint8_t> datos;
+    size_t cantidad = 0;
+    unsigned ancho = 0;
+    int64_t base = 0;
+};
+
+/**
+ * Columna de montos que se guarda en centavos empaquetados cuando no pierde precisión.
+ *
+ * POR QUÉ: Los extractos reales traen montos con dos decimales, que como enteros en
+ *          centavos ocupan unos 40 bits en lugar de 64; los montos generados, en
+ *          cambio, tienen decimales arbitrarios y no se pueden reducir sin perderlos.
+ * CÓMO: Se convierte cada monto a centavos y se comprueba que centavos / 100.0
+ *       devuelva exactamente el mismo double; si todos pasan, se empaquetan con
+ *       ColumnaEmpaquetada y si no, se guardan tal cual.
+ * PARA QUÉ: Compresión opcional que nunca cambia los resultados de las consultas.
+ */
+class ColumnaMonto {
+public:
+    void comprimir(const std::vector<double>& valores);
+
+    bool enCentavos() const { return empaquetada; }
+    size_t bytes() const { return empaquetada ? centavos.bytes() : crudos.size() * sizeof(double); }
+
+    double valor(size_t i) const {
+        return empaquetada ? static_cast<double>(centavos.valor(i)) / 100.0 : crudos[i];
+    }
+
+    /**
+     * Filas con monto mayor al umbral, en orden.
+     *
+     * POR QUÉ: El listado por umbral es la consulta más pesada del menú.
+     * CÓMO: En centavos, el umbral se traduce una sola vez a un código y se comparan
+     *       códigos; sin compresión, se comparan los doubles.
+     * PARA QUÉ: Filtrar sin convertir ninguna fila a double.
+     */
+    void filtrarMayor(double umbral, std::vector<uint32_t>& filas) const;
+
+private:
+    bool empaquetada = false;
+    ColumnaEmpaquetada centavos;
+    std::vector<double> crudos;
+};
+
+/**
+ * Conjunto de personas en columnas comprimidas.
+ *
+ * POR QUÉ: Con 100 millones de filas, incluso las columnas sin comprimir ocupan
+ *          4,7 GB; la mayoría de esos bytes son ceros de relleno en los enteros.
+ * CÓMO: Cédula, fecha, ciudad, grupo, nombre y apellido como ColumnaEmpaquetada y
+ *       los montos como ColumnaMonto, con los mismos diccionarios de las columnas.
+ * PARA QUÉ: Recorrer menos memoria por consulta y evaluar filtros sobre los códigos.
+ */
+struct ColumnasComprimidas {
+    ColumnaEmpaquetada id;
+    ColumnaEmpaquetada nombre;
+    ColumnaEmpaquetada apellido;
+    ColumnaEmpaquetada ciudad;
+    ColumnaEmpaquetada grupo;
+    ColumnaEmpaquetada fecha;      // AAAAMMDD
+    ColumnaMonto ingresos;
+    ColumnaMonto patrimonio;
+    ColumnaMonto deudas;
+    std::shared_ptr<Diccionarios> diccionarios;
+
+    static ColumnasComprimidas comprimir(const ColumnasPersona& columnas);
+
+    size_t tamano() const { return id.tamano(); }
+    size_t bytes() const;
+    Persona materializar(size_t i, std::pmr::memory_resource* recurso = std::pmr::get_default_resource()) const;
+
+    /**
+     * Fila con la fecha de nacimiento mínima (la persona más longeva).
+     *
+     * POR QUÉ: El mínimo de la fecha no necesita sumar la referencia a cada fila.
+     * CÓMO: Decodifica bloques de códigos con decodificar() y busca el menor código.
+     * PARA QUÉ: Evaluar la consulta directamente sobre los datos comprimidos.
+     */
+    size_t longeva() const;
+
+    /**
+     * Filas de una ciudad (código de diccionarios->ciudades), comparando códigos empaquetados.
+     */
+    void filtrarCiudad(uint32_t codigoCiudad, std::vector<uint32_t>& filas) const;
+};
+
+#endif // COMPRESION_H
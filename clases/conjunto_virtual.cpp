@@ -0,0 +1,55 @@
+#include "conjunto_virtual.h"
+#include "arena.h"
+#include "generador.h"
+#include <algorithm>
+#include <vector>
+
+Persona ConjuntoVirtual::persona(uint64_t i, std::pmr::memory_resource* recurso) const {
+    return generarPersonaVirtual(semilla, i, recurso);
+}
+
+void ConjuntoVirtual::materializar(uint64_t inicio, uint64_t fin, ColumnasPersona& destino) const {
+    fin = std::min(fin, filas);
+    if (inicio >= fin) return;
+    destino.reservar(destino.tamano() + static_cast<size_t>(fin - inicio));
+    // Las personas solo viven hasta pasar a columnas: sus textos van a una arena del rango
+    ArenaDatos arena;
+    for (uint64_t i = inicio; i < fin; ++i) destino.agregar(generarPersonaVirtual(semilla, i, &arena));
+}
+
+void reporteVirtual(const ConjuntoVirtual& conjunto, PlanificadorTareas* planificador, size_t grano,
+                    EstadoAgregado& estado) {
+    grano = std::max<size_t>(grano, 1);
+    uint64_t bloques = (conjunto.tamano() + grano - 1) / grano;
+    auto agregarBloque = [&](uint64_t b, EstadoAgregado& parcial) {
+        ColumnasPersona columnas;
+        conjunto.materializar(b * grano, (b + 1) * grano, columnas);
+        parcial.agregar(columnas);
+    };
+
+    if (!planificador) {
+        for (uint64_t b = 0; b < bloques; ++b) {
+            EstadoAgregado parcial;
+            parcial.umbral = estado.umbral;
+            parcial.limiteListado = estado.limiteListado;
+            agregarBloque(b, parcial);
+            estado.combinar(std::move(parcial));
+        }
+        return;
+    }
+
+    // Suficientes bloques por ronda para que el robo de trabajo equilibre a los hilos
+    uint64_t porRonda = static_cast<uint64_t>(planificador->hilos()) * 4;
+    std::vector<EstadoAgregado> parciales;
+    for (uint64_t primero = 0; primero < bloques; primero += porRonda) {
+        size_t ronda = static_cast<size_t>(std::min(porRonda, bloques - primero));
+        parciales.clear();
+        parciales.resize(ronda);
+        for (auto& parcial : parciales) {
+            parcial.umbral = estado.umbral;
+            parcial.limiteListado = estado.limiteListado;
+        }
+        planificador->paraCada(ronda, [&](size_t k) { agregarBloque(primero + k, parciales[k]); });
+        for (auto& parcial : parciales) estado.combinar(std::move(parcial));
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef CONJUNTO_VIRTUAL_H
+#define CONJUNTO_VIRTUAL_H
+
+#include "persona.h"
+#include "columnas.h"
+#include "agregados.h"
+#include "planificador.h"
+#include <cstdint>
+#include <memory_resource>
+
+/**
+ * Conjunto de personas que no se guarda: la fila i se calcula a partir de (semilla, i).
+ *
+ * POR QUÉ: Las pruebas de escala necesitan miles de millones de filas y ni el
+ *          vector de personas ni un CSV de ese tamaño caben en la máquina.
+ * CÓMO: Solo guarda la semilla y el número de filas; cada fila la genera
+ *       generarPersonaVirtual con un generador basado en contador, así cualquier
+ *       rango se puede materializar en cualquier orden y en cualquier hilo.
+ * PARA QUÉ: Que el tamaño de una prueba dependa del tiempo de cálculo, no de la RAM.
+ */
+class ConjuntoVirtual {
+public:
+    ConjuntoVirtual(uint64_t semilla, uint64_t filas) : semilla(semilla), filas(filas) {}
+
+    uint64_t tamano() const { return filas; }
+
+    Persona persona(uint64_t i, std::pmr::memory_resource* recurso = std::pmr::get_default_resource()) const;
+
+    /**
+     * Agrega las filas [inicio, fin) a destino, por columnas.
+     */
+    void materializar(uint64_t inicio, uint64_t fin, ColumnasPersona& destino) const;
+
+private:
+    uint64_t semilla;
+    uint64_t filas;
+};
+
+/**
+ * Calcula el reporte completo (ver EstadoAgregado) sobre un conjunto virtual.
+ *
+ * CÓMO: Recorre bloques de grano filas; cada bloque se materializa en columnas, se
+ *       agrega a un estado parcial y se descarta. Con planificador los bloques se
+ *       reparten con robo de trabajo por rondas de unos pocos bloques por hilo, y
+ *       los parciales de cada ronda se combinan en orden de bloque antes de la
+ *       siguiente: la memoria depende de los hilos, del grano y de
+ *       estado.limiteListado (sin límite, el listado por umbral crece con el
+ *       resultado), no del número de filas, y el resultado es el mismo con
+ *       cualquier número de hilos.
+ * @param planificador nullptr para recorrer los bloques en el hilo que llama.
+ */
+void reporteVirtual(const ConjuntoVirtual& conjunto, PlanificadorTareas* planificador, size_t grano,
+                    EstadoAgregado& estado);
+
+#endif // CONJUNTO_VIRTUAL_H
@@ -0,0 +1,144 @@
+#ifndef CONSULTAS_H
+#define CONSULTAS_H
+
+#include "mapa_plano.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+// Consultas genéricas sobre cualquier política de layouts.h.
+//
+// Cada consulta se escribe una sola vez y el compilador la instancia por layout,
+// de modo que la comparación entre layouts mide el acceso a memoria y no
+// diferencias de implementación. Los resultados son índices de fila.
+
+/**
+ * Índice de la persona más longeva del país.
+ *
+ * POR QUÉ: Consulta base del análisis (opciones 2 y 3 del menú).
+ * CÓMO: Mínimo de la fecha empaquetada AAAAMMDD.
+ * PARA QUÉ: Medir un recorrido completo que solo lee la fecha.
+ */
+template <class L>
+size_t longevaPais(const typename L::Almacen& a) {
+    size_t mejor = 0;
+    for (size_t i = 1, n = L::tamano(a); i < n; ++i) {
+        if (L::fecha(a, i) < L::fecha(a, mejor)) mejor = i;
+    }
+    return mejor;
+}
+
+/**
+ * Índice de la persona más longeva por ciudad.
+ */
+template <class L>
+MapaPlano<typename L::Clave, size_t> longevaPorCiudad(const typename L::Almacen& a) {
+    MapaPlano<typename L::Clave, size_t> resultado;
+    for (size_t i = 0, n = L::tamano(a); i < n; ++i) {
+        auto [entrada, nueva] = resultado.insertar(L::ciudad(a, i), i);
+        if (!nueva && L::fecha(a, i) < L::fecha(a, entrada->second)) entrada->second = i;
+    }
+    return resultado;
+}
+
+/**
+ * Índice de la persona con mayor patrimonio neto (patrimonio - deudas) del país.
+ */
+template <class L>
+size_t mayorPatrimonioPais(const typename L::Almacen& a) {
+    size_t mejor = 0;
+    double mejorNeto = L::patrimonio(a, 0) - L::deudas(a, 0);
+    for (size_t i = 1, n = L::tamano(a); i < n; ++i) {
+        double neto = L::patrimonio(a, i) - L::deudas(a, i);
+        if (mejorNeto < neto) {
+            mejorNeto = neto;
+            mejor = i;
+        }
+    }
+    return mejor;
+}
+
+/**
+ * Índice de la persona con mayor patrimonio neto por la llave que indique Campo.
+ *
+ * POR QUÉ: Por ciudad y por grupo solo difieren en la llave de agrupación.
+ * CÓMO: Campo es un puntero a la función de la política que devuelve la llave.
+ * PARA QUÉ: Una sola implementación para ambas agrupaciones.
+ */
+template <class L, class Campo>
+MapaPlano<typename L::Clave, size_t> mayorPatrimonioPor(const typename L::Almacen& a, Campo campo) {
+    MapaPlano<typename L::Clave, size_t> resultado;
+    for (size_t i = 0, n = L::tamano(a); i < n; ++i) {
+        auto [entrada, nueva] = resultado.insertar(campo(a, i), i);
+        if (!nueva) {
+            size_t j = entrada->second;
+            if (L::patrimonio(a, j) - L::deudas(a, j) < L::patrimonio(a, i) - L::deudas(a, i)) entrada->second = i;
+        }
+    }
+    return resultado;
+}
+
+template <class L>
+MapaPlano<typename L::Clave, size_t> mayorPatrimonioPorCiudad(const typename L::Almacen& a) {
+    return mayorPatrimonioPor<L>(a, &L::ciudad);
+}
+
+template <class L>
+MapaPlano<typename L::Clave, size_t> mayorPatrimonioPorGrupo(const typename L::Almacen& a) {
+    return mayorPatrimonioPor<L>(a, &L::grupo);
+}
+
+/**
+ * Índice de las personas de cada grupo de declaración.
+ */
+template <class L>
+MapaPlano<typename L::Clave, std::vector<size_t>> listarPorGrupo(const typename L::Almacen& a) {
+    MapaPlano<typename L::Clave, std::vector<size_t>> resultado;
+    for (size_t i = 0, n = L::tamano(a); i < n; ++i) {
+        resultado.insertar(L::grupo(a, i)).first->second.push_back(i);
+    }
+    return resultado;
+}
+
+/**
+ * Índice de la persona con mayores deudas del país.
+ */
+template <class L>
+size_t mayorDeudaPais(const typename L::Almacen& a) {
+    size_t mejor = 0;
+    for (size_t i = 1, n = L::tamano(a); i < n; ++i) {
+        if (L::deudas(a, mejor) < L::deudas(a, i)) mejor = i;
+    }
+    return mejor;
+}
+
+/**
+ * Ciudad con mayor patrimonio agregado y su total.
+ */
+template <class L>
+std::pair<typename L::Clave, long double> ciudadMayorPatrimonio(const typename L::Almacen& a) {
+    MapaPlano<typename L::Clave, long double> totales;
+    for (size_t i = 0, n = L::tamano(a); i < n; ++i) {
+        totales.insertar(L::ciudad(a, i), 0.0L).first->second += L::patrimonio(a, i);
+    }
+    std::pair<typename L::Clave, long double> mejor{typename L::Clave{}, 0};
+    for (const auto& par : totales) {
+        if (par.second > mejor.second) mejor = par;
+    }
+    return mejor;
+}
+
+/**
+ * Índices por ciudad de las personas con patrimonio mayor al umbral.
+ */
+template <class L>
+MapaPlano<typename L::Clave, std::vector<size_t>> listarPatrimonioMayor(const typename L::Almacen& a,
+                                                                        double umbral) {
+    MapaPlano<typename L::Clave, std::vector<size_t>> resultado;
+    for (size_t i = 0, n = L::tamano(a); i < n; ++i) {
+        if (L::patrimonio(a, i) > umbral) resultado.insertar(L::ciudad(a, i)).first->second.push_back(i);
+    }
+    return resultado;
+}
+
+#endif // CONSULTAS_H
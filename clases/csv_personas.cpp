@@ -0,0 +1,635 @@
+#include "csv_personas.h"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// Campos de Persona que se reconocen en el encabezado
+enum Campo { CAMPO_ID, CAMPO_NOMBRE, CAMPO_APELLIDO, CAMPO_CIUDAD, CAMPO_FECHA,
+             CAMPO_INGRESOS, CAMPO_PATRIMONIO, CAMPO_DEUDAS, CAMPO_GRUPO, NUM_CAMPOS };
+
+const char* const NOMBRES_CAMPOS[NUM_CAMPOS] = {
+    "id", "nombre", "apellido", "ciudad", "fecha_nacimiento",
+    "ingresos", "patrimonio", "deudas", "grupo"
+};
+
+double segundosActuales() {
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Primera aparición de c en [p, fin), o fin si no aparece.
+ *
+ * POR QUÉ: Encontrar el fin de línea es la operación más repetida del lector.
+ * CÓMO: Compara 16 bytes a la vez con SSE2 y toma el primer bit de la máscara.
+ * PARA QUÉ: Avanzar por el bloque sin examinar byte a byte.
+ */
+const char* buscarByte(const char* p, const char* fin, char c) {
+#ifdef __SSE2__
+    const __m128i objetivo = _mm_set1_epi8(c);
+    for (; fin - p >= 16; p += 16) {
+        __m128i bloque = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        int mascara = _mm_movemask_epi8(_mm_cmpeq_epi8(bloque, objetivo));
+        if (mascara != 0) return p + __builtin_ctz(mascara);
+    }
+#endif
+    for (; p < fin; ++p) {
+        if (*p == c) return p;
+    }
+    return fin;
+}
+
+/**
+ * Posiciones de las comas de una línea.
+ *
+ * POR QUÉ: Partir la línea campo por campo recorrería cada byte dos veces.
+ * CÓMO: Por cada 16 bytes obtiene la máscara de comas y de comillas con SSE2 y
+ *       extrae las posiciones bit a bit.
+ * PARA QUÉ: Tener todos los límites de campo en una pasada.
+ * @return Número de comas encontradas (como máximo max), o -1 si la línea tiene
+ *         comillas y debe procesarse por el camino lento.
+ */
+int buscarComas(const char* p, const char* fin, const char** comas, int max) {
+    int total = 0;
+    const char* base = p;
+#ifdef __SSE2__
+    const __m128i coma = _mm_set1_epi8(',');
+    const __m128i comilla = _mm_set1_epi8('"');
+    for (; fin - base >= 16; base += 16) {
+        __m128i bloque = _mm_loadu_si128(reinterpret_cast<const __m128i*>(base));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(bloque, comilla)) != 0) return -1;
+        unsigned mascara = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(bloque, coma)));
+        while (mascara != 0 && total < max) {
+            comas[total++] = base + __builtin_ctz(mascara);
+            mascara &= mascara - 1;
+        }
+    }
+#endif
+    for (; base < fin; ++base) {
+        if (*base == '"') return -1;
+        if (*base == ',' && total < max) comas[total++] = base;
+    }
+    return total;
+}
+
+bool leerEnteroSinSigno(std::string_view texto, uint64_t& valor) {
+    auto [fin, error] = std::from_chars(texto.data(), texto.data() + texto.size(), valor);
+    return error == std::errc() && fin == texto.data() + texto.size();
+}
+
+bool leerDecimal(std::string_view texto, double& valor) {
+    auto [fin, error] = std::from_chars(texto.data(), texto.data() + texto.size(), valor);
+    return error == std::errc() && fin == texto.data() + texto.size();
+}
+
+// Acepta DD/MM/AAAA y AAAA-MM-DD
+bool leerFecha(std::string_view texto, int32_t& fecha) {
+    int partes[3] = {0, 0, 0};
+    const char* p = texto.data();
+    const char* fin = p + texto.size();
+    char separador = 0;
+    for (int i = 0; i < 3; ++i) {
+        auto [siguiente, error] = std::from_chars(p, fin, partes[i]);
+        if (error != std::errc()) return false;
+        p = siguiente;
+        if (i < 2) {
+            if (p == fin || (*p != '/' && *p != '-') || (separador != 0 && *p != separador)) return false;
+            separador = *p++;
+        }
+    }
+    if (p != fin) return false;
+    if (separador == '-') {
+        fecha = empaquetarFecha({partes[2], partes[1], partes[0]});
+    } else {
+        fecha = empaquetarFecha({partes[0], partes[1], partes[2]});
+    }
+    return true;
+}
+
+/**
+ * Búfer de escritura con volcado por bloques.
+ *
+ * POR QUÉ: Una llamada al sistema por campo dominaría el tiempo de exportación.
+ * CÓMO: Acumula texto en 1 MB y lo escribe con write() cuando se llena.
+ * PARA QUÉ: Que el costo de la exportación sea el formateo y no la E/S.
+ */
+class EscritorBloques {
+public:
+    explicit EscritorBloques(int descriptor) : descriptor(descriptor), buffer(1 << 20) {}
+
+    void texto(std::string_view valor) {
+        if (buffer.size() - usado < valor.size()) volcar();
+        if (buffer.size() < valor.size()) buffer.resize(valor.size());
+        std::memcpy(buffer.data() + usado, valor.data(), valor.size());
+        usado += valor.size();
+    }
+
+    // Campo de texto; va entre comillas solo si contiene comas, comillas o saltos
+    void campo(std::string_view valor) {
+        if (valor.find_first_of(",\"\r\n") == std::string_view::npos) {
+            texto(valor);
+            return;
+        }
+        caracter('"');
+        for (char c : valor) {
+            if (c == '"') caracter('"');
+            caracter(c);
+        }
+        caracter('"');
+    }
+
+    void caracter(char c) {
+        if (usado == buffer.size()) volcar();
+        buffer[usado++] = c;
+    }
+
+    // Representación más corta que se vuelve a leer como el mismo double
+    template <class T>
+    void numero(T valor) {
+        if (buffer.size() - usado < 32) volcar();
+        auto resultado = std::to_chars(buffer.data() + usado, buffer.data() + buffer.size(), valor);
+        usado = resultado.ptr - buffer.data();
+    }
+
+    void dosDigitos(int valor) {
+        if (valor < 10) caracter('0');
+        numero(valor);
+    }
+
+    bool volcar() {
+        const char* p = buffer.data();
+        size_t restante = usado;
+        while (restante > 0) {
+            ssize_t escritos = ::write(descriptor, p, restante);
+            if (escritos < 0) {
+                fallo = true;
+                break;
+            }
+            p += escritos;
+            restante -= static_cast<size_t>(escritos);
+            total += static_cast<size_t>(escritos);
+        }
+        usado = 0;
+        return !fallo;
+    }
+
+    size_t bytes() const { return total; }
+    bool hayFallo() const { return fallo; }
+
+private:
+    int descriptor;
+    std::vector<char> buffer;
+    size_t usado = 0;
+    size_t total = 0;
+    bool fallo = false;
+};
+
+} // namespace
+
+LectorCsvPersonas::LectorCsvPersonas(size_t tamanoBloque) : buffer(tamanoBloque) {}
+
+LectorCsvPersonas::~LectorCsvPersonas() {
+    if (descriptor >= 0) ::close(descriptor);
+}
+
+/**
+ * Implementación de LectorCsvPersonas::rellenar.
+ *
+ * POR QUÉ: El último registro de un bloque casi nunca termina justo en su borde.
+ * CÓMO: Mueve la línea incompleta al inicio del búfer y completa el bloque con read();
+ *       si una línea no cabe en el búfer, lo duplica.
+ * PARA QUÉ: Que el analizador siempre reciba líneas completas.
+ * @return false si no se leyó nada nuevo (fin de archivo o error).
+ */
+bool LectorCsvPersonas::rellenar() {
+    if (finArchivo) return false;
+    if (inicio > 0) {
+        std::memmove(buffer.data(), buffer.data() + inicio, fin - inicio);
+        fin -= inicio;
+        inicio = 0;
+    }
+    if (fin == buffer.size()) buffer.resize(buffer.size() * 2);
+
+    ssize_t leidos;
+    do {
+        leidos = ::read(descriptor, buffer.data() + fin, buffer.size() - fin);
+    } while (leidos < 0 && errno == EINTR);
+    if (leidos < 0) {
+        error = std::string("Error de lectura: ") + std::strerror(errno);
+        return false;
+    }
+    if (leidos == 0) {
+        finArchivo = true;
+        return false;
+    }
+    fin += static_cast<size_t>(leidos);
+    totales.bytes += static_cast<size_t>(leidos);
+    return true;
+}
+
+bool LectorCsvPersonas::abrir(const std::string& archivo) {
+    descriptor = ::open(archivo.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        error = "Error al abrir archivo: " + archivo;
+        return false;
+    }
+    inicioSegundos = segundosActuales();
+
+    // Encabezado: primera línea completa
+    // (rellenar puede mover el búfer, por eso la búsqueda se repite completa)
+    const char* salto;
+    while ((salto = buscarByte(buffer.data() + inicio, buffer.data() + fin, '\n')) == buffer.data() + fin) {
+        if (!rellenar()) {
+            salto = buffer.data() + fin;
+            break;
+        }
+    }
+    if (hayError()) return false;
+    std::string_view encabezado(buffer.data() + inicio, salto - (buffer.data() + inicio));
+    inicio = salto - buffer.data() + (salto != buffer.data() + fin ? 1 : 0);
+    if (!analizador.encabezado(encabezado)) {
+        error = analizador.mensajeError();
+        return false;
+    }
+    return true;
+}
+
+bool AnalizadorCsv::encabezado(std::string_view texto) {
+    if (!texto.empty() && texto.back() == '\r') texto.remove_suffix(1);
+    numeroLinea = 1;
+    columnaCampo.clear();
+    bool presente[NUM_CAMPOS] = {};
+    size_t desde = 0;
+    while (desde <= texto.size()) {
+        size_t hasta = texto.find(',', desde);
+        if (hasta == std::string_view::npos) hasta = texto.size();
+        std::string_view nombre = texto.substr(desde, hasta - desde);
+        if (nombre.size() >= 2 && nombre.front() == '"' && nombre.back() == '"') {
+            nombre = nombre.substr(1, nombre.size() - 2);
+        }
+        int campo = -1;
+        for (int c = 0; c < NUM_CAMPOS; ++c) {
+            if (nombre == NOMBRES_CAMPOS[c] && !presente[c]) {
+                campo = c;
+                presente[c] = true;
+            }
+        }
+        columnaCampo.push_back(campo);
+        desde = hasta + 1;
+    }
+    for (int c = 0; c < NUM_CAMPOS; ++c) {
+        if (!presente[c]) {
+            error = std::string("Falta la columna ") + NOMBRES_CAMPOS[c] + " en el encabezado";
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Implementación de AnalizadorCsv::linea.
+ *
+ * POR QUÉ: Convertir cada campo sin crear cadenas intermedias.
+ * CÓMO: Camino rápido con las comas encontradas por SIMD; si la línea tiene
+ *       comillas, camino lento que quita las comillas y los "" escapados.
+ *       Los valores se validan todos antes de agregar la fila.
+ * PARA QUÉ: Que una fila inválida no deje las columnas desalineadas.
+ */
+bool AnalizadorCsv::linea(const char* p, const char* finLinea, ColumnasPersona& destino) {
+    ++numeroLinea;
+    if (finLinea > p && finLinea[-1] == '\r') --finLinea;
+    if (finLinea == p) return true;
+    const int columnas = static_cast<int>(columnaCampo.size());
+
+    // Cada texto se codifica apenas se lee, por eso basta una copia de trabajo
+    // para los campos entre comillas
+    uint64_t id = 0;
+    uint32_t nombre = 0, apellido = 0, ciudad = 0, grupo = 0;
+    int32_t fecha = 0;
+    double ingresos = 0, patrimonio = 0, deudas = 0;
+    auto convertir = [&](int campo, std::string_view valor) {
+        Diccionarios& d = *destino.diccionarios;
+        switch (campo) {
+            case CAMPO_ID: return leerEnteroSinSigno(valor, id);
+            case CAMPO_NOMBRE: nombre = d.nombres.codificar(valor); return true;
+            case CAMPO_APELLIDO: apellido = d.apellidos.codificar(valor); return true;
+            case CAMPO_CIUDAD: ciudad = d.ciudades.codificar(valor); return true;
+            case CAMPO_GRUPO: grupo = d.grupos.codificar(valor); return true;
+            case CAMPO_FECHA: return leerFecha(valor, fecha);
+            case CAMPO_INGRESOS: return leerDecimal(valor, ingresos);
+            case CAMPO_PATRIMONIO: return leerDecimal(valor, patrimonio);
+            case CAMPO_DEUDAS: return leerDecimal(valor, deudas);
+            default: return true;
+        }
+    };
+
+    const char* comas[64];
+    int encontradas = columnas <= 64 ? buscarComas(p, finLinea, comas, columnas) : -1;
+    if (encontradas >= 0) {
+        if (encontradas != columnas - 1) {
+            error = "Número de columnas incorrecto en la línea " + std::to_string(numeroLinea);
+            return false;
+        }
+        for (int c = 0; c < columnas; ++c) {
+            const char* finCampo = c < encontradas ? comas[c] : finLinea;
+            if (!convertir(columnaCampo[c], std::string_view(p, finCampo - p))) {
+                error = "Valor inválido en la línea " + std::to_string(numeroLinea) + ", columna " + std::to_string(c + 1);
+                return false;
+            }
+            p = finCampo + 1;
+        }
+    } else {
+        for (int c = 0; c < columnas; ++c) {
+            std::string_view valor;
+            if (p < finLinea && *p == '"') {
+                campoCitado.clear();
+                ++p;
+                while (true) {
+                    const char* cierre = buscarByte(p, finLinea, '"');
+                    campoCitado.append(p, cierre);
+                    if (cierre == finLinea) {
+                        error = "Comillas sin cerrar en la línea " + std::to_string(numeroLinea);
+                        return false;
+                    }
+                    p = cierre + 1;
+                    if (p < finLinea && *p == '"') {
+                        campoCitado.push_back('"');
+                        ++p;
+                    } else {
+                        break;
+                    }
+                }
+                valor = campoCitado;
+            } else {
+                const char* finCampo = buscarByte(p, finLinea, ',');
+                valor = std::string_view(p, finCampo - p);
+                p = finCampo;
+            }
+            bool ultima = c == columnas - 1;
+            if (ultima ? p != finLinea : (p == finLinea || *p != ',')) {
+                error = "Número de columnas incorrecto en la línea " + std::to_string(numeroLinea);
+                return false;
+            }
+            if (!convertir(columnaCampo[c], valor)) {
+                error = "Valor inválido en la línea " + std::to_string(numeroLinea) + ", columna " + std::to_string(c + 1);
+                return false;
+            }
+            ++p;
+        }
+    }
+
+    ColumnasPersona::CodigoCiudad codigoCiudad;
+    ColumnasPersona::CodigoGrupo codigoGrupo;
+    if (!convertirCodigo(ciudad, codigoCiudad) || !convertirCodigo(grupo, codigoGrupo)) {
+        error = "Hay más ciudades o grupos distintos de los que caben en sus columnas en la línea " +
+                std::to_string(numeroLinea);
+        return false;
+    }
+
+    destino.id.push_back(id);
+    destino.nombre.push_back(nombre);
+    destino.apellido.push_back(apellido);
+    destino.ciudad.push_back(codigoCiudad);
+    destino.grupo.push_back(codigoGrupo);
+    destino.fecha.push_back(fecha);
+    destino.ingresos.push_back(ingresos);
+    destino.patrimonio.push_back(patrimonio);
+    destino.deudas.push_back(deudas);
+    return true;
+}
+
+bool AnalizadorCsv::rango(const char* p, const char* fin, ColumnasPersona& destino) {
+    while (p < fin) {
+        const char* salto = buscarByte(p, fin, '\n');
+        if (!linea(p, salto, destino)) return false;
+        p = salto + 1;
+    }
+    return true;
+}
+
+size_t LectorCsvPersonas::leer(ColumnasPersona& destino, size_t maxFilas) {
+    if (descriptor < 0 || hayError()) return 0;
+    size_t filasPrevias = destino.tamano();
+    size_t filas = 0;
+    while (filas < maxFilas) {
+        const char* p = buffer.data() + inicio;
+        const char* limite = buffer.data() + fin;
+        const char* salto = buscarByte(p, limite, '\n');
+        if (salto == limite) {
+            if (rellenar()) continue;
+            if (hayError() || inicio == fin) break;
+            // Última línea sin salto final
+            p = buffer.data() + inicio;
+            salto = limite = buffer.data() + fin;
+        }
+        if (!analizador.linea(p, salto, destino)) {
+            error = analizador.mensajeError();
+            break;
+        }
+        filas = destino.tamano() - filasPrevias;
+        inicio = salto - buffer.data() + (salto != limite ? 1 : 0);
+    }
+    totales.filas += filas;
+    totales.segundos = segundosActuales() - inicioSegundos;
+    return hayError() ? 0 : filas;
+}
+
+EstadisticasCsv LectorCsvPersonas::estadisticas() const {
+    return totales;
+}
+
+bool importarPersonasCsv(const std::string& archivo, ColumnasPersona& destino, EstadisticasCsv& estadisticas,
+                         std::string& error) {
+    LectorCsvPersonas lector;
+    if (lector.abrir(archivo)) {
+        while (lector.leer(destino, 1 << 20) > 0) {
+        }
+    }
+    estadisticas = lector.estadisticas();
+    error = lector.mensajeError();
+    return !lector.hayError();
+}
+
+namespace {
+
+/**
+ * Traduce los códigos de un segmento a los diccionarios comunes.
+ *
+ * POR QUÉ: Cada hilo codificó los textos con sus propios diccionarios.
+ * CÓMO: Arma una tabla código local -> código común por diccionario (pocos miles
+ *       de entradas) y reescribe las columnas de códigos sobre sí mismas.
+ * PARA QUÉ: Que todos los segmentos compartan diccionarios sin copiar columnas.
+ * @return false, sin modificar la columna, si un código común no cabe en T.
+ */
+template <class T>
+bool traducirCodigos(const Diccionario& local, Diccionario& comun, std::vector<T>& columna) {
+    std::vector<T> tabla(local.tamano());
+    for (uint32_t c = 0; c < local.tamano(); ++c) {
+        // Cada segmento cabía en su columna, pero la unión de los textos puede no caber
+        if (!convertirCodigo(comun.codificar(local.valor(c)), tabla[c])) return false;
+    }
+    for (T& codigo : columna) codigo = tabla[codigo];
+    return true;
+}
+
+// Filas aproximadas de [inicio, fin) a partir de las líneas del primer mega
+size_t estimarFilas(const char* inicio, const char* fin) {
+    const char* muestraFin = inicio + std::min<size_t>(fin - inicio, 1 << 20);
+    size_t lineas = 0;
+    for (const char* p = inicio; (p = buscarByte(p, muestraFin, '\n')) != muestraFin; ++p) ++lineas;
+    if (lineas == 0) return 1;
+    return static_cast<size_t>(static_cast<double>(fin - inicio) * lineas / (muestraFin - inicio)) + 1;
+}
+
+} // namespace
+
+bool importarPersonasCsvParalelo(const std::string& archivo, unsigned hilos, SegmentosPersona& destino,
+                                 EstadisticasCsv& estadisticas, std::string& error) {
+    double inicioSegundos = segundosActuales();
+    int descriptor = ::open(archivo.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        error = "Error al abrir archivo: " + archivo;
+        return false;
+    }
+    struct stat datos;
+    if (::fstat(descriptor, &datos) != 0 || datos.st_size == 0) {
+        ::close(descriptor);
+        error = "Archivo vacío o ilegible: " + archivo;
+        return false;
+    }
+    size_t longitud = static_cast<size_t>(datos.st_size);
+    void* proyeccion = ::mmap(nullptr, longitud, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor);
+    if (proyeccion == MAP_FAILED) {
+        error = std::string("Error en mmap: ") + std::strerror(errno);
+        return false;
+    }
+    ::madvise(proyeccion, longitud, MADV_SEQUENTIAL);
+    const char* texto = static_cast<const char*>(proyeccion);
+    const char* finTexto = texto + longitud;
+
+    AnalizadorCsv plantilla;
+    const char* finEncabezado = buscarByte(texto, finTexto, '\n');
+    bool correcto = plantilla.encabezado(std::string_view(texto, finEncabezado - texto));
+    error = plantilla.mensajeError();
+    const char* cuerpo = finEncabezado == finTexto ? finTexto : finEncabezado + 1;
+
+    if (hilos == 0) hilos = std::max(1u, std::thread::hardware_concurrency());
+    // Rangos de al menos 1 MB: con menos, crear hilos cuesta más que analizar
+    hilos = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(hilos, (finTexto - cuerpo) >> 20)));
+
+    // Límites de los rangos, alineados al inicio de un registro
+    std::vector<const char*> limites{cuerpo};
+    for (unsigned h = 1; h < hilos; ++h) {
+        const char* corte = std::max(limites.back(), cuerpo + (finTexto - cuerpo) * h / hilos);
+        corte = buscarByte(corte, finTexto, '\n');
+        limites.push_back(corte == finTexto ? finTexto : corte + 1);
+    }
+    limites.push_back(finTexto);
+
+    std::vector<ColumnasPersona> segmentos(correcto ? hilos : 0);
+    std::vector<AnalizadorCsv> analizadores(segmentos.size(), plantilla);
+    std::vector<std::thread> trabajadores;
+    for (size_t h = 0; h < segmentos.size(); ++h) {
+        trabajadores.emplace_back([&, h]() {
+            segmentos[h].reservar(estimarFilas(limites[h], limites[h + 1]));
+            analizadores[h].rango(limites[h], limites[h + 1], segmentos[h]);
+        });
+    }
+    for (auto& trabajador : trabajadores) trabajador.join();
+    ::munmap(proyeccion, longitud);
+
+    for (size_t h = 0; h < segmentos.size() && correcto; ++h) {
+        if (analizadores[h].hayError()) {
+            error = analizadores[h].mensajeError() + " del bloque que inicia en el byte " +
+                    std::to_string(limites[h] - texto);
+            correcto = false;
+        }
+    }
+
+    // Diccionarios comunes: los del primer segmento más los textos nuevos de los demás
+    if (correcto) {
+        auto comunes = segmentos[0].diccionarios;
+        for (size_t h = 1; h < segmentos.size() && correcto; ++h) {
+            ColumnasPersona& segmento = segmentos[h];
+            const Diccionarios& locales = *segmento.diccionarios;
+            correcto = traducirCodigos(locales.nombres, comunes->nombres, segmento.nombre) &&
+                       traducirCodigos(locales.apellidos, comunes->apellidos, segmento.apellido) &&
+                       traducirCodigos(locales.ciudades, comunes->ciudades, segmento.ciudad) &&
+                       traducirCodigos(locales.grupos, comunes->grupos, segmento.grupo);
+            if (!correcto) error = "Hay más ciudades o grupos distintos de los que caben en sus columnas";
+            segmento.diccionarios = comunes;
+        }
+    }
+    if (correcto) {
+        for (auto& segmento : segmentos) {
+            if (segmento.tamano() > 0) destino.segmentos.push_back(std::move(segmento));
+        }
+    }
+
+    estadisticas.filas = destino.tamano();
+    estadisticas.bytes = longitud;
+    estadisticas.segundos = segundosActuales() - inicioSegundos;
+    return correcto;
+}
+
+bool exportarPersonasCsv(const std::vector<Persona>& personas, const std::string& archivo,
+                         EstadisticasCsv& estadisticas) {
+    double inicio = segundosActuales();
+    int descriptor = ::open(archivo.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (descriptor < 0) return false;
+
+    EscritorBloques salida(descriptor);
+    for (int c = 0; c < NUM_CAMPOS; ++c) {
+        if (c > 0) salida.caracter(',');
+        salida.texto(NOMBRES_CAMPOS[c]);
+    }
+    salida.caracter('\n');
+
+    for (const auto& persona : personas) {
+        auto [dia, mes, anio] = persona.getFechaNacimiento();
+        salida.texto(persona.getId());
+        salida.caracter(',');
+        salida.campo(persona.getNombre());
+        salida.caracter(',');
+        salida.campo(persona.getApellido());
+        salida.caracter(',');
+        salida.campo(persona.getCiudadNacimiento());
+        salida.caracter(',');
+        salida.dosDigitos(dia);
+        salida.caracter('/');
+        salida.dosDigitos(mes);
+        salida.caracter('/');
+        salida.numero(anio);
+        salida.caracter(',');
+        salida.numero(persona.getIngresosAnuales());
+        salida.caracter(',');
+        salida.numero(persona.getPatrimonio());
+        salida.caracter(',');
+        salida.numero(persona.getDeudas());
+        salida.caracter(',');
+        salida.campo(persona.getGrupoDeclaracion());
+        salida.caracter('\n');
+    }
+    salida.volcar();
+    bool correcto = !salida.hayFallo();
+    if (::close(descriptor) != 0) correcto = false;
+
+    estadisticas.filas = personas.size();
+    estadisticas.bytes = salida.bytes();
+    estadisticas.segundos = segundosActuales() - inicio;
+    return correcto;
+}
@@ -0,0 +1,153 @@
+#ifndef CSV_PERSONAS_H
+#define CSV_PERSONAS_H
+
+#include "persona.h"
+#include "columnas.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Métricas de una importación o exportación CSV.
+ */
+struct EstadisticasCsv {
+    size_t filas = 0;      // Registros leídos o escritos
+    size_t bytes = 0;      // Bytes leídos o escritos
+    double segundos = 0;   // Duración de la operación
+
+    double filasPorSegundo() const { return segundos > 0 ? filas / segundos : 0; }
+};
+
+/**
+ * Conversión de líneas CSV a filas de ColumnasPersona.
+ *
+ * POR QUÉ: El lector por bloques y la carga paralela interpretan las líneas igual.
+ * CÓMO: El encabezado fija qué campo de Persona hay en cada columna; cada línea
+ *       se parte con las comas encontradas por SIMD y sus campos se convierten
+ *       sin copiarlos (enteros y decimales con std::from_chars, textos al diccionario).
+ * PARA QUÉ: Que cada hilo tenga su propia copia con el mismo esquema.
+ */
+class AnalizadorCsv {
+public:
+    /**
+     * Interpreta la línea de encabezado.
+     * @return false si falta alguna columna obligatoria.
+     */
+    bool encabezado(std::string_view texto);
+
+    /**
+     * Agrega a destino la fila de [inicio, fin), sin el salto de línea.
+     * Las líneas vacías se cuentan pero no producen fila.
+     * @return false si la línea es inválida; el motivo queda en mensajeError().
+     */
+    bool linea(const char* inicio, const char* fin, ColumnasPersona& destino);
+
+    /**
+     * Agrega a destino todas las líneas de [inicio, fin).
+     * @return false si alguna línea es inválida.
+     */
+    bool rango(const char* inicio, const char* fin, ColumnasPersona& destino);
+
+    bool hayError() const { return !error.empty(); }
+    const std::string& mensajeError() const { return error; }
+
+private:
+    std::vector<int> columnaCampo;   // Campo de Persona de cada columna del archivo (-1 = ignorar)
+    std::string campoCitado;         // Copia de trabajo para campos entre comillas
+    std::string error;
+    size_t numeroLinea = 0;          // Líneas procesadas (para los mensajes de error)
+};
+
+/**
+ * Lector CSV por bloques que carga personas directamente en columnas.
+ *
+ * POR QUÉ: Leer línea a línea con getline y convertir cada campo a std::string
+ *          es demasiado lento para decenas de millones de registros.
+ * CÓMO: Lee el archivo en bloques de tamaño fijo con read(); los saltos de línea
+ *       se buscan de 16 en 16 bytes con SSE2 y AnalizadorCsv convierte cada línea.
+ *       Las columnas se identifican por el nombre en el encabezado.
+ * PARA QUÉ: Importar extractos reales en segundos con memoria acotada: el lector
+ *           solo guarda un bloque y el llamador decide cuántas filas acumular.
+ *
+ * Encabezado esperado (en cualquier orden; otras columnas se ignoran):
+ *   id,nombre,apellido,ciudad,fecha_nacimiento,ingresos,patrimonio,deudas,grupo
+ * La fecha se acepta como DD/MM/AAAA o AAAA-MM-DD. Los campos pueden ir entre
+ * comillas dobles, pero no pueden contener saltos de línea.
+ */
+class LectorCsvPersonas {
+public:
+    explicit LectorCsvPersonas(size_t tamanoBloque = 4 << 20);
+    ~LectorCsvPersonas();
+    LectorCsvPersonas(const LectorCsvPersonas&) = delete;
+    LectorCsvPersonas& operator=(const LectorCsvPersonas&) = delete;
+
+    /**
+     * Abre el archivo y procesa el encabezado.
+     * @return false si no se puede abrir o faltan columnas obligatorias.
+     */
+    bool abrir(const std::string& archivo);
+
+    /**
+     * Agrega al final de destino hasta maxFilas registros.
+     * @return Filas leídas; 0 cuando el archivo terminó o hubo un error.
+     */
+    size_t leer(ColumnasPersona& destino, size_t maxFilas);
+
+    bool hayError() const { return !error.empty(); }
+    const std::string& mensajeError() const { return error; }
+    EstadisticasCsv estadisticas() const;
+
+private:
+    bool rellenar();
+
+    int descriptor = -1;
+    std::vector<char> buffer;        // Bloque actual
+    size_t inicio = 0;               // Primer byte sin procesar
+    size_t fin = 0;                  // Fin de los datos válidos
+    bool finArchivo = false;
+    AnalizadorCsv analizador;
+    std::string error;
+    EstadisticasCsv totales;
+    double inicioSegundos = 0;
+};
+
+/**
+ * Importa un CSV completo en columnas.
+ *
+ * POR QUÉ: Caso común en el que el conjunto cabe en memoria.
+ * CÓMO: Usa LectorCsvPersonas por segmentos hasta agotar el archivo.
+ * PARA QUÉ: Cargar un extracto para consultarlo desde el menú.
+ * @return false si el archivo no se pudo leer completo; el motivo queda en error.
+ */
+bool importarPersonasCsv(const std::string& archivo, ColumnasPersona& destino, EstadisticasCsv& estadisticas,
+                         std::string& error);
+
+/**
+ * Importa un CSV en paralelo desde una proyección del archivo en memoria.
+ *
+ * POR QUÉ: Un solo hilo no alcanza para convertir decenas de millones de filas
+ *          en la ventana de carga nocturna.
+ * CÓMO: Proyecta el archivo con mmap y lo divide en un rango de bytes por hilo; cada
+ *       límite se corre hasta después del siguiente salto de línea para no partir
+ *       registros. Cada hilo llena su propio segmento con diccionarios propios y al
+ *       final los códigos se traducen, en su lugar, a los diccionarios del primero.
+ * PARA QUÉ: Cargar el archivo con todos los núcleos; los segmentos se entregan
+ *           como quedaron, sin copiarlos a un único conjunto de columnas.
+ * @param hilos Hilos a usar; 0 = los que reporte std::thread::hardware_concurrency().
+ * @return false si el archivo no se pudo leer completo; el motivo queda en error.
+ */
+bool importarPersonasCsvParalelo(const std::string& archivo, unsigned hilos, SegmentosPersona& destino,
+                                 EstadisticasCsv& estadisticas, std::string& error);
+
+/**
+ * Exporta personas a CSV con el formato que entiende LectorCsvPersonas.
+ *
+ * POR QUÉ: Guardar la población generada para reutilizarla o analizarla afuera.
+ * CÓMO: Formatea cada registro en un búfer de 1 MB que se escribe con write().
+ * PARA QUÉ: Producir archivos de prueba grandes rápidamente.
+ * @return false si el archivo no se pudo escribir.
+ */
+bool exportarPersonasCsv(const std::vector<Persona>& personas, const std::string& archivo,
+                         EstadisticasCsv& estadisticas);
+
+#endif // CSV_PERSONAS_H
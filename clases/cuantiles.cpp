@@ -0,0 +1,246 @@
+#include "cuantiles.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <utility>
+
+namespace {
+
+const double PERCENTILES[] = {0.5, 0.9, 0.99};
+const size_t MINIMO_NIVEL = 8;   // Capacidad mínima de un nivel bajo, como en la implementación de referencia
+
+void mostrarVariable(const char* nombre, const SketchKll& sketch) {
+    std::cout << "  " << nombre << ":";
+    for (double q : PERCENTILES) {
+        std::cout << " p" << static_cast<int>(q * 100) << " " << sketch.cuantil(q);
+    }
+    std::cout << "\n";
+}
+
+void mostrarPoblacion(const std::string& nombre, const CuantilesPersona& cuantiles) {
+    std::cout << nombre << " (" << cuantiles.neto.cantidad() << " personas)\n";
+    mostrarVariable("Patrimonio neto", cuantiles.neto);
+    mostrarVariable("Ingresos", cuantiles.ingresos);
+    mostrarVariable("Deudas", cuantiles.deudas);
+}
+
+} // namespace
+
+SketchKll::SketchKll(uint32_t k) : k(std::max<uint32_t>(k, 8)) {}
+
+void SketchKll::recalcularCapacidades() {
+    capacidades.resize(niveles.size());
+    capacidadTotal = 0;
+    double capacidad = k;
+    for (size_t h = niveles.size(); h-- > 0;) {
+        capacidades[h] = std::max<size_t>(MINIMO_NIVEL, static_cast<size_t>(std::ceil(capacidad)));
+        capacidadTotal += capacidades[h];
+        capacidad *= 2.0 / 3.0;
+    }
+}
+
+void SketchKll::agregar(double valor) {
+    if (n == 0) {
+        minimo = maximo = valor;
+        if (niveles.empty()) {
+            niveles.emplace_back();
+            recalcularCapacidades();
+        }
+    } else {
+        minimo = std::min(minimo, valor);
+        maximo = std::max(maximo, valor);
+    }
+    ++n;
+    niveles[0].push_back(valor);
+    if (++guardados >= capacidadTotal) compactar();
+}
+
+// Compacta el nivel más bajo que superó su capacidad hasta volver a tener espacio.
+// Mientras los niveles altos tienen espacio libre, el nivel 0 crece más allá de su
+// capacidad y se ordena en trozos grandes (la variante perezosa de KLL)
+void SketchKll::compactar() {
+    while (guardados >= capacidadTotal) {
+        size_t h = 0;
+        while (niveles[h].size() < capacidades[h]) ++h;
+        if (h + 1 == niveles.size()) {
+            niveles.emplace_back();
+            recalcularCapacidades();
+        }
+        std::vector<double>& nivel = niveles[h];
+        std::vector<double>& siguiente = niveles[h + 1];
+        std::sort(nivel.begin(), nivel.end());
+        // Con cantidad impar, el mayor se queda en el nivel para no perder su peso
+        size_t pares = nivel.size() & ~size_t(1);
+        azar ^= azar << 13;
+        azar ^= azar >> 7;
+        azar ^= azar << 17;
+        for (size_t i = azar & 1; i < pares; i += 2) siguiente.push_back(nivel[i]);
+        double sobrante = nivel.back();
+        bool impar = nivel.size() != pares;
+        nivel.clear();
+        if (impar) nivel.push_back(sobrante);
+        guardados -= pares / 2;
+    }
+}
+
+void SketchKll::combinar(const SketchKll& otro) {
+    if (otro.n == 0) return;
+    if (n == 0) {
+        minimo = otro.minimo;
+        maximo = otro.maximo;
+    } else {
+        minimo = std::min(minimo, otro.minimo);
+        maximo = std::max(maximo, otro.maximo);
+    }
+    n += otro.n;
+    if (niveles.size() < otro.niveles.size()) {
+        niveles.resize(otro.niveles.size());
+        recalcularCapacidades();
+    }
+    for (size_t h = 0; h < otro.niveles.size(); ++h) {
+        niveles[h].insert(niveles[h].end(), otro.niveles[h].begin(), otro.niveles[h].end());
+    }
+    guardados += otro.guardados;
+    compactar();
+}
+
+double SketchKll::cuantil(double q) const {
+    if (n == 0) return 0;
+    if (q <= 0) return minimo;
+    if (q >= 1) return maximo;
+    std::vector<std::pair<double, uint64_t>> pesados;   // Valor y cuántos representa
+    for (size_t h = 0; h < niveles.size(); ++h) {
+        for (double valor : niveles[h]) pesados.push_back({valor, uint64_t(1) << h});
+    }
+    std::sort(pesados.begin(), pesados.end());
+    double objetivo = q * static_cast<double>(n);
+    uint64_t acumulado = 0;
+    for (const auto& par : pesados) {
+        acumulado += par.second;
+        if (static_cast<double>(acumulado) >= objetivo) return par.first;
+    }
+    return maximo;
+}
+
+size_t SketchKll::bytes() const {
+    size_t total = sizeof(*this) + niveles.capacity() * sizeof(std::vector<double>);
+    for (const auto& nivel : niveles) total += nivel.capacity() * sizeof(double);
+    return total;
+}
+
+void CuantilesPersona::combinar(const CuantilesPersona& otro) {
+    neto.combinar(otro.neto);
+    ingresos.combinar(otro.ingresos);
+    deudas.combinar(otro.deudas);
+}
+
+namespace {
+
+// Resúmenes de un segmento indexados por código de ciudad y de grupo; como en
+// EstadoAgregado, los nombres se buscan en los mapas del estado una vez por
+// ciudad y grupo del segmento, al volcarlo
+struct ResumenSegmento {
+    std::vector<CuantilesPersona> ciudades;
+    std::vector<CuantilesPersona> grupos;
+
+    void agregar(uint32_t ciudad, uint32_t grupo, double ingresos, double patrimonio, double deudas) {
+        if (ciudad >= ciudades.size()) ciudades.resize(ciudad + 1);
+        if (grupo >= grupos.size()) grupos.resize(grupo + 1);
+        double neto = patrimonio - deudas;
+        for (CuantilesPersona* destino : {&ciudades[ciudad], &grupos[grupo]}) {
+            destino->neto.agregar(neto);
+            destino->ingresos.agregar(ingresos);
+            destino->deudas.agregar(deudas);
+        }
+    }
+
+    // El resumen del país es la combinación de los de las ciudades: una inserción menos por fila
+    void volcar(EstadoCuantiles& estado, const Diccionario& nombresCiudad, const Diccionario& nombresGrupo) {
+        for (uint32_t c = 0; c < ciudades.size(); ++c) {
+            if (ciudades[c].neto.cantidad() == 0) continue;
+            estado.filas += ciudades[c].neto.cantidad();
+            estado.pais.combinar(ciudades[c]);
+            estado.porCiudad[nombresCiudad.valor(c)].combinar(ciudades[c]);
+        }
+        for (uint32_t g = 0; g < grupos.size(); ++g) {
+            if (grupos[g].neto.cantidad() > 0) estado.porGrupo[nombresGrupo.valor(g)].combinar(grupos[g]);
+        }
+    }
+};
+
+} // namespace
+
+void EstadoCuantiles::agregar(const ColumnasPersona& segmento) {
+    ResumenSegmento resumen;
+    for (size_t i = 0; i < segmento.tamano(); ++i) {
+        resumen.agregar(segmento.ciudad[i], segmento.grupo[i], segmento.ingresos[i], segmento.patrimonio[i],
+                        segmento.deudas[i]);
+    }
+    resumen.volcar(*this, segmento.diccionarios->ciudades, segmento.diccionarios->grupos);
+}
+
+void EstadoCuantiles::agregar(const std::vector<Persona>& personas, size_t inicio, size_t fin) {
+    // Sin pasar por ColumnasPersona: solo hacen falta dos de sus diccionarios
+    Diccionario ciudades, grupos;
+    ResumenSegmento resumen;
+    for (size_t i = inicio; i < fin; ++i) {
+        const Persona& p = personas[i];
+        resumen.agregar(ciudades.codificar(p.getCiudadNacimiento()), grupos.codificar(p.getGrupoDeclaracion()),
+                        p.getIngresosAnuales(), p.getPatrimonio(), p.getDeudas());
+    }
+    resumen.volcar(*this, ciudades, grupos);
+}
+
+void EstadoCuantiles::combinar(EstadoCuantiles&& otro) {
+    filas += otro.filas;
+    pais.combinar(otro.pais);
+    for (const auto& par : otro.porCiudad) porCiudad[par.first].combinar(par.second);
+    for (const auto& par : otro.porGrupo) porGrupo[par.first].combinar(par.second);
+}
+
+size_t EstadoCuantiles::bytes() const {
+    size_t total = pais.bytes();
+    for (const auto& par : porCiudad) total += par.second.bytes();
+    for (const auto& par : porGrupo) total += par.second.bytes();
+    return total;
+}
+
+void calcularCuantiles(const std::vector<Persona>& personas, PlanificadorTareas* planificador, size_t grano,
+                       EstadoCuantiles& estado) {
+    grano = std::max<size_t>(grano, 1);
+    size_t bloques = (personas.size() + grano - 1) / grano;
+    auto resumirBloque = [&](size_t b, EstadoCuantiles& parcial) {
+        parcial.agregar(personas, b * grano, std::min(personas.size(), (b + 1) * grano));
+    };
+
+    if (!planificador) {
+        for (size_t b = 0; b < bloques; ++b) {
+            EstadoCuantiles parcial;
+            resumirBloque(b, parcial);
+            estado.combinar(std::move(parcial));
+        }
+        return;
+    }
+
+    // Por rondas, como reporteVirtual: solo unos pocos parciales por hilo viven a la vez
+    size_t porRonda = static_cast<size_t>(planificador->hilos()) * 4;
+    std::vector<EstadoCuantiles> parciales;
+    for (size_t primero = 0; primero < bloques; primero += porRonda) {
+        size_t ronda = std::min(porRonda, bloques - primero);
+        parciales.clear();
+        parciales.resize(ronda);
+        planificador->paraCada(ronda, [&](size_t k) { resumirBloque(primero + k, parciales[k]); });
+        for (auto& parcial : parciales) estado.combinar(std::move(parcial));
+    }
+}
+
+void mostrarCuantiles(const EstadoCuantiles& estado) {
+    std::cout << "\n=== PERCENTILES (" << estado.filas << " personas, sketches KLL con k = "
+              << SketchKll::kPorDefecto() << ", " << estado.bytes() / 1024 << " KB) ===\n";
+    if (estado.filas == 0) return;
+    mostrarPoblacion("País", estado.pais);
+    std::cout << "\nPor ciudad:\n";
+    for (const auto& par : estado.porCiudad) mostrarPoblacion(par.first, par.second);
+    std::cout << "\nPor grupo de declaración:\n";
+    for (const auto& par : estado.porGrupo) mostrarPoblacion(par.first, par.second);
+}
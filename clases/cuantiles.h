@@ -0,0 +1,116 @@
+#ifndef CUANTILES_H
+#define CUANTILES_H
+
+#include "persona.h"
+#include "columnas.h"
+#include "mapa_plano.h"
+#include "planificador.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Resumen combinable de una distribución para estimar percentiles (sketch KLL).
+ *
+ * POR QUÉ: La mediana o el p99 exactos de una ciudad exigen guardar y ordenar todos
+ *          sus valores: 80 MB y un ordenamiento por cada 10M de filas y variable.
+ * CÓMO: Niveles de compactadores; un valor del nivel h representa 2^h valores. La
+ *       capacidad del nivel más alto es k y cada nivel inferior tiene 2/3 de la del
+ *       siguiente (mínimo 8). Cuando el total de valores llena la suma de las
+ *       capacidades, el nivel más bajo que superó la suya se ordena y pasa uno de
+ *       cada dos valores (los pares o los impares, al azar) al nivel siguiente. Así
+ *       el resumen guarda O(k) valores con cualquier cantidad de filas y el error de
+ *       rango es de alrededor de 1.7/k. Combinar dos resúmenes junta sus niveles y
+ *       vuelve a compactar, así que el resultado no depende de cómo se repartieron
+ *       las filas más que en el azar de las compactaciones.
+ * PARA QUÉ: Percentiles calculados en una pasada, por partes y en paralelo.
+ */
+class SketchKll {
+public:
+    explicit SketchKll(uint32_t k = kPorDefecto());
+
+    /**
+     * k de los resúmenes nuevos (--quantile-k); más grande es más exacto y ocupa más.
+     */
+    static uint32_t& kPorDefecto() {
+        static uint32_t k = 200;
+        return k;
+    }
+
+    void agregar(double valor);
+    void combinar(const SketchKll& otro);
+
+    /**
+     * Valor cuyo rango estimado es q * cantidad() (q entre 0 y 1).
+     */
+    double cuantil(double q) const;
+
+    uint64_t cantidad() const { return n; }
+    size_t bytes() const;   // Memoria del resumen
+
+private:
+    void recalcularCapacidades();
+    void compactar();
+
+    uint32_t k;
+    uint64_t n = 0;
+    double minimo = 0, maximo = 0;
+    std::vector<std::vector<double>> niveles;   // niveles[h]: valores de peso 2^h
+    std::vector<size_t> capacidades;            // Capacidad de cada nivel: k en el más alto, 2/3 por nivel
+    size_t capacidadTotal = 0;
+    size_t guardados = 0;                       // Valores en todos los niveles
+    uint64_t azar = 0x9E3779B97F4A7C15ull;     // Propio y fijo: resultados reproducibles
+};
+
+/**
+ * Resúmenes de una población: patrimonio neto (patrimonio - deudas), ingresos y deudas.
+ */
+struct CuantilesPersona {
+    SketchKll neto;
+    SketchKll ingresos;
+    SketchKll deudas;
+
+    void combinar(const CuantilesPersona& otro);
+    size_t bytes() const { return neto.bytes() + ingresos.bytes() + deudas.bytes(); }
+};
+
+/**
+ * Estado parcial combinable de los percentiles por ciudad y por grupo.
+ *
+ * POR QUÉ: Igual que EstadoAgregado, debe poder calcularse por segmentos (del CSV,
+ *          de un conjunto virtual o de tareas) y combinarse después.
+ * CÓMO: agregar() recorre un segmento (de columnas o un rango del vector de
+ *       personas) con resúmenes indexados por código de ciudad y de grupo y los
+ *       combina con los de este estado por nombre; el del país es la combinación de
+ *       los de las ciudades.
+ * PARA QUÉ: Mediana, p90 y p99 de cada ciudad y grupo en una sola pasada.
+ */
+struct EstadoCuantiles {
+    size_t filas = 0;
+    CuantilesPersona pais;
+    MapaPlano<std::string, CuantilesPersona> porCiudad;
+    MapaPlano<std::string, CuantilesPersona> porGrupo;
+
+    void agregar(const ColumnasPersona& segmento);
+    void agregar(const std::vector<Persona>& personas, size_t inicio, size_t fin);
+    void combinar(EstadoCuantiles&& otro);
+    size_t bytes() const;
+};
+
+/**
+ * Calcula los percentiles de un conjunto en memoria en una pasada por bloques.
+ *
+ * CÓMO: Cada bloque de grano filas se resume en un estado parcial; con planificador los bloques se reparten con robo de trabajo. Los
+ *       parciales se combinan en orden de bloque, así el resultado es el mismo con
+ *       cualquier número de hilos.
+ * @param planificador nullptr para recorrer los bloques en el hilo que llama.
+ */
+void calcularCuantiles(const std::vector<Persona>& personas, PlanificadorTareas* planificador, size_t grano,
+                       EstadoCuantiles& estado);
+
+/**
+ * Imprime p50, p90 y p99 de cada variable para el país, cada ciudad y cada grupo.
+ */
+void mostrarCuantiles(const EstadoCuantiles& estado);
+
+#endif // CUANTILES_H
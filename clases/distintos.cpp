@@ -0,0 +1,187 @@
+#include "distintos.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <utility>
+
+namespace {
+
+// El nombre completo se identifica por el hash de sus dos partes, sin concatenarlas
+uint64_t hashNombreCompleto(uint64_t nombre, uint64_t apellido) {
+    return mezclarHash(nombre * 0x9fb21c651e98df25ULL ^ apellido);
+}
+
+void mostrarPoblacion(const std::string& nombre, const DistintosPersona& distintos) {
+    double nombres = distintos.nombresCompletos.estimar();
+    double repetidas = std::max(0.0, static_cast<double>(distintos.filas) - nombres);
+    std::cout << nombre << ": " << distintos.filas << " personas, " << std::llround(nombres)
+              << " nombres completos distintos, " << std::llround(distintos.apellidos.estimar())
+              << " pares de apellidos distintos, " << std::llround(repetidas) << " con nombre repetido\n";
+}
+
+// Estimadores de un segmento indexados por código de ciudad; el hash de cada
+// texto se calcula una vez por código
+struct ResumenSegmento {
+    std::vector<DistintosPersona> ciudades;
+
+    void agregar(uint32_t ciudad, uint64_t nombre, uint64_t apellido) {
+        if (ciudad >= ciudades.size()) ciudades.resize(ciudad + 1);
+        DistintosPersona& destino = ciudades[ciudad];
+        ++destino.filas;
+        destino.nombresCompletos.agregar(hashNombreCompleto(nombre, apellido));
+        destino.apellidos.agregar(apellido);
+    }
+
+    void volcar(EstadoDistintos& estado, const Diccionario& nombresCiudad) {
+        for (uint32_t c = 0; c < ciudades.size(); ++c) {
+            if (ciudades[c].filas == 0) continue;
+            estado.filas += ciudades[c].filas;
+            estado.pais.combinar(ciudades[c]);
+            estado.porCiudad[nombresCiudad.valor(c)].combinar(ciudades[c]);
+        }
+    }
+};
+
+// Hash de cada texto de un diccionario, en el orden de sus códigos
+std::vector<uint64_t> hashes(const Diccionario& diccionario) {
+    std::vector<uint64_t> resultado(diccionario.tamano());
+    for (uint32_t i = 0; i < resultado.size(); ++i) resultado[i] = hashTexto(diccionario.valor(i));
+    return resultado;
+}
+
+// Series del estimador de Ertl para los registros vacíos (sigma) y saturados (tau)
+double sigma(double x) {
+    if (x == 1.0) return std::numeric_limits<double>::infinity();
+    double y = 1.0, z = x, anterior;
+    do {
+        x *= x;
+        anterior = z;
+        z += x * y;
+        y += y;
+    } while (z != anterior);
+    return z;
+}
+
+double tau(double x) {
+    if (x == 0.0 || x == 1.0) return 0.0;
+    double y = 1.0, z = 1.0 - x, anterior;
+    do {
+        x = std::sqrt(x);
+        anterior = z;
+        y *= 0.5;
+        z -= (1.0 - x) * (1.0 - x) * y;
+    } while (z != anterior);
+    return z / 3.0;
+}
+
+} // namespace
+
+HyperLogLog::HyperLogLog(unsigned precision)
+    : precision(std::min(16u, std::max(4u, precision))), registros(size_t(1) << this->precision, 0) {}
+
+void HyperLogLog::agregar(uint64_t hash) {
+    size_t registro = hash >> (64 - precision);
+    uint64_t resto = hash << precision;
+    // Posición del primer 1 en los 64 - p bits restantes (64 - p + 1 si son todos 0)
+    uint8_t rango = resto == 0 ? static_cast<uint8_t>(64 - precision + 1)
+                               : static_cast<uint8_t>(__builtin_clzll(resto) + 1);
+    if (registros[registro] < rango) registros[registro] = rango;
+}
+
+void HyperLogLog::combinar(const HyperLogLog& otro) {
+    if (otro.precision != precision) return;   // Solo se combinan estimadores de la misma precisión
+    for (size_t i = 0; i < registros.size(); ++i) registros[i] = std::max(registros[i], otro.registros[i]);
+}
+
+double HyperLogLog::estimar() const {
+    // Estimador mejorado de Ertl (2017): sin sesgo en todo el rango y sin tablas empíricas
+    const unsigned q = 64 - precision;
+    const double m = static_cast<double>(registros.size());
+    std::vector<double> cantidad(q + 2, 0);   // Registros con cada valor
+    for (uint8_t registro : registros) ++cantidad[registro];
+    double z = m * tau(1.0 - cantidad[q + 1] / m);
+    for (unsigned k = q; k >= 1; --k) z = 0.5 * (z + cantidad[k]);
+    z += m * sigma(cantidad[0] / m);
+    return m * m / (2.0 * std::log(2.0) * z);
+}
+
+void DistintosPersona::combinar(const DistintosPersona& otro) {
+    filas += otro.filas;
+    nombresCompletos.combinar(otro.nombresCompletos);
+    apellidos.combinar(otro.apellidos);
+}
+
+void EstadoDistintos::agregar(const ColumnasPersona& segmento) {
+    const Diccionarios& d = *segmento.diccionarios;
+    std::vector<uint64_t> nombres = hashes(d.nombres);
+    std::vector<uint64_t> apellidos = hashes(d.apellidos);
+    ResumenSegmento resumen;
+    for (size_t i = 0; i < segmento.tamano(); ++i) {
+        resumen.agregar(segmento.ciudad[i], nombres[segmento.nombre[i]], apellidos[segmento.apellido[i]]);
+    }
+    resumen.volcar(*this, d.ciudades);
+}
+
+void EstadoDistintos::agregar(const std::vector<Persona>& personas, size_t inicio, size_t fin) {
+    Diccionario ciudades;
+    ResumenSegmento resumen;
+    for (size_t i = inicio; i < fin; ++i) {
+        const Persona& p = personas[i];
+        resumen.agregar(ciudades.codificar(p.getCiudadNacimiento()), hashTexto(p.getNombre()),
+                        hashTexto(p.getApellido()));
+    }
+    resumen.volcar(*this, ciudades);
+}
+
+void EstadoDistintos::combinar(EstadoDistintos&& otro) {
+    filas += otro.filas;
+    pais.combinar(otro.pais);
+    for (const auto& par : otro.porCiudad) porCiudad[par.first].combinar(par.second);
+}
+
+size_t EstadoDistintos::bytes() const {
+    size_t total = pais.bytes();
+    for (const auto& par : porCiudad) total += par.second.bytes();
+    return total;
+}
+
+void calcularDistintos(const std::vector<Persona>& personas, PlanificadorTareas* planificador, size_t grano,
+                       EstadoDistintos& estado) {
+    grano = std::max<size_t>(grano, 1);
+    size_t bloques = (personas.size() + grano - 1) / grano;
+    auto resumirBloque = [&](size_t b, EstadoDistintos& parcial) {
+        parcial.agregar(personas, b * grano, std::min(personas.size(), (b + 1) * grano));
+    };
+
+    if (!planificador) {
+        for (size_t b = 0; b < bloques; ++b) {
+            EstadoDistintos parcial;
+            resumirBloque(b, parcial);
+            estado.combinar(std::move(parcial));
+        }
+        return;
+    }
+
+    // Por rondas, como calcularCuantiles: solo unos pocos parciales por hilo viven a la vez
+    size_t porRonda = static_cast<size_t>(planificador->hilos()) * 4;
+    std::vector<EstadoDistintos> parciales;
+    for (size_t primero = 0; primero < bloques; primero += porRonda) {
+        size_t ronda = std::min(porRonda, bloques - primero);
+        parciales.clear();
+        parciales.resize(ronda);
+        planificador->paraCada(ronda, [&](size_t k) { resumirBloque(primero + k, parciales[k]); });
+        for (auto& parcial : parciales) estado.combinar(std::move(parcial));
+    }
+}
+
+void mostrarDistintos(const EstadoDistintos& estado) {
+    unsigned precision = HyperLogLog::precisionPorDefecto();
+    std::cout << "\n=== VALORES DISTINTOS (" << estado.filas << " personas, HyperLogLog con 2^" << precision
+              << " registros, error típico " << 104.0 / std::sqrt(std::ldexp(1.0, precision)) << "%, "
+              << estado.bytes() / 1024 << " KB) ===\n";
+    if (estado.filas == 0) return;
+    mostrarPoblacion("País", estado.pais);
+    std::cout << "\nPor ciudad:\n";
+    for (const auto& par : estado.porCiudad) mostrarPoblacion(par.first, par.second);
+}
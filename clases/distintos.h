@@ -0,0 +1,95 @@
+#ifndef DISTINTOS_H
+#define DISTINTOS_H
+
+#include "persona.h"
+#include "columnas.h"
+#include "mapa_plano.h"
+#include "planificador.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Estimador combinable del número de valores distintos (HyperLogLog).
+ *
+ * POR QUÉ: Contar nombres distintos con un unordered_set<std::string> guarda cada
+ *          nombre una vez por ciudad: la memoria crece con la población.
+ * CÓMO: 2^p registros de un byte. Los p bits altos del hash de 64 bits de un valor
+ *       eligen el registro y este guarda la mayor posición del primer 1 en los bits
+ *       restantes; un valor repetido cae siempre en el mismo registro con el mismo
+ *       número, así que no cambia nada. La estimación usa el estimador mejorado de
+ *       Ertl, que a diferencia de la media armónica original no necesita el conteo
+ *       lineal ni tablas de sesgo en los rangos pequeños. El error típico es 1.04/√(2^p).
+ *       Combinar es el máximo registro por registro: el resultado no depende del
+ *       orden ni de cómo se repartieron las filas.
+ * PARA QUÉ: Contar distintos por ciudad en una pasada paralela con memoria fija
+ *           (4 KB con p = 12).
+ */
+class HyperLogLog {
+public:
+    explicit HyperLogLog(unsigned precision = precisionPorDefecto());
+
+    /**
+     * Precisión p de los estimadores nuevos (--distinct-bits, 4 a 16).
+     */
+    static unsigned& precisionPorDefecto() {
+        static unsigned precision = 12;
+        return precision;
+    }
+
+    void agregar(uint64_t hash);
+    void combinar(const HyperLogLog& otro);
+    double estimar() const;
+    size_t bytes() const { return registros.size(); }
+
+private:
+    unsigned precision;
+    std::vector<uint8_t> registros;
+};
+
+/**
+ * Valores distintos de una población: nombres completos (nombre y apellidos) y
+ * pares de apellidos.
+ */
+struct DistintosPersona {
+    size_t filas = 0;
+    HyperLogLog nombresCompletos;
+    HyperLogLog apellidos;
+
+    void combinar(const DistintosPersona& otro);
+    size_t bytes() const { return nombresCompletos.bytes() + apellidos.bytes(); }
+};
+
+/**
+ * Estado parcial combinable de los conteos de distintos del país y de cada ciudad.
+ *
+ * CÓMO: Como EstadoCuantiles: agregar() recorre un segmento (de columnas o un rango
+ *       del vector de personas) con estimadores indexados por código de ciudad y los
+ *       combina con los de este estado por nombre; el del país es la combinación de
+ *       los de las ciudades.
+ */
+struct EstadoDistintos {
+    size_t filas = 0;
+    DistintosPersona pais;
+    MapaPlano<std::string, DistintosPersona> porCiudad;
+
+    void agregar(const ColumnasPersona& segmento);
+    void agregar(const std::vector<Persona>& personas, size_t inicio, size_t fin);
+    void combinar(EstadoDistintos&& otro);
+    size_t bytes() const;
+};
+
+/**
+ * Cuenta los distintos de un conjunto en memoria en una pasada por bloques de grano
+ * filas, en las tareas del planificador si no es nullptr.
+ */
+void calcularDistintos(const std::vector<Persona>& personas, PlanificadorTareas* planificador, size_t grano,
+                       EstadoDistintos& estado);
+
+/**
+ * Imprime, para el país y cada ciudad, las personas, los nombres completos y los
+ * apellidos distintos estimados y las filas que repiten un nombre completo.
+ */
+void mostrarDistintos(const EstadoDistintos& estado);
+
+#endif // DISTINTOS_H
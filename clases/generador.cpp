@@ -1,12 +1,15 @@
 #include "generador.h"
+#include "paginas.h"
 #include <cstdlib>   // rand(), srand()
 #include <ctime>     // time()
 #include <random>    // std::mt19937, std::uniform_real_distribution
 #include <vector>
 #include <algorithm> // std::find_if
-#include <unordered_map>
 #include <iostream>
 #include <tuple>
+#include <atomic>
+#include <cmath>
+#include <memory>
 // Bases de datos para generación realista
 
 // Nombres femeninos comunes en Colombia
@@ -34,6 +37,17 @@ const std::vector<std::string> ciudadesColombia = {
     "Manizales", "Pasto", "Neiva", "Villavicencio", "Armenia", "Sincelejo", "Valledupar", "Montería", "Popayán", "Tunja"
 };
 
+// Generador Mersenne Twister compartido por randomDouble y establecerSemilla
+static std::mt19937& motorAleatorio() {
+    static std::mt19937 generator(time(nullptr)); // Semilla basada en tiempo
+    return generator;
+}
+
+void establecerSemilla(unsigned semilla) {
+    srand(semilla);
+    motorAleatorio().seed(semilla);
+}
+
 /**
  * Implementación de generarFechaNacimiento.
  * 
@@ -55,9 +69,17 @@ std::tuple<int,int,int> generarFechaNacimiento() {
  * CÓMO: Contador estático que inicia en 1000000000 y se incrementa.
  * PARA QUÉ: Simular números de cédula.
  */
+// Siguiente cédula libre; la generación paralela reserva bloques enteros
+static std::atomic<long> contadorID{1000000000}; // Inicia en 1,000,000,000
+
 std::string generarID() {
-    static long contador = 1000000000; // Inicia en 1,000,000,000
-    return std::to_string(contador++); // Convierte a string e incrementa
+    return std::to_string(contadorID++); // Convierte a string e incrementa
+}
+
+void reservarIDsHasta(long ultima) {
+    long actual = contadorID.load();
+    while (actual <= ultima && !contadorID.compare_exchange_weak(actual, ultima + 1)) {
+    }
 }
 
 /**
@@ -68,42 +90,174 @@ std::string generarID() {
  * PARA QUÉ: Valores de ingresos, patrimonio, etc.
  */
 double randomDouble(double min, double max) {
-    static std::mt19937 generator(time(nullptr)); // Semilla basada en tiempo
     std::uniform_real_distribution<double> distribution(min, max);
-    return distribution(generator);
+    return distribution(motorAleatorio());
+}
+
+namespace {
+
+PerfilDatos perfilActual;
+std::vector<double> acumuladaCiudades;     // Zipf sobre ciudadesColombia, en su orden
+std::vector<double> acumuladaFrecuentes;   // Zipf sobre los nombres completos frecuentes
+const size_t NOMBRES_FRECUENTES = 100;
+
+// Distribución acumulada de Zipf: P(rango k) proporcional a 1 / k^s
+std::vector<double> acumuladaZipf(size_t n, double s) {
+    std::vector<double> acumulada(n);
+    double total = 0;
+    for (size_t k = 0; k < n; ++k) {
+        total += 1.0 / std::pow(static_cast<double>(k + 1), s);
+        acumulada[k] = total;
+    }
+    for (double& valor : acumulada) valor /= total;
+    return acumulada;
+}
+
+} // namespace
+
+void establecerPerfil(const PerfilDatos& perfil) {
+    perfilActual = perfil;
+    acumuladaCiudades = acumuladaZipf(ciudadesColombia.size(), perfil.zipf);
+    acumuladaFrecuentes = acumuladaZipf(NOMBRES_FRECUENTES, 1.0);
+}
+
+namespace {
+
+// Fuente de azar de la generación secuencial: rand() y el Mersenne Twister global
+struct AzarGlobal {
+    unsigned entero() { return static_cast<unsigned>(rand()); }
+    double real(double min, double max) { return randomDouble(min, max); }
+};
+
+// Fuente de azar propia de un bloque de la generación paralela
+struct AzarBloque {
+    std::mt19937 motor;
+    unsigned entero() { return static_cast<unsigned>(motor() >> 1); }
+    double real(double min, double max) { return std::uniform_real_distribution<double>(min, max)(motor); }
+};
+
+// Finalizador de splitmix64: mezcla todos los bits de la entrada
+inline uint64_t mezclar(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// Fuente de azar de una fila virtual: el sorteo k de la fila es mezclar(clave + k)
+struct AzarContador {
+    uint64_t clave;
+    uint64_t contador = 0;
+    uint64_t siguiente() { return mezclar(clave + 0x9E3779B97F4A7C15ull * ++contador); }
+    unsigned entero() { return static_cast<unsigned>(siguiente() >> 33); }
+    double real(double min, double max) {
+        return min + (max - min) * static_cast<double>(siguiente() >> 11) * (1.0 / 9007199254740992.0);
+    }
+};
+
+// Real en (0, 1]: evita log(0) y divisiones por cero
+template <class Azar>
+double unitario(Azar& azar) { return 1.0 - azar.real(0, 1); }
+
+// Normal estándar por Box-Muller: mismo resultado con cualquier biblioteca estándar
+template <class Azar>
+double normal(Azar& azar) {
+    double u1 = unitario(azar);
+    double u2 = azar.real(0, 1);
+    return std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+}
+
+template <class Azar>
+size_t rangoZipf(Azar& azar, const std::vector<double>& acumulada) {
+    auto it = std::lower_bound(acumulada.begin(), acumulada.end(), azar.real(0, 1));
+    return it == acumulada.end() ? acumulada.size() - 1 : static_cast<size_t>(it - acumulada.begin());
 }
 
 /**
- * Implementación de generarPersona.
- * 
- * POR QUÉ: Crear una persona con datos aleatorios.
- * CÓMO: Seleccionando aleatoriamente de las bases de datos y generando números.
- * PARA QUÉ: Generar datos de prueba.
+ * Crea una persona del perfil sesgado (ver PerfilDatos).
+ *
+ * Los montos salen de distribuciones de cola pesada: ingreso log-normal con mediana
+ * de 30M COP; patrimonio igual al ingreso por un factor de Pareto (alfa 1.16, la
+ * regla 80/20), así el listado de más de 1.000 millones conserva un tamaño realista;
+ * deudas como una fracción logística-normal del patrimonio más un año de ingreso.
+ */
+template <class Azar>
+Persona crearPersonaSesgada(Azar& azar, const std::string& id, std::pmr::memory_resource* recurso) {
+    bool esHombre = azar.entero() % 2;
+    const std::string* nombre;
+    thread_local std::string apellido;
+    if (azar.real(0, 1) < perfilActual.duplicados) {
+        // Nombre completo frecuente: el rango fija nombre y apellidos, así que se repite exacto
+        size_t rango = rangoZipf(azar, acumuladaFrecuentes);
+        esHombre = rango % 2;
+        nombre = esHombre ? &nombresMasculinos[rango % nombresMasculinos.size()]
+                          : &nombresFemeninos[rango % nombresFemeninos.size()];
+        apellido = apellidos[rango % apellidos.size()];
+        apellido += " ";
+        apellido += apellidos[(rango * 7 + 3) % apellidos.size()];
+    } else {
+        nombre = esHombre ? &nombresMasculinos[azar.entero() % nombresMasculinos.size()]
+                          : &nombresFemeninos[azar.entero() % nombresFemeninos.size()];
+        apellido = apellidos[azar.entero() % apellidos.size()];
+        apellido += " ";
+        apellido += apellidos[azar.entero() % apellidos.size()];
+    }
+
+    const std::string& ciudad = ciudadesColombia[rangoZipf(azar, acumuladaCiudades)];
+    int dia = 1 + azar.entero() % 28;
+    int mes = 1 + azar.entero() % 12;
+    int anio = 1960 + azar.entero() % 50;
+    std::tuple<int,int,int> fecha = {dia, mes, anio};
+
+    double ingresos = 30000000.0 * std::exp(0.8 * normal(azar));
+    double patrimonio = ingresos * 0.5 / std::pow(unitario(azar), 1.0 / 1.16);
+    double apalancamiento = 1.0 / (1.0 + std::exp(-(normal(azar) - 1.0)));   // Media cercana a 0.3
+    double deudas = apalancamiento * (0.6 * patrimonio + ingresos);
+
+    int ultimos = std::stoi(id.substr(id.length() - 2));
+    const char* grupo = ultimos < 40 ? "A" : (ultimos < 80 ? "B" : "C");
+    return Persona(*nombre, apellido, id, ciudad, fecha, ingresos, patrimonio, deudas, grupo, recurso);
+}
+
+/**
+ * Crea una persona con la fuente de azar indicada.
+ *
+ * POR QUÉ: La generación secuencial y la paralela deben producir la misma
+ *          distribución; solo cambia de dónde salen los números aleatorios.
+ * CÓMO: Mismo orden de sorteos que la versión original de generarPersona.
+ * PARA QUÉ: Que --seed siga dando los mismos datos en la generación secuencial.
  */
-Persona generarPersona() {
+template <class Azar>
+Persona crearPersona(Azar& azar, const std::string& id, std::pmr::memory_resource* recurso) {
+    if (perfilActual.sesgado) return crearPersonaSesgada(azar, id, recurso);
+    
     // Decide si es hombre o mujer
-    bool esHombre = rand() % 2;
+    bool esHombre = azar.entero() % 2;
     
-    // Selecciona nombre según género
-    std::string nombre = esHombre ? 
-        nombresMasculinos[rand() % nombresMasculinos.size()] :
-        nombresFemeninos[rand() % nombresFemeninos.size()];
+    // Selecciona nombre según género (referencia a la base, sin copiar)
+    const std::string& nombre = esHombre ? 
+        nombresMasculinos[azar.entero() % nombresMasculinos.size()] :
+        nombresFemeninos[azar.entero() % nombresFemeninos.size()];
     
-    // Construye apellido compuesto (dos apellidos aleatorios)
-    std::string apellido = apellidos[rand() % apellidos.size()];
+    // Construye apellido compuesto (dos apellidos aleatorios) en un búfer reutilizado;
+    // la única copia definitiva se hace en el recurso de la persona
+    thread_local std::string apellido;
+    apellido = apellidos[azar.entero() % apellidos.size()];
     apellido += " ";
-    apellido += apellidos[rand() % apellidos.size()];
+    apellido += apellidos[azar.entero() % apellidos.size()];
     
     // Genera los demás atributos
-    std::string id = generarID();
-    std::string ciudad = ciudadesColombia[rand() % ciudadesColombia.size()];
-    std::tuple<int,int,int> fecha = generarFechaNacimiento();
+    const std::string& ciudad = ciudadesColombia[azar.entero() % ciudadesColombia.size()];
+    int dia = 1 + azar.entero() % 28;       // Día: 1 a 28 (evita problemas con meses)
+    int mes = 1 + azar.entero() % 12;       // Mes: 1 a 12
+    int anio = 1960 + azar.entero() % 50;   // Año: 1960 a 2009
+    std::tuple<int,int,int> fecha = {dia, mes, anio};
     
     // Genera datos financieros realistas
-    double ingresos = randomDouble(10000000, 500000000);   // 10M a 500M COP
-    double patrimonio = randomDouble(0, 2000000000);       // 0 a 2,000M COP
-    double deudas = randomDouble(0, patrimonio * 0.7);     // Deudas hasta el 70% del patrimonio
-    std::string grupo;
+    double ingresos = azar.real(10000000, 500000000);   // 10M a 500M COP
+    double patrimonio = azar.real(0, 2000000000);       // 0 a 2,000M COP
+    double deudas = azar.real(0, patrimonio * 0.7);     // Deudas hasta el 70% del patrimonio
+    const char* grupo = "";
     int lastDigits = std::stoi(id.substr(id.length()-2));
     if(lastDigits < 40 ){
         grupo = "A";
@@ -117,9 +271,21 @@ Persona generarPersona() {
         grupo = "C";
     }
     
-    
-    
-    return Persona(nombre, apellido, id, ciudad, fecha, ingresos, patrimonio, deudas, grupo);
+    return Persona(nombre, apellido, id, ciudad, fecha, ingresos, patrimonio, deudas, grupo, recurso);
+}
+
+} // namespace
+
+/**
+ * Implementación de generarPersona.
+ * 
+ * POR QUÉ: Crear una persona con datos aleatorios.
+ * CÓMO: Seleccionando aleatoriamente de las bases de datos y generando números.
+ * PARA QUÉ: Generar datos de prueba.
+ */
+Persona generarPersona(std::pmr::memory_resource* recurso) {
+    AzarGlobal azar;
+    return crearPersona(azar, generarID(), recurso);
 }
 
 /**
@@ -129,17 +295,57 @@ Persona generarPersona() {
  * CÓMO: Reservando espacio y agregando n personas generadas.
  * PARA QUÉ: Crear datasets para pruebas.
  */
-std::vector<Persona> generarColeccion(int n) {
+std::vector<Persona> generarColeccion(int n, std::pmr::memory_resource* recurso) {
     std::vector<Persona> personas;
     personas.reserve(n); // Reserva espacio para n personas (eficiencia)
     
     for (int i = 0; i < n; ++i) {
-        personas.push_back(generarPersona());
+        personas.push_back(generarPersona(recurso));
     }
     
     return personas;
 }
 
+Persona generarPersonaVirtual(uint64_t semilla, uint64_t i, std::pmr::memory_resource* recurso) {
+    AzarContador azar{mezclar(mezclar(semilla) + i)};
+    return crearPersona(azar, std::to_string(1000000000ull + i), recurso);
+}
+
+std::vector<Persona> generarColeccionParalela(int n, PlanificadorTareas& planificador, size_t grano,
+                                              std::vector<std::unique_ptr<ArenaDatos>>& arenas) {
+    grano = std::max<size_t>(grano, 1);
+    size_t total = n > 0 ? static_cast<size_t>(n) : 0;
+    size_t bloques = (total + grano - 1) / grano;
+    // La semilla sale del motor global, así --seed también fija esta generación
+    unsigned semilla = motorAleatorio()();
+    long primerID = contadorID.fetch_add(static_cast<long>(total));
+
+    arenas.clear();
+    for (unsigned h = 0; h < planificador.hilos(); ++h) arenas.push_back(nuevaArenaDatos());
+    std::vector<std::vector<Persona>> partes(bloques);
+    planificador.paraCada(bloques, [&](size_t b) {
+        size_t inicio = b * grano;
+        size_t fin = std::min(total, inicio + grano);
+        std::seed_seq semillas{semilla, static_cast<unsigned>(b), static_cast<unsigned>(b >> 32)};
+        AzarBloque azar{std::mt19937(semillas)};
+        std::pmr::memory_resource* recurso = arenas[PlanificadorTareas::hiloActual()].get();
+        std::vector<Persona>& parte = partes[b];
+        parte.reserve(fin - inicio);
+        for (size_t i = inicio; i < fin; ++i) {
+            parte.push_back(crearPersona(azar, std::to_string(primerID + static_cast<long>(i)), recurso));
+        }
+    });
+
+    // Mover conserva el recurso de cada texto, así que unir las partes no copia textos
+    std::vector<Persona> personas;
+    personas.reserve(total);
+    for (auto& parte : partes) {
+        for (auto& persona : parte) personas.push_back(std::move(persona));
+        std::vector<Persona>().swap(parte);
+    }
+    return personas;
+}
+
 Persona buscarLongevaPaisValor(std::vector<Persona> personas){
     Persona personaLongeva = personas[0];
     for(const auto &persona : personas){
@@ -178,55 +384,48 @@ const Persona* buscarLongevaPaisReferencia(const std::vector<Persona> &personas)
     return personaLongeva;
 }
 
-std::unordered_map<std::string,const Persona*> mostrarPersonasLongevasCiudadReferencia(const std::vector<Persona> &personas){
-    std::unordered_map<std::string,const Persona*> personaLongevaCiudad;
+MapaAgrupado<const Persona*> mostrarPersonasLongevasCiudadReferencia(const std::vector<Persona> &personas, std::pmr::memory_resource* recurso){
+    MapaAgrupado<const Persona*> personaLongevaCiudad(recurso);
     
     for(const auto &persona : personas){
-        auto [diaP,mesP,anioP] =  persona.getFechaNacimiento();
-        //revisa si ya existe una llave para la ciudad evaluada
-        if(personaLongevaCiudad.count(persona.getCiudadNacimiento()) == 0){
-            personaLongevaCiudad[persona.getCiudadNacimiento()] = &persona;
-        }
-        else
-        {
-            auto [diaPL,mesPL,anioPL] =  personaLongevaCiudad[persona.getCiudadNacimiento()]->getFechaNacimiento();
+        // Una sola búsqueda por fila: si la ciudad es nueva queda insertada con esta persona
+        auto [entrada, nueva] = personaLongevaCiudad.insertar(persona.getCiudadVista(), &persona);
+        if(!nueva){
+            auto [diaP,mesP,anioP] =  persona.getFechaNacimiento();
+            auto [diaPL,mesPL,anioPL] =  entrada->second->getFechaNacimiento();
             if(anioP!=anioPL){
-                personaLongevaCiudad[persona.getCiudadNacimiento()] = anioP < anioPL ? &persona : personaLongevaCiudad[persona.getCiudadNacimiento()]; 
+                entrada->second = anioP < anioPL ? &persona : entrada->second; 
             }
             else if (mesP!=mesPL)
             {
-                personaLongevaCiudad[persona.getCiudadNacimiento()] = mesP < mesPL ? &persona : personaLongevaCiudad[persona.getCiudadNacimiento()];
+                entrada->second = mesP < mesPL ? &persona : entrada->second;
             }
             else{
-                personaLongevaCiudad[persona.getCiudadNacimiento()] = diaP < diaPL ? &persona : personaLongevaCiudad[persona.getCiudadNacimiento()];
+                entrada->second = diaP < diaPL ? &persona : entrada->second;
             }
         }
         
     }
     return personaLongevaCiudad;
 }
-std::unordered_map<std::string,Persona> mostrarPersonasLongevasCiudadValor(const std::vector<Persona> personas){
-    //arreglar no constructor default
-    std::unordered_map<std::string,Persona> personaLongevaCiudad;
+MapaAgrupado<Persona> mostrarPersonasLongevasCiudadValor(const std::vector<Persona> personas){
+    MapaAgrupado<Persona> personaLongevaCiudad;
     
     for(const auto &persona : personas){
-        auto [diaP,mesP,anioP] =  persona.getFechaNacimiento();
-        //revisa si ya existe una llave para la ciudad evaluada
-        if(personaLongevaCiudad.count(persona.getCiudadNacimiento()) == 0){
-            personaLongevaCiudad.emplace(persona.getCiudadNacimiento(),persona);
-        }
-        else
-        {
-            auto [diaPL,mesPL,anioPL] =  personaLongevaCiudad[persona.getCiudadNacimiento()].getFechaNacimiento();
+        // Una sola búsqueda por fila: si la ciudad es nueva queda insertada con esta persona
+        auto [entrada, nueva] = personaLongevaCiudad.insertar(persona.getCiudadVista(), persona);
+        if(!nueva){
+            auto [diaP,mesP,anioP] =  persona.getFechaNacimiento();
+            auto [diaPL,mesPL,anioPL] =  entrada->second.getFechaNacimiento();
             if(anioP!=anioPL){
-                personaLongevaCiudad[persona.getCiudadNacimiento()] = anioP < anioPL ? persona : personaLongevaCiudad[persona.getCiudadNacimiento()]; 
+                entrada->second = anioP < anioPL ? persona : entrada->second; 
             }
             else if (mesP!=mesPL)
             {
-                personaLongevaCiudad[persona.getCiudadNacimiento()] = mesP < mesPL ? persona : personaLongevaCiudad[persona.getCiudadNacimiento()];
+                entrada->second = mesP < mesPL ? persona : entrada->second;
             }
             else{
-                personaLongevaCiudad[persona.getCiudadNacimiento()] = diaP < diaPL ? persona : personaLongevaCiudad[persona.getCiudadNacimiento()];
+                entrada->second = diaP < diaPL ? persona : entrada->second;
             }
         }
         
@@ -256,85 +455,77 @@ const Persona buscarMayorPatrimonioPaisValor(const std::vector<Persona> personas
     }
     return personaRica;
 }
-std::unordered_map<std::string,const Persona*> buscarMayorPatrimonioCiudadReferencia(const std::vector<Persona> &personas){
-    std::unordered_map<std::string,const Persona*> personaRicaCiudad;
+MapaAgrupado<const Persona*> buscarMayorPatrimonioCiudadReferencia(const std::vector<Persona> &personas, std::pmr::memory_resource* recurso){
+    MapaAgrupado<const Persona*> personaRicaCiudad(recurso);
     for(const auto &persona : personas){
-        if(personaRicaCiudad.count(persona.getCiudadNacimiento())==0){
-            personaRicaCiudad[persona.getCiudadNacimiento()] = &persona; 
-        }
-        else{
-            const Persona* personaRica = personaRicaCiudad[persona.getCiudadNacimiento()];
+        auto [entrada, nueva] = personaRicaCiudad.insertar(persona.getCiudadVista(), &persona);
+        if(!nueva){
+            const Persona* personaRica = entrada->second;
             double patrimonioNetoPR = personaRica->getPatrimonio() - personaRica->getDeudas();
             double patrimonioNetoP = persona.getPatrimonio() - persona.getDeudas(); 
             if(patrimonioNetoPR<patrimonioNetoP){
-                personaRicaCiudad[persona.getCiudadNacimiento()] = &persona;
+                entrada->second = &persona;
             }
         }
     }
     return personaRicaCiudad;
 }
-std::unordered_map<std::string,Persona> buscarMayorPatrimonioCiudadValor(const std::vector<Persona> personas){
-    std::unordered_map<std::string,Persona> personaRicaCiudad;
+MapaAgrupado<Persona> buscarMayorPatrimonioCiudadValor(const std::vector<Persona> personas){
+    MapaAgrupado<Persona> personaRicaCiudad;
     for(const auto &persona : personas){
-        if(personaRicaCiudad.count(persona.getCiudadNacimiento())==0){
-            personaRicaCiudad[persona.getCiudadNacimiento()] = persona; 
-        }
-        else{
-            Persona personaRica = personaRicaCiudad[persona.getCiudadNacimiento()];
+        auto [entrada, nueva] = personaRicaCiudad.insertar(persona.getCiudadVista(), persona);
+        if(!nueva){
+            const Persona& personaRica = entrada->second;
             double patrimonioNetoPR = personaRica.getPatrimonio() - personaRica.getDeudas();
             double patrimonioNetoP = persona.getPatrimonio() - persona.getDeudas(); 
             if(patrimonioNetoPR<patrimonioNetoP){
-                personaRicaCiudad[persona.getCiudadNacimiento()] = persona;
+                entrada->second = persona;
             }
         }
     }
     return personaRicaCiudad;
 }
-std::unordered_map<std::string,const Persona*> buscarMayorPatrimonioGrupoReferencia(const std::vector<Persona> &personas){
-    std::unordered_map<std::string,const Persona*> personaRicaGrupo;
+MapaAgrupado<const Persona*> buscarMayorPatrimonioGrupoReferencia(const std::vector<Persona> &personas, std::pmr::memory_resource* recurso){
+    MapaAgrupado<const Persona*> personaRicaGrupo(recurso);
     for(const auto &persona : personas){
-        if(personaRicaGrupo.count(persona.getGrupoDeclaracion())==0){
-            personaRicaGrupo[persona.getGrupoDeclaracion()] = &persona; 
-        }
-        else{
-            const Persona* personaRica = personaRicaGrupo[persona.getGrupoDeclaracion()];
+        auto [entrada, nueva] = personaRicaGrupo.insertar(persona.getGrupoVista(), &persona);
+        if(!nueva){
+            const Persona* personaRica = entrada->second;
             double patrimonioNetoPR = personaRica->getPatrimonio() - personaRica->getDeudas();
             double patrimonioNetoP = persona.getPatrimonio() - persona.getDeudas(); 
             if(patrimonioNetoPR<patrimonioNetoP){
-                personaRicaGrupo[persona.getGrupoDeclaracion()] = &persona;
+                entrada->second = &persona;
             }
         }
     }
     return personaRicaGrupo;
 }
-std::unordered_map<std::string,Persona> buscarMayorPatrimonioGrupoValor(const std::vector<Persona> personas){
-    std::unordered_map<std::string,Persona> personaRicaGrupo;
+MapaAgrupado<Persona> buscarMayorPatrimonioGrupoValor(const std::vector<Persona> personas){
+    MapaAgrupado<Persona> personaRicaGrupo;
     for(const auto &persona : personas){
-        if(personaRicaGrupo.count(persona.getGrupoDeclaracion())==0){
-            personaRicaGrupo[persona.getGrupoDeclaracion()] = persona; 
-        }
-        else{
-            Persona personaRica = personaRicaGrupo[persona.getGrupoDeclaracion()];
+        auto [entrada, nueva] = personaRicaGrupo.insertar(persona.getGrupoVista(), persona);
+        if(!nueva){
+            const Persona& personaRica = entrada->second;
             double patrimonioNetoPR = personaRica.getPatrimonio() - personaRica.getDeudas();
             double patrimonioNetoP = persona.getPatrimonio() - persona.getDeudas(); 
             if(patrimonioNetoPR<patrimonioNetoP){
-                personaRicaGrupo[persona.getGrupoDeclaracion()] = persona;
+                entrada->second = persona;
             }
         }
     }
     return personaRicaGrupo;
 }
-const std::unordered_map<std::string,std::vector<const Persona*>> listarPersonasGrupoReferencia(const std::vector<Persona> &personas){
-    std::unordered_map<std::string,std::vector<const Persona*>> personasPorGrupo;
+MapaAgrupado<ListaPersonas> listarPersonasGrupoReferencia(const std::vector<Persona> &personas, std::pmr::memory_resource* recurso){
+    MapaAgrupado<ListaPersonas> personasPorGrupo(recurso);
     for(const auto &persona : personas){
-         personasPorGrupo[persona.getGrupoDeclaracion()].push_back(&persona);
+         personasPorGrupo[persona.getGrupoVista()].push_back(&persona);
     }
     return personasPorGrupo;
 }
-std::unordered_map<std::string,std::vector<Persona>> listarPersonasGrupoValor(std::vector<Persona> personas){
-    std::unordered_map<std::string,std::vector<Persona>> personasPorGrupo;
+MapaAgrupado<std::vector<Persona>> listarPersonasGrupoValor(std::vector<Persona> personas){
+    MapaAgrupado<std::vector<Persona>> personasPorGrupo;
     for(const auto &persona : personas){
-         personasPorGrupo[persona.getGrupoDeclaracion()].push_back(persona);
+         personasPorGrupo[persona.getGrupoVista()].push_back(persona);
     }
     return personasPorGrupo;
 }
@@ -357,17 +548,12 @@ Persona buscarMayorDeudaPaisValor(std::vector<Persona> personas){
     return personaEndeudada;
 }
 
-const std::pair<std::string,long double> buscarCiudadMayorPatrimonioReferencia(const std::vector<Persona> &personas){
+const std::pair<std::string,long double> buscarCiudadMayorPatrimonioReferencia(const std::vector<Persona> &personas, std::pmr::memory_resource* recurso){
     std::pair<std::string,long double> ciudadRica = {"",0};
-    std::unordered_map<std::string,long double> ciudadesPatrimonio;
+    MapaAgrupado<long double> ciudadesPatrimonio(recurso);
     for(const auto& persona:personas){
-        if (ciudadesPatrimonio.count(persona.getCiudadNacimiento())==0)
-        {
-            ciudadesPatrimonio[persona.getCiudadNacimiento()] = persona.getPatrimonio();
-        }
-        else{
-            ciudadesPatrimonio[persona.getCiudadNacimiento()] += persona.getPatrimonio();
-        }
+        // El total de una ciudad nueva arranca en 0; una sola búsqueda por fila
+        ciudadesPatrimonio.insertar(persona.getCiudadVista(), 0.0L).first->second += persona.getPatrimonio();
     }
     for(auto const &pair:ciudadesPatrimonio){
         if(pair.second > ciudadRica.second){
@@ -381,15 +567,10 @@ const std::pair<std::string,long double> buscarCiudadMayorPatrimonioReferencia(c
 }
 const std::pair<std::string,long double> buscarCiudadMayorPatrimonioValor(const std::vector<Persona> personas){
     std::pair<std::string,long double> ciudadRica = {"",0};
-    std::unordered_map<std::string,long double> ciudadesPatrimonio;
+    MapaAgrupado<long double> ciudadesPatrimonio;
     for(const auto& persona:personas){
-        if (ciudadesPatrimonio.count(persona.getCiudadNacimiento())==0)
-        {
-            ciudadesPatrimonio[persona.getCiudadNacimiento()] = persona.getPatrimonio();
-        }
-        else{
-            ciudadesPatrimonio[persona.getCiudadNacimiento()] += persona.getPatrimonio();
-        }
+        // El total de una ciudad nueva arranca en 0; una sola búsqueda por fila
+        ciudadesPatrimonio.insertar(persona.getCiudadVista(), 0.0L).first->second += persona.getPatrimonio();
     }
     for(auto const &pair:ciudadesPatrimonio){
         if(pair.second > ciudadRica.second){
@@ -400,23 +581,23 @@ const std::pair<std::string,long double> buscarCiudadMayorPatrimonioValor(const
     return ciudadRica;
 }
 
-std::unordered_map<std::string,std::vector<const Persona*>> listarPersonasConPatrimonioMayor1000Referencia(const std::vector<Persona> &personas){
-    std::unordered_map<std::string,std::vector<const Persona*>> personaRica;
+MapaAgrupado<ListaPersonas> listarPersonasConPatrimonioMayor1000Referencia(const std::vector<Persona> &personas, std::pmr::memory_resource* recurso){
+    MapaAgrupado<ListaPersonas> personaRica(recurso);
     long long umbral = 1'000'000'000LL;
     for(const auto &persona : personas){
         if (persona.getPatrimonio() > umbral) {
-            personaRica[persona.getCiudadNacimiento()].push_back(&persona);
+            personaRica[persona.getCiudadVista()].push_back(&persona);
         }
     }
     return personaRica;
 }
 
-std::unordered_map<std::string,std::vector<Persona>> listarPersonasConPatrimonioMayor1000Valor(std::vector<Persona> personas){
-    std::unordered_map<std::string,std::vector<Persona>> personaRica;
+MapaAgrupado<std::vector<Persona>> listarPersonasConPatrimonioMayor1000Valor(std::vector<Persona> personas){
+    MapaAgrupado<std::vector<Persona>> personaRica;
     long long umbral = 1'000'000'000LL;
     for(const auto &persona : personas){
         if (persona.getPatrimonio() > umbral) {
-            personaRica[persona.getCiudadNacimiento()].push_back(persona);
+            personaRica[persona.getCiudadVista()].push_back(persona);
         }
     }
     return personaRica;
@@ -2,11 +2,63 @@
 #define GENERADOR_H
 
 #include "persona.h"
+#include "mapa_plano.h"
+#include "arena.h"
+#include "planificador.h"
+#include <cstdint>
+#include <memory>
 #include <vector>
-#include <unordered_map>
+#include <memory_resource>
+
+/**
+ * Resultado agrupado por texto (ciudad o grupo) de las consultas.
+ * 
+ * POR QUÉ: Cada llave y cada vector de resultados reservaban memoria en el heap.
+ * CÓMO: Tabla plana (mapa_plano.h) y listas std::pmr que reservan en el recurso
+ *       recibido por la consulta.
+ * PARA QUÉ: Una búsqueda por fila y resultados construidos en una ArenaConsulta
+ *           que se reinicia al terminar.
+ */
+template <class V>
+using MapaAgrupado = MapaPlano<std::string, V>;
+using ListaPersonas = std::pmr::vector<const Persona*>;
 
 // Funciones para generación de datos aleatorios
 
+/**
+ * Fija la semilla de todos los generadores aleatorios.
+ * 
+ * POR QUÉ: Comparar ejecuciones exige generar exactamente los mismos datos.
+ * CÓMO: Reinicia rand() y el Mersenne Twister de randomDouble con la misma semilla.
+ * PARA QUÉ: Mediciones reproducibles con --seed.
+ */
+void establecerSemilla(unsigned semilla);
+
+/**
+ * Distribuciones con las que se generan las personas.
+ *
+ * Uniforme es la generación original (ciudades, nombres y montos equiprobables) y
+ * conserva sus sorteos, así que --seed sigue dando los mismos datos. Sesgado imita
+ * la población de contribuyentes: ciudades con tamaños Zipf (Bogotá la más grande),
+ * ingresos log-normales, patrimonio con cola de Pareto proporcional al ingreso,
+ * deudas correlacionadas con ambos y una fracción de nombres completos repetidos.
+ */
+struct PerfilDatos {
+    bool sesgado = false;
+    double zipf = 1.1;          // Exponente de Zipf de las ciudades (0 = uniforme)
+    double duplicados = 0.05;   // Fracción de personas con uno de los 100 nombres completos frecuentes
+};
+
+/**
+ * Fija el perfil de la generación; debe llamarse antes de generar.
+ * 
+ * POR QUÉ: Con datos uniformes las tablas hash, los predictores de saltos y el
+ *          reparto entre hilos se comportan mejor que con los datos reales.
+ * CÓMO: Precalcula las distribuciones acumuladas de Zipf que usa crearPersona.
+ * PARA QUÉ: Que las mediciones corran sobre distribuciones parecidas a producción.
+ */
+void establecerPerfil(const PerfilDatos& perfil);
+
 /**
  * Genera una fecha de nacimiento aleatoria entre 1960 y 2010.
  * 
@@ -25,6 +77,14 @@ std::tuple<int,int,int> generarFechaNacimiento();
  */
 std::string generarID();
 
+/**
+ * Hace que las cédulas generadas desde ahora sean mayores que ultima.
+ *
+ * Las personas importadas traen sus propias cédulas; sin esto, las altas
+ * posteriores repetirían las del inicio del contador.
+ */
+void reservarIDsHasta(long ultima);
+
 /**
  * Genera un número decimal aleatorio en un rango [min, max].
  * 
@@ -40,8 +100,9 @@ double randomDouble(double min, double max);
  * POR QUÉ: Automatizar la creación de registros de personas.
  * CÓMO: Combinando las funciones generadoras y bases de datos de nombres, apellidos, etc.
  * PARA QUÉ: Poblar el sistema con datos de prueba.
+ * @param recurso Recurso donde se guardan los textos de la persona (p. ej. una ArenaDatos).
  */
-Persona generarPersona();
+Persona generarPersona(std::pmr::memory_resource* recurso = std::pmr::get_default_resource());
 
 /**
  * Genera una colección (vector) de n personas.
@@ -49,8 +110,39 @@ Persona generarPersona();
  * POR QUÉ: Crear conjuntos de datos de diferentes tamaños.
  * CÓMO: Llamando a generarPersona() n veces.
  * PARA QUÉ: Pruebas de rendimiento y funcionalidad con volúmenes variables.
+ * @param recurso Recurso para los textos; debe vivir más que el vector devuelto.
+ */
+std::vector<Persona> generarColeccion(int n, std::pmr::memory_resource* recurso = std::pmr::get_default_resource());
+
+/**
+ * Genera n personas repartiendo bloques de filas entre los hilos del planificador.
+ * 
+ * POR QUÉ: Generar decenas de millones de personas en un solo hilo domina el
+ *          tiempo de cada experimento.
+ * CÓMO: Cada bloque de grano filas tiene su propio Mersenne Twister sembrado con
+ *       (semilla, bloque) y su rango de cédulas, así el resultado depende de la
+ *       semilla y del grano pero no de qué hilo genera cada bloque ni de cuántos hay;
+ *       los textos van a una arena por hilo.
+ *       La semilla sale del motor global, por lo que --seed la fija, pero los datos
+ *       no coinciden con los de generarColeccion para la misma semilla.
+ * PARA QUÉ: Cargas de prueba rápidas y reproducibles en máquinas de muchos núcleos.
+ * @param arenas Recibe las arenas de los textos; deben vivir más que el vector devuelto.
+ */
+std::vector<Persona> generarColeccionParalela(int n, PlanificadorTareas& planificador, size_t grano,
+                                              std::vector<std::unique_ptr<ArenaDatos>>& arenas);
+
+/**
+ * Genera la persona i de un conjunto virtual.
+ * 
+ * POR QUÉ: Para probar con miles de millones de filas no hace falta guardarlas.
+ * CÓMO: Un generador basado en contador: cada número aleatorio es un hash
+ *       (splitmix64) de (semilla, i, número de sorteo), así la fila i no depende de
+ *       las demás ni del orden en que se generan. Usa el perfil de establecerPerfil
+ *       y la cédula 1000000000 + i.
+ * PARA QUÉ: Recalcular cualquier fila a pedido (ver conjunto_virtual.h).
  */
-std::vector<Persona> generarColeccion(int n);
+Persona generarPersonaVirtual(uint64_t semilla, uint64_t i,
+                              std::pmr::memory_resource* recurso = std::pmr::get_default_resource());
 
 /**
  * Busca una persona por ID en un vector de personas.
@@ -67,36 +159,36 @@ Persona buscarLongevaPaisValor(const std::vector<Persona> personas);
 
 const Persona* buscarLongevaPaisReferencia(const std::vector<Persona> &personas);
 
-std::unordered_map<std::string,const Persona*> mostrarPersonasLongevasCiudadReferencia(const std::vector<Persona> &personas);
+MapaAgrupado<const Persona*> mostrarPersonasLongevasCiudadReferencia(const std::vector<Persona> &personas, std::pmr::memory_resource* recurso = std::pmr::get_default_resource());
 
-std::unordered_map<std::string,Persona> mostrarPersonasLongevasCiudadValor(const std::vector<Persona> personas);
+MapaAgrupado<Persona> mostrarPersonasLongevasCiudadValor(const std::vector<Persona> personas);
 
 const Persona* buscarMayorPatrimonioPaisReferencia(const std::vector<Persona> &personas);
 
 const Persona buscarMayorPatrimonioPaisValor(const std::vector<Persona> personas);
 
-std::unordered_map<std::string,const Persona*> buscarMayorPatrimonioCiudadReferencia(const std::vector<Persona> &personas);
+MapaAgrupado<const Persona*> buscarMayorPatrimonioCiudadReferencia(const std::vector<Persona> &personas, std::pmr::memory_resource* recurso = std::pmr::get_default_resource());
 
-std::unordered_map<std::string,Persona> buscarMayorPatrimonioCiudadValor(const std::vector<Persona> personas);
+MapaAgrupado<Persona> buscarMayorPatrimonioCiudadValor(const std::vector<Persona> personas);
 
-std::unordered_map<std::string,const Persona*> buscarMayorPatrimonioGrupoReferencia(const std::vector<Persona> &personas);
+MapaAgrupado<const Persona*> buscarMayorPatrimonioGrupoReferencia(const std::vector<Persona> &personas, std::pmr::memory_resource* recurso = std::pmr::get_default_resource());
 
-std::unordered_map<std::string,Persona> buscarMayorPatrimonioGrupoValor(const std::vector<Persona> personas);
+MapaAgrupado<Persona> buscarMayorPatrimonioGrupoValor(const std::vector<Persona> personas);
 
-const std::unordered_map<std::string,std::vector<const Persona*>> listarPersonasGrupoReferencia(const std::vector<Persona> &personas);
+MapaAgrupado<ListaPersonas> listarPersonasGrupoReferencia(const std::vector<Persona> &personas, std::pmr::memory_resource* recurso = std::pmr::get_default_resource());
 
-std::unordered_map<std::string,std::vector<Persona>> listarPersonasGrupoValor(std::vector<Persona> personas);
+MapaAgrupado<std::vector<Persona>> listarPersonasGrupoValor(std::vector<Persona> personas);
 
 const Persona* buscarMayorDeudaPaisReferencia(const std::vector<Persona> &personas);
 
 Persona buscarMayorDeudaPaisValor(std::vector<Persona> personas);
 
-const std::pair<std::string,long double> buscarCiudadMayorPatrimonioReferencia(const std::vector<Persona> &personas);
+const std::pair<std::string,long double> buscarCiudadMayorPatrimonioReferencia(const std::vector<Persona> &personas, std::pmr::memory_resource* recurso = std::pmr::get_default_resource());
 
 const std::pair<std::string,long double> buscarCiudadMayorPatrimonioValor(const std::vector<Persona> personas);
 
-std::unordered_map<std::string,std::vector<const Persona*>> listarPersonasConPatrimonioMayor1000Referencia(const std::vector<Persona> &personas);
+MapaAgrupado<ListaPersonas> listarPersonasConPatrimonioMayor1000Referencia(const std::vector<Persona> &personas, std::pmr::memory_resource* recurso = std::pmr::get_default_resource());
 
-std::unordered_map<std::string,std::vector<Persona>> listarPersonasConPatrimonioMayor1000Valor(std::vector<Persona> personas);
+MapaAgrupado<std::vector<Persona>> listarPersonasConPatrimonioMayor1000Valor(std::vector<Persona> personas);
 
 #endif // GENERADOR_H
\ No newline at end of file
@@ -0,0 +1,272 @@
+#include "incremental.h"
+#include "columnas.h"
+#include "generador.h"
+#include <algorithm>
+#include <charconv>
+
+namespace {
+
+// Quita una entrada del árbol de su llave y borra la llave si el árbol queda vacío
+template <class Arbol, class Valor>
+bool quitar(MapaPlano<std::string, Arbol>& mapa, std::string_view llave, const Valor& valor) {
+    auto* entrada = mapa.buscar(llave);
+    entrada->second.erase(valor);
+    if (!entrada->second.empty()) return false;
+    mapa.borrar(llave);
+    return true;
+}
+
+// Llena un árbol vacío con entradas en cualquier orden
+template <class Arbol, class Valor>
+void construir(Arbol& arbol, std::vector<Valor>& entradas) {
+    std::sort(entradas.begin(), entradas.end(), arbol.key_comp());
+    // Con la pista en end() cada inserción es O(1) amortizado y los nodos quedan en orden
+    for (const auto& entrada : entradas) arbol.insert(arbol.end(), entrada);
+    entradas.clear();
+    entradas.shrink_to_fit();
+}
+
+} // namespace
+
+ConjuntoIncremental::ConjuntoIncremental(double umbral) : umbral(umbral) {}
+
+void ConjuntoIncremental::cargar(const std::vector<Persona>& personas) {
+    *this = ConjuntoIncremental(umbral);
+    // Insertar fila por fila en los árboles salta por toda la memoria; en la carga
+    // se juntan las entradas de cada llave, se ordenan y se insertan al final
+    MapaPlano<std::string, std::vector<Entrada>> entradasLongevas, entradasCiudad, entradasGrupo;
+    MapaPlano<std::string, std::vector<std::pair<uint64_t, uint32_t>>> entradasUmbral;
+    std::vector<Entrada> entradasDeuda;
+    filas.reserve(personas.size());
+    entradasDeuda.reserve(personas.size());
+    long mayorId = 0;
+    for (const auto& persona : personas) {
+        std::string id = persona.getId();
+        auto [entrada, nueva] = porId.insertar(id, static_cast<uint32_t>(filas.size()));
+        if (!nueva) continue;   // Cédula repetida: se conserva la primera
+        long numero = 0;
+        if (std::from_chars(id.data(), id.data() + id.size(), numero).ec == std::errc()) {
+            mayorId = std::max(mayorId, numero);
+        }
+        uint32_t fila = entrada->second;
+        uint64_t secuencia = siguienteSecuencia++;
+        filas.push_back({persona, secuencia, true});
+
+        // La ciudad es llave de cuatro mapas: su hash se calcula una vez por fila
+        std::string_view ciudad = persona.getCiudadVista();
+        uint64_t hashCiudad = hashTexto(ciudad);
+        double neto = persona.getPatrimonio() - persona.getDeudas();
+        double fecha = empaquetarFecha(persona.getFechaNacimiento());
+        entradasLongevas.insertarConHash(ciudad, hashCiudad).first->second.push_back({-fecha, secuencia, fila});
+        entradasCiudad.insertarConHash(ciudad, hashCiudad).first->second.push_back({neto, secuencia, fila});
+        entradasGrupo[persona.getGrupoVista()].push_back({neto, secuencia, fila});
+        entradasDeuda.push_back({persona.getDeudas(), secuencia, fila});
+        totales.insertarConHash(ciudad, hashCiudad, 0.0L).first->second += persona.getPatrimonio();
+        if (persona.getPatrimonio() > umbral) {
+            entradasUmbral.insertarConHash(ciudad, hashCiudad).first->second.push_back({secuencia, fila});
+            ++mayoresUmbral;
+        }
+    }
+    construir(deudas, entradasDeuda);
+    for (auto& [ciudad, entradas] : entradasLongevas) construir(longevas[ciudad], entradas);
+    for (auto& [ciudad, entradas] : entradasCiudad) construir(ricasPorCiudad[ciudad], entradas);
+    for (auto& [grupo, entradas] : entradasGrupo) construir(ricasPorGrupo[grupo], entradas);
+    for (auto& [ciudad, entradas] : entradasUmbral) construir(sobreUmbral[ciudad], entradas);
+    // Las altas generadas después (opción 27) no deben chocar con las cédulas cargadas
+    reservarIDsHasta(mayorId);
+}
+
+bool ConjuntoIncremental::insertar(const Persona& persona) {
+    auto [entrada, nueva] = porId.insertar(persona.getId(), 0u);
+    if (!nueva) return false;
+    uint32_t fila;
+    if (libres.empty()) {
+        fila = static_cast<uint32_t>(filas.size());
+        filas.emplace_back();
+    } else {
+        fila = libres.back();
+        libres.pop_back();
+    }
+    entrada->second = fila;
+    filas[fila].persona = persona;
+    filas[fila].secuencia = siguienteSecuencia++;
+    filas[fila].ocupada = true;
+    indexar(fila);
+    return true;
+}
+
+bool ConjuntoIncremental::actualizar(const Persona& persona) {
+    auto* entrada = porId.buscar(persona.getId());
+    if (entrada == nullptr) return false;
+    uint32_t fila = entrada->second;
+    desindexar(fila);
+    filas[fila].persona = persona;
+    indexar(fila);
+    return true;
+}
+
+bool ConjuntoIncremental::borrar(std::string_view id) {
+    auto* entrada = porId.buscar(id);
+    if (entrada == nullptr) return false;
+    uint32_t fila = entrada->second;
+    desindexar(fila);
+    filas[fila].persona = Persona();
+    filas[fila].ocupada = false;
+    libres.push_back(fila);
+    porId.borrar(id);
+    return true;
+}
+
+const Persona* ConjuntoIncremental::buscar(std::string_view id) const {
+    auto* entrada = porId.buscar(id);
+    return entrada == nullptr ? nullptr : &filas[entrada->second].persona;
+}
+
+void ConjuntoIncremental::indexar(uint32_t fila) {
+    const Persona& persona = filas[fila].persona;
+    uint64_t secuencia = filas[fila].secuencia;
+    std::string_view ciudad = persona.getCiudadVista();
+    uint64_t hashCiudad = hashTexto(ciudad);   // Como en cargar: un hash para los mapas por ciudad
+    double neto = persona.getPatrimonio() - persona.getDeudas();
+    double fecha = empaquetarFecha(persona.getFechaNacimiento());
+
+    longevas.insertarConHash(ciudad, hashCiudad).first->second.insert({-fecha, secuencia, fila});
+    ricasPorCiudad.insertarConHash(ciudad, hashCiudad).first->second.insert({neto, secuencia, fila});
+    ricasPorGrupo[persona.getGrupoVista()].insert({neto, secuencia, fila});
+    deudas.insert({persona.getDeudas(), secuencia, fila});
+    totales.insertarConHash(ciudad, hashCiudad, 0.0L).first->second += persona.getPatrimonio();
+    if (persona.getPatrimonio() > umbral) {
+        sobreUmbral.insertarConHash(ciudad, hashCiudad).first->second.insert({secuencia, fila});
+        ++mayoresUmbral;
+    }
+}
+
+void ConjuntoIncremental::desindexar(uint32_t fila) {
+    const Persona& persona = filas[fila].persona;
+    uint64_t secuencia = filas[fila].secuencia;
+    std::string_view ciudad = persona.getCiudadVista();
+    double neto = persona.getPatrimonio() - persona.getDeudas();
+    double fecha = empaquetarFecha(persona.getFechaNacimiento());
+
+    quitar(longevas, ciudad, Entrada{-fecha, secuencia, fila});
+    quitar(ricasPorGrupo, persona.getGrupoVista(), Entrada{neto, secuencia, fila});
+    deudas.erase({persona.getDeudas(), secuencia, fila});
+    // El total de una ciudad que se queda sin personas se borra con ella
+    if (quitar(ricasPorCiudad, ciudad, Entrada{neto, secuencia, fila})) {
+        totales.borrar(ciudad);
+    } else {
+        totales.buscar(ciudad)->second -= persona.getPatrimonio();
+    }
+    if (persona.getPatrimonio() > umbral) {
+        quitar(sobreUmbral, ciudad, std::make_pair(secuencia, fila));
+        --mayoresUmbral;
+    }
+}
+
+const Persona* ConjuntoIncremental::primero(const MapaPlano<std::string, Ranking>& rankings) const {
+    const Entrada* mejor = nullptr;
+    for (const auto& [llave, ranking] : rankings) {
+        if (mejor == nullptr || PrimeroMayor{}(*ranking.begin(), *mejor)) mejor = &*ranking.begin();
+    }
+    return mejor == nullptr ? nullptr : &filas[mejor->fila].persona;
+}
+
+MapaPlano<std::string, const Persona*> ConjuntoIncremental::primeros(const MapaPlano<std::string, Ranking>& rankings,
+                                                                     std::pmr::memory_resource* recurso) const {
+    MapaPlano<std::string, const Persona*> resultado(recurso);
+    for (const auto& [llave, ranking] : rankings) {
+        resultado.insertar(llave, &filas[ranking.begin()->fila].persona);
+    }
+    return resultado;
+}
+
+const Persona* ConjuntoIncremental::longevaPais() const { return primero(longevas); }
+
+const Persona* ConjuntoIncremental::mayorPatrimonioPais() const { return primero(ricasPorCiudad); }
+
+const Persona* ConjuntoIncremental::mayorDeudaPais() const {
+    return deudas.empty() ? nullptr : &filas[deudas.begin()->fila].persona;
+}
+
+MapaPlano<std::string, const Persona*> ConjuntoIncremental::longevaPorCiudad(std::pmr::memory_resource* recurso) const {
+    return primeros(longevas, recurso);
+}
+
+MapaPlano<std::string, const Persona*> ConjuntoIncremental::mayorPatrimonioPorCiudad(std::pmr::memory_resource* recurso) const {
+    return primeros(ricasPorCiudad, recurso);
+}
+
+MapaPlano<std::string, const Persona*> ConjuntoIncremental::mayorPatrimonioPorGrupo(std::pmr::memory_resource* recurso) const {
+    return primeros(ricasPorGrupo, recurso);
+}
+
+std::pair<std::string, long double> ConjuntoIncremental::ciudadMayorPatrimonio() const {
+    std::pair<std::string, long double> ciudadRica = {"", 0};
+    for (const auto& [ciudad, total] : totales) {
+        if (total > ciudadRica.second) ciudadRica = {ciudad, total};
+    }
+    return ciudadRica;
+}
+
+MapaPlano<std::string, std::pmr::vector<const Persona*>>
+ConjuntoIncremental::patrimonioMayorUmbral(std::pmr::memory_resource* recurso) const {
+    MapaPlano<std::string, std::pmr::vector<const Persona*>> resultado(recurso);
+    for (const auto& [ciudad, listado] : sobreUmbral) {
+        auto& personas = resultado[ciudad];
+        personas.reserve(listado.size());
+        for (const auto& [secuencia, fila] : listado) personas.push_back(&filas[fila].persona);
+    }
+    return resultado;
+}
+
+std::vector<Persona> ConjuntoIncremental::materializar(std::pmr::memory_resource* recurso) const {
+    std::vector<uint32_t> orden;
+    orden.reserve(tamano());
+    for (uint32_t i = 0; i < filas.size(); ++i) {
+        if (filas[i].ocupada) orden.push_back(i);
+    }
+    // Sin reutilización de posiciones el orden ya es el de secuencia y esto no mueve nada
+    std::sort(orden.begin(), orden.end(),
+              [&](uint32_t a, uint32_t b) { return filas[a].secuencia < filas[b].secuencia; });
+    std::vector<Persona> personas;
+    personas.reserve(orden.size());
+    for (uint32_t i : orden) {
+        const Persona& p = filas[i].persona;
+        personas.emplace_back(p.getNombre(), p.getApellido(), p.getId(), p.getCiudadNacimiento(),
+                              p.getFechaNacimiento(), p.getIngresosAnuales(), p.getPatrimonio(),
+                              p.getDeudas(), p.getGrupoDeclaracion(), recurso);
+    }
+    return personas;
+}
+
+ResumenCambios aplicarCambiosAleatorios(ConjuntoIncremental& conjunto, size_t n) {
+    ResumenCambios resumen;
+    // Persona ocupada al azar; las posiciones libres se descartan y se vuelve a sortear
+    auto alAzar = [&]() {
+        const Persona* persona = nullptr;
+        while (persona == nullptr) {
+            size_t i = static_cast<size_t>(randomDouble(0, static_cast<double>(conjunto.posiciones())));
+            persona = conjunto.enPosicion(std::min(i, conjunto.posiciones() - 1));
+        }
+        return persona;
+    };
+    for (size_t k = 0; k < n; ++k) {
+        double tipo = randomDouble(0, 1);
+        if (conjunto.tamano() == 0 || tipo < 0.2) {
+            // Una cédula repetida no es un alta
+            if (conjunto.insertar(generarPersona())) ++resumen.altas;
+        } else if (tipo < 0.8) {
+            const Persona* actual = alAzar();
+            Persona nueva = generarPersona();
+            std::string ciudad = randomDouble(0, 1) < 0.1 ? nueva.getCiudadNacimiento() : actual->getCiudadNacimiento();
+            conjunto.actualizar(Persona(actual->getNombre(), actual->getApellido(), actual->getId(), ciudad,
+                                        actual->getFechaNacimiento(), nueva.getIngresosAnuales(),
+                                        nueva.getPatrimonio(), nueva.getDeudas(), actual->getGrupoDeclaracion()));
+            ++resumen.actualizaciones;
+        } else {
+            conjunto.borrar(alAzar()->getId());
+            ++resumen.bajas;
+        }
+    }
+    return resumen;
+}
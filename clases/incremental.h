@@ -0,0 +1,148 @@
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include "persona.h"
+#include "mapa_plano.h"
+#include <cstdint>
+#include <memory_resource>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * Conjunto de personas que se modifica por cédula y mantiene sus agregados.
+ *
+ * POR QUÉ: Las consultas del menú recorren todo el conjunto; con cientos de miles
+ *          de cambios al día, volver a recorrerlo después de cada lote no alcanza.
+ * CÓMO: Cada persona ocupa una posición fija (las posiciones liberadas se reutilizan)
+ *       y tiene un número de secuencia que conserva al actualizarse. Por ciudad y por
+ *       grupo hay un árbol ordenado (std::set) de (valor, secuencia), así el máximo es
+ *       el primero del árbol y quitar al máximo actual cuesta O(log n) como cualquier
+ *       otro borrado. Los totales por ciudad se suman y restan, y el listado por umbral
+ *       es otro árbol por ciudad ordenado por secuencia.
+ * PARA QUÉ: Insertar, actualizar o borrar en O(log n) y responder las consultas de
+ *           máximos en O(ciudades) y el listado en O(resultado), con los mismos
+ *           resultados y desempates (gana la primera fila) que un recorrido completo.
+ *
+ * Los punteros que devuelven las consultas valen hasta la siguiente modificación.
+ */
+class ConjuntoIncremental {
+public:
+    explicit ConjuntoIncremental(double umbral = 1'000'000'000.0);
+
+    /**
+     * Reemplaza el contenido por las personas dadas, en ese orden.
+     */
+    void cargar(const std::vector<Persona>& personas);
+
+    /**
+     * Agrega una persona nueva al final del orden.
+     * @return false si ya hay una persona con esa cédula.
+     */
+    bool insertar(const Persona& persona);
+
+    /**
+     * Reemplaza los datos de la persona con la misma cédula; conserva su lugar en el orden.
+     * @return false si la cédula no existe.
+     */
+    bool actualizar(const Persona& persona);
+
+    /**
+     * Quita a la persona con esa cédula.
+     * @return false si la cédula no existe.
+     */
+    bool borrar(std::string_view id);
+
+    const Persona* buscar(std::string_view id) const;
+
+    size_t tamano() const { return porId.size(); }
+    size_t posiciones() const { return filas.size(); }
+
+    // Persona en una posición, o nullptr si está libre (para recorrer o muestrear)
+    const Persona* enPosicion(size_t i) const { return filas[i].ocupada ? &filas[i].persona : nullptr; }
+
+    const Persona* longevaPais() const;
+    const Persona* mayorPatrimonioPais() const;
+    const Persona* mayorDeudaPais() const;
+    MapaPlano<std::string, const Persona*> longevaPorCiudad(std::pmr::memory_resource* recurso = std::pmr::get_default_resource()) const;
+    MapaPlano<std::string, const Persona*> mayorPatrimonioPorCiudad(std::pmr::memory_resource* recurso = std::pmr::get_default_resource()) const;
+    MapaPlano<std::string, const Persona*> mayorPatrimonioPorGrupo(std::pmr::memory_resource* recurso = std::pmr::get_default_resource()) const;
+    std::pair<std::string, long double> ciudadMayorPatrimonio() const;
+    size_t cantidadMayorUmbral() const { return mayoresUmbral; }
+    MapaPlano<std::string, std::pmr::vector<const Persona*>> patrimonioMayorUmbral(std::pmr::memory_resource* recurso = std::pmr::get_default_resource()) const;
+
+    /**
+     * Copia las personas en su orden (el de carga, con las nuevas al final).
+     *
+     * POR QUÉ: Las consultas originales trabajan sobre un std::vector<Persona>.
+     * CÓMO: Ordena las posiciones ocupadas por secuencia y copia sus textos al recurso.
+     * PARA QUÉ: Que un recorrido completo sobre la copia dé los mismos resultados,
+     *           empates incluidos, que las consultas mantenidas.
+     */
+    std::vector<Persona> materializar(std::pmr::memory_resource* recurso = std::pmr::get_default_resource()) const;
+
+private:
+    struct Fila {
+        Persona persona;
+        uint64_t secuencia = 0;   // Orden de llegada; define los desempates
+        bool ocupada = false;
+    };
+
+    // Posición en un árbol de máximos: primero el mayor valor y, si empatan, la menor secuencia
+    struct Entrada {
+        double valor;
+        uint64_t secuencia;
+        uint32_t fila;
+    };
+    struct PrimeroMayor {
+        bool operator()(const Entrada& a, const Entrada& b) const {
+            return a.valor != b.valor ? a.valor > b.valor : a.secuencia < b.secuencia;
+        }
+    };
+    using Ranking = std::set<Entrada, PrimeroMayor>;
+    using Listado = std::set<std::pair<uint64_t, uint32_t>>;   // (secuencia, fila)
+
+    void indexar(uint32_t fila);
+    void desindexar(uint32_t fila);
+    const Persona* primero(const MapaPlano<std::string, Ranking>& rankings) const;
+    MapaPlano<std::string, const Persona*> primeros(const MapaPlano<std::string, Ranking>& rankings,
+                                                    std::pmr::memory_resource* recurso) const;
+
+    double umbral;
+    std::vector<Fila> filas;
+    std::vector<uint32_t> libres;                     // Posiciones borradas para reutilizar
+    uint64_t siguienteSecuencia = 0;
+    MapaPlano<std::string, uint32_t> porId;
+    MapaPlano<std::string, Ranking> longevas;         // Valor: fecha AAAAMMDD negada
+    MapaPlano<std::string, Ranking> ricasPorCiudad;   // Valor: patrimonio neto
+    MapaPlano<std::string, Ranking> ricasPorGrupo;
+    Ranking deudas;
+    MapaPlano<std::string, long double> totales;      // Patrimonio sumado por ciudad
+    MapaPlano<std::string, Listado> sobreUmbral;
+    size_t mayoresUmbral = 0;
+};
+
+/**
+ * Cantidad de operaciones de cada tipo de un lote de cambios.
+ */
+struct ResumenCambios {
+    size_t altas = 0;
+    size_t actualizaciones = 0;
+    size_t bajas = 0;
+};
+
+/**
+ * Aplica n cambios aleatorios: 20% altas, 60% actualizaciones y 20% bajas.
+ *
+ * POR QUÉ: Medir el costo de mantener los agregados con una mezcla parecida a la
+ *          de las novedades diarias (sobre todo declaraciones corregidas).
+ * CÓMO: Las altas son personas de generarPersona(); una actualización conserva
+ *       nombre, cédula, fecha y grupo de una persona al azar y cambia sus montos
+ *       (y una de cada diez, la ciudad); una baja quita a una persona al azar.
+ * PARA QUÉ: Probar el conjunto incremental desde el menú y desde --updates.
+ */
+ResumenCambios aplicarCambiosAleatorios(ConjuntoIncremental& conjunto, size_t n);
+
+#endif // INCREMENTAL_H
@@ -0,0 +1,74 @@
+#ifndef INSTANTANEAS_H
+#define INSTANTANEAS_H
+
+#include "persona.h"
+#include "arena.h"
+#include "paginas.h"
+#include "muestreo.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * Número nuevo para identificar un estado de los datos.
+ *
+ * Es global y crece siempre, así que dos estados distintos (una instantánea, un
+ * lote de cambios incrementales) nunca comparten versión, aunque los cree otro hilo.
+ */
+inline uint64_t nuevaVersion() {
+    static std::atomic<uint64_t> siguiente{1};
+    return siguiente.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * Versión inmutable de un conjunto de datos: las personas, la arena de sus textos
+ * y el número de versión.
+ *
+ * Una vez publicada no se modifica; cambiar los datos es publicar otra.
+ */
+struct ConjuntoDatos {
+    // Las arenas se declaran antes que personas para que se destruyan después de ellas
+    std::unique_ptr<ArenaDatos> arena = nuevaArenaDatos();
+    std::vector<std::unique_ptr<ArenaDatos>> arenasHilos;   // Una por hilo en la generación paralela
+    std::vector<Persona> personas;
+    MuestraPersonas muestra;   // Para las consultas aproximadas; se llena al cargar
+    uint64_t version = nuevaVersion();
+
+    ConjuntoDatos() { vivas().fetch_add(1, std::memory_order_relaxed); }
+    ~ConjuntoDatos() { vivas().fetch_sub(1, std::memory_order_relaxed); }
+    ConjuntoDatos(const ConjuntoDatos&) = delete;
+    ConjuntoDatos& operator=(const ConjuntoDatos&) = delete;
+
+    // Versiones que siguen en memoria (la vigente y las que algún lector aún tiene fijadas)
+    static std::atomic<size_t>& vivas() {
+        static std::atomic<size_t> contador{0};
+        return contador;
+    }
+};
+
+/**
+ * Punto de publicación de la versión vigente, al estilo RCU.
+ *
+ * POR QUÉ: La opción 0 reemplazaba la colección en el lugar, así que no se podía
+ *          seguir consultando mientras se generaba o cargaba la siguiente.
+ * CÓMO: Un lector fija la versión vigente copiando el shared_ptr y la usa de
+ *       principio a fin; un escritor construye la versión nueva aparte y la publica
+ *       con un solo reemplazo atómico del puntero. El conteo de referencias hace de
+ *       periodo de gracia: una versión vieja se libera cuando la suelta el último
+ *       lector que la tenía fijada, sin bloquear al escritor ni a los demás lectores.
+ * PARA QUÉ: Que las consultas nunca esperen a una recarga ni vean una colección a
+ *           medio construir.
+ */
+class PublicadorDatos {
+public:
+    // Versión vigente (nullptr si todavía no hay datos); sigue válida aunque se publique otra
+    std::shared_ptr<const ConjuntoDatos> fijar() const { return std::atomic_load(&vigente); }
+
+    void publicar(std::shared_ptr<const ConjuntoDatos> nueva) { std::atomic_store(&vigente, std::move(nueva)); }
+
+private:
+    std::shared_ptr<const ConjuntoDatos> vigente;
+};
+
+#endif // INSTANTANEAS_H
@@ -0,0 +1,364 @@
+#include "kernels.h"
+#include "simd.h"
+#include <algorithm>
+#include <array>
+
+#ifdef SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Filas por bloque de los núcleos que usan índices de 32 bits por carril
+const size_t FILAS_POR_BLOQUE_32 = size_t(1) << 30;
+
+// Filas por bloque del filtro (el bloque se copia al vector de salida)
+const size_t FILAS_POR_BLOQUE_FILTRO = 4096;
+
+NivelSimd resolver(NivelSimd nivel) {
+    NivelSimd disponible = nivelSimdDisponible();
+    if (nivel == NivelSimd::Automatico) return disponible;
+    // Un nivel pedido que la CPU no tiene se degrada al mejor disponible
+    if (nivel == NivelSimd::Avx512 && disponible != NivelSimd::Avx512) return disponible;
+    if (nivel == NivelSimd::Avx2 && disponible == NivelSimd::Escalar) return disponible;
+    return nivel;
+}
+
+// Reduce los carriles: mayor valor y, entre empates, la fila menor
+template <class T, size_t N>
+size_t reducirCarriles(const std::array<T, N>& valores, const std::array<int64_t, N>& filas, bool mayor) {
+    size_t mejor = 0;
+    for (size_t k = 1; k < N; ++k) {
+        bool mejora = mayor ? valores[mejor] < valores[k] : valores[k] < valores[mejor];
+        bool empate = !(valores[mejor] < valores[k]) && !(valores[k] < valores[mejor]);
+        if (mejora || (empate && filas[k] < filas[mejor])) mejor = k;
+    }
+    return static_cast<size_t>(filas[mejor]);
+}
+
+// ---- Versiones escalares ----
+
+size_t argmaxNetoEscalar(const double* p, const double* d, size_t desde, size_t n, size_t mejor) {
+    double mejorNeto = p[mejor] - d[mejor];
+    for (size_t i = desde; i < n; ++i) {
+        double neto = p[i] - d[i];
+        if (mejorNeto < neto) {
+            mejorNeto = neto;
+            mejor = i;
+        }
+    }
+    return mejor;
+}
+
+size_t argmaxValorEscalar(const double* v, size_t desde, size_t n, size_t mejor) {
+    for (size_t i = desde; i < n; ++i) {
+        if (v[mejor] < v[i]) mejor = i;
+    }
+    return mejor;
+}
+
+size_t argminFechaEscalar(const int32_t* f, size_t desde, size_t n, size_t mejor) {
+    for (size_t i = desde; i < n; ++i) {
+        if (f[i] < f[mejor]) mejor = i;
+    }
+    return mejor;
+}
+
+size_t filtrarEscalar(const double* v, size_t desde, size_t n, double umbral, uint32_t* salida) {
+    size_t cuenta = 0;
+    for (size_t i = desde; i < n; ++i) {
+        if (v[i] > umbral) salida[cuenta++] = static_cast<uint32_t>(i);
+    }
+    return cuenta;
+}
+
+#ifdef SIMD_X86
+
+// ---- AVX2 ----
+
+__attribute__((target("avx2")))
+size_t argmaxNetoAvx2(const double* p, const double* d, size_t n) {
+    __m256d mejor = _mm256_sub_pd(_mm256_loadu_pd(p), _mm256_loadu_pd(d));
+    __m256i filas = _mm256_setr_epi64x(0, 1, 2, 3);
+    __m256i actual = filas;
+    const __m256i paso = _mm256_set1_epi64x(4);
+    size_t i = 4;
+    for (; i + 4 <= n; i += 4) {
+        actual = _mm256_add_epi64(actual, paso);
+        __m256d neto = _mm256_sub_pd(_mm256_loadu_pd(p + i), _mm256_loadu_pd(d + i));
+        __m256d mascara = _mm256_cmp_pd(neto, mejor, _CMP_GT_OQ);
+        mejor = _mm256_blendv_pd(mejor, neto, mascara);
+        filas = _mm256_castpd_si256(_mm256_blendv_pd(_mm256_castsi256_pd(filas), _mm256_castsi256_pd(actual), mascara));
+    }
+    std::array<double, 4> valores;
+    std::array<int64_t, 4> indices;
+    _mm256_storeu_pd(valores.data(), mejor);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(indices.data()), filas);
+    return argmaxNetoEscalar(p, d, i, n, reducirCarriles(valores, indices, true));
+}
+
+__attribute__((target("avx2")))
+size_t argmaxValorAvx2(const double* v, size_t n) {
+    __m256d mejor = _mm256_loadu_pd(v);
+    __m256i filas = _mm256_setr_epi64x(0, 1, 2, 3);
+    __m256i actual = filas;
+    const __m256i paso = _mm256_set1_epi64x(4);
+    size_t i = 4;
+    for (; i + 4 <= n; i += 4) {
+        actual = _mm256_add_epi64(actual, paso);
+        __m256d valor = _mm256_loadu_pd(v + i);
+        __m256d mascara = _mm256_cmp_pd(valor, mejor, _CMP_GT_OQ);
+        mejor = _mm256_blendv_pd(mejor, valor, mascara);
+        filas = _mm256_castpd_si256(_mm256_blendv_pd(_mm256_castsi256_pd(filas), _mm256_castsi256_pd(actual), mascara));
+    }
+    std::array<double, 4> valores;
+    std::array<int64_t, 4> indices;
+    _mm256_storeu_pd(valores.data(), mejor);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(indices.data()), filas);
+    return argmaxValorEscalar(v, i, n, reducirCarriles(valores, indices, true));
+}
+
+// n <= FILAS_POR_BLOQUE_32
+__attribute__((target("avx2")))
+size_t argminFechaAvx2(const int32_t* f, size_t n) {
+    __m256i mejor = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(f));
+    __m256i filas = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i actual = filas;
+    const __m256i paso = _mm256_set1_epi32(8);
+    size_t i = 8;
+    for (; i + 8 <= n; i += 8) {
+        actual = _mm256_add_epi32(actual, paso);
+        __m256i fecha = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(f + i));
+        __m256i mascara = _mm256_cmpgt_epi32(mejor, fecha);
+        mejor = _mm256_blendv_epi8(mejor, fecha, mascara);
+        filas = _mm256_blendv_epi8(filas, actual, mascara);
+    }
+    std::array<int32_t, 8> valores;
+    std::array<int32_t, 8> filas32;
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(valores.data()), mejor);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(filas32.data()), filas);
+    std::array<int64_t, 8> indices;
+    for (size_t k = 0; k < 8; ++k) indices[k] = filas32[k];
+    return argminFechaEscalar(f, i, n, reducirCarriles(valores, indices, false));
+}
+
+// Permutación que junta al inicio los carriles activos de cada máscara de 8 bits
+const std::array<std::array<uint32_t, 8>, 256>& tablaCompresion() {
+    static const auto tabla = [] {
+        std::array<std::array<uint32_t, 8>, 256> t{};
+        for (unsigned mascara = 0; mascara < 256; ++mascara) {
+            unsigned k = 0;
+            for (unsigned carril = 0; carril < 8; ++carril) {
+                if (mascara & (1u << carril)) t[mascara][k++] = carril;
+            }
+        }
+        return t;
+    }();
+    return tabla;
+}
+
+// Escribe hasta 8 índices de más después del último válido
+__attribute__((target("avx2,popcnt")))
+size_t filtrarAvx2(const double* v, size_t desde, size_t n, double umbral, uint32_t* salida) {
+    const auto& tabla = tablaCompresion();
+    const __m256d limite = _mm256_set1_pd(umbral);
+    const __m256i paso = _mm256_set1_epi32(8);
+    __m256i actual = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(desde)),
+                                      _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    size_t cuenta = 0;
+    size_t i = desde;
+    for (; i + 8 <= n; i += 8) {
+        int bajos = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(v + i), limite, _CMP_GT_OQ));
+        int altos = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(v + i + 4), limite, _CMP_GT_OQ));
+        unsigned mascara = static_cast<unsigned>(bajos | (altos << 4));
+        __m256i orden = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tabla[mascara].data()));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(salida + cuenta), _mm256_permutevar8x32_epi32(actual, orden));
+        cuenta += static_cast<size_t>(_mm_popcnt_u32(mascara));
+        actual = _mm256_add_epi32(actual, paso);
+    }
+    return cuenta + filtrarEscalar(v, i, n, umbral, salida + cuenta);
+}
+
+// ---- AVX-512 ----
+
+__attribute__((target("avx512f")))
+size_t argmaxNetoAvx512(const double* p, const double* d, size_t n) {
+    __m512d mejor = _mm512_sub_pd(_mm512_loadu_pd(p), _mm512_loadu_pd(d));
+    __m512i filas = _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+    __m512i actual = filas;
+    const __m512i paso = _mm512_set1_epi64(8);
+    size_t i = 8;
+    for (; i + 8 <= n; i += 8) {
+        actual = _mm512_add_epi64(actual, paso);
+        __m512d neto = _mm512_sub_pd(_mm512_loadu_pd(p + i), _mm512_loadu_pd(d + i));
+        __mmask8 mascara = _mm512_cmp_pd_mask(neto, mejor, _CMP_GT_OQ);
+        mejor = _mm512_mask_blend_pd(mascara, mejor, neto);
+        filas = _mm512_mask_blend_epi64(mascara, filas, actual);
+    }
+    std::array<double, 8> valores;
+    std::array<int64_t, 8> indices;
+    _mm512_storeu_pd(valores.data(), mejor);
+    _mm512_storeu_si512(indices.data(), filas);
+    return argmaxNetoEscalar(p, d, i, n, reducirCarriles(valores, indices, true));
+}
+
+__attribute__((target("avx512f")))
+size_t argmaxValorAvx512(const double* v, size_t n) {
+    __m512d mejor = _mm512_loadu_pd(v);
+    __m512i filas = _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+    __m512i actual = filas;
+    const __m512i paso = _mm512_set1_epi64(8);
+    size_t i = 8;
+    for (; i + 8 <= n; i += 8) {
+        actual = _mm512_add_epi64(actual, paso);
+        __m512d valor = _mm512_loadu_pd(v + i);
+        __mmask8 mascara = _mm512_cmp_pd_mask(valor, mejor, _CMP_GT_OQ);
+        mejor = _mm512_mask_blend_pd(mascara, mejor, valor);
+        filas = _mm512_mask_blend_epi64(mascara, filas, actual);
+    }
+    std::array<double, 8> valores;
+    std::array<int64_t, 8> indices;
+    _mm512_storeu_pd(valores.data(), mejor);
+    _mm512_storeu_si512(indices.data(), filas);
+    return argmaxValorEscalar(v, i, n, reducirCarriles(valores, indices, true));
+}
+
+// n <= FILAS_POR_BLOQUE_32
+__attribute__((target("avx512f")))
+size_t argminFechaAvx512(const int32_t* f, size_t n) {
+    __m512i mejor = _mm512_loadu_si512(f);
+    __m512i filas = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m512i actual = filas;
+    const __m512i paso = _mm512_set1_epi32(16);
+    size_t i = 16;
+    for (; i + 16 <= n; i += 16) {
+        actual = _mm512_add_epi32(actual, paso);
+        __m512i fecha = _mm512_loadu_si512(f + i);
+        __mmask16 mascara = _mm512_cmplt_epi32_mask(fecha, mejor);
+        mejor = _mm512_mask_blend_epi32(mascara, mejor, fecha);
+        filas = _mm512_mask_blend_epi32(mascara, filas, actual);
+    }
+    std::array<int32_t, 16> valores;
+    std::array<int32_t, 16> filas32;
+    _mm512_storeu_si512(valores.data(), mejor);
+    _mm512_storeu_si512(filas32.data(), filas);
+    std::array<int64_t, 16> indices;
+    for (size_t k = 0; k < 16; ++k) indices[k] = filas32[k];
+    return argminFechaEscalar(f, i, n, reducirCarriles(valores, indices, false));
+}
+
+// Escribe hasta 16 índices de más después del último válido
+__attribute__((target("avx512f,popcnt")))
+size_t filtrarAvx512(const double* v, size_t desde, size_t n, double umbral, uint32_t* salida) {
+    const __m512d limite = _mm512_set1_pd(umbral);
+    const __m512i paso = _mm512_set1_epi32(16);
+    __m512i actual = _mm512_add_epi32(_mm512_set1_epi32(static_cast<int>(desde)),
+                                      _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+    size_t cuenta = 0;
+    size_t i = desde;
+    for (; i + 16 <= n; i += 16) {
+        __mmask8 bajos = _mm512_cmp_pd_mask(_mm512_loadu_pd(v + i), limite, _CMP_GT_OQ);
+        __mmask8 altos = _mm512_cmp_pd_mask(_mm512_loadu_pd(v + i + 8), limite, _CMP_GT_OQ);
+        __mmask16 mascara = static_cast<__mmask16>(bajos | (altos << 8));
+        _mm512_mask_compressstoreu_epi32(salida + cuenta, mascara, actual);
+        cuenta += static_cast<size_t>(_mm_popcnt_u32(mascara));
+        actual = _mm512_add_epi32(actual, paso);
+    }
+    return cuenta + filtrarEscalar(v, i, n, umbral, salida + cuenta);
+}
+
+#endif // SIMD_X86
+
+} // namespace
+
+NivelSimd nivelSimdDisponible() {
+    if (tieneAvx512()) return NivelSimd::Avx512;
+    if (tieneAvx2()) return NivelSimd::Avx2;
+    return NivelSimd::Escalar;
+}
+
+const char* nombreNivel(NivelSimd nivel) {
+    switch (resolver(nivel)) {
+        case NivelSimd::Avx512: return "AVX-512";
+        case NivelSimd::Avx2: return "AVX2";
+        default: return "escalar";
+    }
+}
+
+size_t argmaxNeto(const double* patrimonio, const double* deudas, size_t n, NivelSimd nivel) {
+    if (n == 0) return 0;
+#ifdef SIMD_X86
+    switch (resolver(nivel)) {
+        case NivelSimd::Avx512: if (n >= 8) return argmaxNetoAvx512(patrimonio, deudas, n); break;
+        case NivelSimd::Avx2: if (n >= 4) return argmaxNetoAvx2(patrimonio, deudas, n); break;
+        default: break;
+    }
+#else
+    (void)nivel;
+#endif
+    return argmaxNetoEscalar(patrimonio, deudas, 1, n, 0);
+}
+
+size_t argmaxValor(const double* valores, size_t n, NivelSimd nivel) {
+    if (n == 0) return 0;
+#ifdef SIMD_X86
+    switch (resolver(nivel)) {
+        case NivelSimd::Avx512: if (n >= 8) return argmaxValorAvx512(valores, n); break;
+        case NivelSimd::Avx2: if (n >= 4) return argmaxValorAvx2(valores, n); break;
+        default: break;
+    }
+#else
+    (void)nivel;
+#endif
+    return argmaxValorEscalar(valores, 1, n, 0);
+}
+
+size_t argminFecha(const int32_t* fechas, size_t n, NivelSimd nivel) {
+    if (n == 0) return 0;
+    NivelSimd elegido = resolver(nivel);
+    // Los carriles guardan índices de 32 bits: se recorre por bloques y se combinan en orden
+    size_t mejor = 0;
+    for (size_t inicio = 0; inicio < n; inicio += FILAS_POR_BLOQUE_32) {
+        size_t cantidad = std::min(FILAS_POR_BLOQUE_32, n - inicio);
+        const int32_t* bloque = fechas + inicio;
+        size_t local;
+#ifdef SIMD_X86
+        if (elegido == NivelSimd::Avx512 && cantidad >= 16) {
+            local = argminFechaAvx512(bloque, cantidad);
+        } else if (elegido != NivelSimd::Escalar && cantidad >= 8) {
+            local = argminFechaAvx2(bloque, cantidad);
+        } else {
+            local = argminFechaEscalar(bloque, 1, cantidad, 0);
+        }
+#else
+        (void)elegido;
+        local = argminFechaEscalar(bloque, 1, cantidad, 0);
+#endif
+        if (inicio == 0 || bloque[local] < fechas[mejor]) mejor = inicio + local;
+    }
+    return mejor;
+}
+
+void filtrarMayor(const double* valores, size_t n, double umbral, std::vector<uint32_t>& filas,
+                  NivelSimd nivel) {
+    NivelSimd elegido = resolver(nivel);
+    // Bloque con holgura para las escrituras de más de las versiones vectoriales
+    uint32_t bloque[FILAS_POR_BLOQUE_FILTRO + 16];
+    for (size_t inicio = 0; inicio < n; inicio += FILAS_POR_BLOQUE_FILTRO) {
+        size_t fin = std::min(n, inicio + FILAS_POR_BLOQUE_FILTRO);
+        size_t cuenta;
+#ifdef SIMD_X86
+        if (elegido == NivelSimd::Avx512) {
+            cuenta = filtrarAvx512(valores, inicio, fin, umbral, bloque);
+        } else if (elegido == NivelSimd::Avx2) {
+            cuenta = filtrarAvx2(valores, inicio, fin, umbral, bloque);
+        } else {
+            cuenta = filtrarEscalar(valores, inicio, fin, umbral, bloque);
+        }
+#else
+        (void)elegido;
+        cuenta = filtrarEscalar(valores, inicio, fin, umbral, bloque);
+#endif
+        filas.insert(filas.end(), bloque, bloque + cuenta);
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Núcleos vectoriales de las consultas más frecuentes sobre columnas.
+//
+// Cada núcleo tiene versión escalar, AVX2 y AVX-512; por defecto se usa la mejor
+// que soporte la CPU (simd.h), y el parámetro nivel permite forzar una para medirlas.
+// Todos devuelven lo mismo que su versión escalar, incluido el desempate: ante
+// valores iguales gana la primera fila, como en generador.cpp y consultas.h.
+
+/**
+ * Conjunto de instrucciones de un núcleo.
+ */
+enum class NivelSimd { Automatico, Escalar, Avx2, Avx512 };
+
+/**
+ * Mejor nivel que soporta la CPU.
+ */
+NivelSimd nivelSimdDisponible();
+
+/**
+ * Nombre legible de un nivel ("escalar", "AVX2", "AVX-512").
+ */
+const char* nombreNivel(NivelSimd nivel);
+
+/**
+ * Fila con mayor patrimonio neto (patrimonio - deudas).
+ *
+ * POR QUÉ: Es la consulta más pedida y en la versión original compara y salta
+ *          por cada Persona.
+ * CÓMO: Cada carril del registro guarda su mejor valor y su fila; al final se
+ *       reducen los carriles quedándose con la fila menor entre los empates.
+ * PARA QUÉ: Recorrer las dos columnas a la velocidad de la memoria.
+ */
+size_t argmaxNeto(const double* patrimonio, const double* deudas, size_t n,
+                  NivelSimd nivel = NivelSimd::Automatico);
+
+/**
+ * Fila con mayores deudas.
+ */
+size_t argmaxValor(const double* valores, size_t n, NivelSimd nivel = NivelSimd::Automatico);
+
+/**
+ * Fila con la menor fecha empaquetada AAAAMMDD (la persona más longeva).
+ */
+size_t argminFecha(const int32_t* fechas, size_t n, NivelSimd nivel = NivelSimd::Automatico);
+
+/**
+ * Agrega a filas los índices con valor mayor al umbral, en orden.
+ *
+ * POR QUÉ: El listado por umbral escribe una fila de cada dos en los datos generados,
+ *          así que la rama del filtro escalar falla la predicción la mitad de las veces.
+ * CÓMO: Compara 8 valores por iteración y escribe de forma contigua solo los índices
+ *       que pasan: con AVX-512, compress-store; con AVX2, una permutación tomada
+ *       de una tabla indexada por la máscara de la comparación.
+ * PARA QUÉ: Un filtro sin ramas que depende solo del ancho de banda.
+ */
+void filtrarMayor(const double* valores, size_t n, double umbral, std::vector<uint32_t>& filas,
+                  NivelSimd nivel = NivelSimd::Automatico);
+
+#endif // KERNELS_H
@@ -0,0 +1,211 @@
+#ifndef LAYOUTS_H
+#define LAYOUTS_H
+
+#include "persona.h"
+#include "columnas.h"
+#include "compresion.h"
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Políticas de distribución en memoria (layouts) para las consultas de consultas.h.
+//
+// Cada política define:
+//   nombre                     Texto usado en las estadísticas
+//   Almacen                    Tipo que guarda el conjunto de datos
+//   Clave                      Tipo de la llave de agrupación (texto o código)
+//   construir(personas)        Convierte el vector original al almacén
+//   tamano(a)                  Número de filas
+//   ciudad(a, i), grupo(a, i)  Llaves de agrupación de la fila i
+//   fecha(a, i)                Fecha de nacimiento AAAAMMDD
+//   patrimonio(a, i), deudas(a, i)
+//   textoCiudad(a, clave)      Nombre legible de una llave de ciudad
+//   textoGrupo(a, clave)       Nombre legible de una llave de grupo
+//   descripcion(a, i)          "[id] nombre apellido" de la fila i
+//
+// Para agregar un layout basta con escribir otra política y sumarla a
+// TodosLosLayouts en benchmark_layouts.cpp.
+
+/**
+ * Persona como estructura con atributos públicos (versión original de Estructura/).
+ *
+ * POR QUÉ: Comparar el acceso directo a campos contra los getters de la clase.
+ * CÓMO: Los mismos atributos que Persona, sin encapsulamiento.
+ * PARA QUÉ: Representar el layout "AoS struct" del análisis del README.
+ */
+struct PersonaEstructura {
+    std::string nombre;
+    std::string apellido;
+    std::string id;
+    std::string ciudadResidencia;
+    std::tuple<int,int,int> fechaNacimiento;
+    double ingresosAnuales;
+    double patrimonio;
+    double deudas;
+    std::string grupoDeclaracion;
+};
+
+/**
+ * Persona empaquetada: textos como códigos de diccionario y fecha como entero.
+ *
+ * POR QUÉ: Cada Persona ocupa cerca de 200 bytes, casi todos en strings.
+ * CÓMO: Campos de ancho fijo ordenados de mayor a menor para evitar relleno.
+ * PARA QUÉ: Layout AoS compacto (48 bytes por fila) que cabe más veces en caché.
+ */
+struct PersonaCompacta {
+    uint64_t id;
+    double ingresos;
+    double patrimonio;
+    double deudas;
+    int32_t fecha;
+    uint32_t nombre;
+    uint32_t apellido;
+    uint16_t ciudad;
+    uint8_t grupo;
+};
+
+/**
+ * Vector de PersonaCompacta con los diccionarios que decodifican sus códigos.
+ */
+struct AlmacenCompacto {
+    std::vector<PersonaCompacta> filas;
+    Diccionarios diccionarios;
+};
+
+// Layout AoS con struct de atributos públicos
+struct LayoutEstructura {
+    static constexpr const char* nombre = "Struct AoS";
+    using Almacen = std::vector<PersonaEstructura>;
+    using Clave = std::string;
+
+    static Almacen construir(const std::vector<Persona>& personas) {
+        Almacen a;
+        a.reserve(personas.size());
+        for (const auto& p : personas) {
+            a.push_back({p.getNombre(), p.getApellido(), p.getId(), p.getCiudadNacimiento(),
+                         p.getFechaNacimiento(), p.getIngresosAnuales(), p.getPatrimonio(),
+                         p.getDeudas(), p.getGrupoDeclaracion()});
+        }
+        return a;
+    }
+    static size_t tamano(const Almacen& a) { return a.size(); }
+    static const Clave& ciudad(const Almacen& a, size_t i) { return a[i].ciudadResidencia; }
+    static const Clave& grupo(const Almacen& a, size_t i) { return a[i].grupoDeclaracion; }
+    static int32_t fecha(const Almacen& a, size_t i) { return empaquetarFecha(a[i].fechaNacimiento); }
+    static double patrimonio(const Almacen& a, size_t i) { return a[i].patrimonio; }
+    static double deudas(const Almacen& a, size_t i) { return a[i].deudas; }
+    static std::string textoCiudad(const Almacen&, const Clave& c) { return c; }
+    static std::string textoGrupo(const Almacen&, const Clave& c) { return c; }
+    static std::string descripcion(const Almacen& a, size_t i) {
+        return "[" + a[i].id + "] " + a[i].nombre + " " + a[i].apellido;
+    }
+};
+
+// Layout AoS con la clase Persona y sus getters (cada getter de texto copia)
+struct LayoutClase {
+    static constexpr const char* nombre = "Clase AoS";
+    using Almacen = std::vector<Persona>;
+    using Clave = std::string;
+
+    static Almacen construir(const std::vector<Persona>& personas) { return personas; }
+    static size_t tamano(const Almacen& a) { return a.size(); }
+    static Clave ciudad(const Almacen& a, size_t i) { return a[i].getCiudadNacimiento(); }
+    static Clave grupo(const Almacen& a, size_t i) { return a[i].getGrupoDeclaracion(); }
+    static int32_t fecha(const Almacen& a, size_t i) { return empaquetarFecha(a[i].getFechaNacimiento()); }
+    static double patrimonio(const Almacen& a, size_t i) { return a[i].getPatrimonio(); }
+    static double deudas(const Almacen& a, size_t i) { return a[i].getDeudas(); }
+    static std::string textoCiudad(const Almacen&, const Clave& c) { return c; }
+    static std::string textoGrupo(const Almacen&, const Clave& c) { return c; }
+    static std::string descripcion(const Almacen& a, size_t i) {
+        return "[" + a[i].getId() + "] " + a[i].getNombre() + " " + a[i].getApellido();
+    }
+};
+
+// Layout SoA: una columna por atributo
+struct LayoutColumnas {
+    static constexpr const char* nombre = "Columnas SoA";
+    using Almacen = ColumnasPersona;
+    using Clave = uint32_t;
+
+    static Almacen construir(const std::vector<Persona>& personas) {
+        Almacen a;
+        a.reservar(personas.size());
+        for (const auto& p : personas) a.agregar(p);
+        return a;
+    }
+    static size_t tamano(const Almacen& a) { return a.tamano(); }
+    static Clave ciudad(const Almacen& a, size_t i) { return a.ciudad[i]; }
+    static Clave grupo(const Almacen& a, size_t i) { return a.grupo[i]; }
+    static int32_t fecha(const Almacen& a, size_t i) { return a.fecha[i]; }
+    static double patrimonio(const Almacen& a, size_t i) { return a.patrimonio[i]; }
+    static double deudas(const Almacen& a, size_t i) { return a.deudas[i]; }
+    static std::string textoCiudad(const Almacen& a, Clave c) { return a.diccionarios->ciudades.valor(c); }
+    static std::string textoGrupo(const Almacen& a, Clave c) { return a.diccionarios->grupos.valor(c); }
+    static std::string descripcion(const Almacen& a, size_t i) {
+        return "[" + std::to_string(a.id[i]) + "] " + a.diccionarios->nombres.valor(a.nombre[i]) +
+               " " + a.diccionarios->apellidos.valor(a.apellido[i]);
+    }
+};
+
+// Layout AoS compacto: filas de ancho fijo con códigos de diccionario
+struct LayoutCompacto {
+    static constexpr const char* nombre = "Compacto AoS";
+    using Almacen = AlmacenCompacto;
+    using Clave = uint32_t;
+
+    static Almacen construir(const std::vector<Persona>& personas) {
+        Almacen a;
+        a.filas.reserve(personas.size());
+        for (const auto& p : personas) {
+            PersonaCompacta fila{std::stoull(p.getId()), p.getIngresosAnuales(), p.getPatrimonio(),
+                                 p.getDeudas(), empaquetarFecha(p.getFechaNacimiento()),
+                                 a.diccionarios.nombres.codificar(p.getNombre()),
+                                 a.diccionarios.apellidos.codificar(p.getApellido()), 0, 0};
+            if (!convertirCodigo(a.diccionarios.ciudades.codificar(p.getCiudadNacimiento()), fila.ciudad) ||
+                !convertirCodigo(a.diccionarios.grupos.codificar(p.getGrupoDeclaracion()), fila.grupo)) {
+                throw std::length_error("Hay más ciudades o grupos distintos de los que caben en sus columnas");
+            }
+            a.filas.push_back(fila);
+        }
+        return a;
+    }
+    static size_t tamano(const Almacen& a) { return a.filas.size(); }
+    static Clave ciudad(const Almacen& a, size_t i) { return a.filas[i].ciudad; }
+    static Clave grupo(const Almacen& a, size_t i) { return a.filas[i].grupo; }
+    static int32_t fecha(const Almacen& a, size_t i) { return a.filas[i].fecha; }
+    static double patrimonio(const Almacen& a, size_t i) { return a.filas[i].patrimonio; }
+    static double deudas(const Almacen& a, size_t i) { return a.filas[i].deudas; }
+    static std::string textoCiudad(const Almacen& a, Clave c) { return a.diccionarios.ciudades.valor(c); }
+    static std::string textoGrupo(const Almacen& a, Clave c) { return a.diccionarios.grupos.valor(c); }
+    static std::string descripcion(const Almacen& a, size_t i) {
+        const auto& f = a.filas[i];
+        return "[" + std::to_string(f.id) + "] " + a.diccionarios.nombres.valor(f.nombre) +
+               " " + a.diccionarios.apellidos.valor(f.apellido);
+    }
+};
+
+// Layout SoA comprimido: columnas empaquetadas en bits (ver compresion.h)
+struct LayoutComprimido {
+    static constexpr const char* nombre = "Columnas comprimidas";
+    using Almacen = ColumnasComprimidas;
+    using Clave = uint32_t;
+    static Almacen construir(const std::vector<Persona>& personas) {
+        return ColumnasComprimidas::comprimir(LayoutColumnas::construir(personas));
+    }
+    static size_t tamano(const Almacen& a) { return a.tamano(); }
+    static Clave ciudad(const Almacen& a, size_t i) { return static_cast<Clave>(a.ciudad.valor(i)); }
+    static Clave grupo(const Almacen& a, size_t i) { return static_cast<Clave>(a.grupo.valor(i)); }
+    static int32_t fecha(const Almacen& a, size_t i) { return static_cast<int32_t>(a.fecha.valor(i)); }
+    static double patrimonio(const Almacen& a, size_t i) { return a.patrimonio.valor(i); }
+    static double deudas(const Almacen& a, size_t i) { return a.deudas.valor(i); }
+    static std::string textoCiudad(const Almacen& a, Clave c) { return a.diccionarios->ciudades.valor(c); }
+    static std::string textoGrupo(const Almacen& a, Clave c) { return a.diccionarios->grupos.valor(c); }
+    static std::string descripcion(const Almacen& a, size_t i) {
+        return "[" + std::to_string(a.id.valor(i)) + "] " +
+               a.diccionarios->nombres.valor(static_cast<uint32_t>(a.nombre.valor(i))) + " " +
+               a.diccionarios->apellidos.valor(static_cast<uint32_t>(a.apellido.valor(i)));
+    }
+};
+
+#endif // LAYOUTS_H
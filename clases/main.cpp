@@ -5,7 +5,29 @@
 #include "persona.h"
 #include "generador.h"
 #include "monitor.h"
-#include <unordered_map>
+#include "comparador.h"
+#include "benchmark_layouts.h"
+#include "cli.h"
+#include "arena.h"
+#include "csv_personas.h"
+#include "agregados.h"
+#include "incremental.h"
+#include "vistas.h"
+#include "instantaneas.h"
+#include "servidor.h"
+#include "compartida.h"
+#include "procesos.h"
+#include "consultas.h"
+#include "numa.h"
+#include "conjunto_virtual.h"
+#include "cuantiles.h"
+#include "distintos.h"
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <ctime>
 
 /**
  * Muestra el menú principal de la aplicación.
@@ -38,432 +60,1728 @@ void mostrarMenu() {
     std::cout << "\n19. Personas tienen patrimonio superior a 1.000 millones(Valor)";   
     std::cout << "\n20. Mostrar estadisticas";
     std::cout << "\n21. Exportar estadisticas";
+    std::cout << "\n23. Comparar layouts (struct, clase, columnas, compacto)";
+    std::cout << "\n24. Exportar personas a CSV";
+    std::cout << "\n25. Importar personas desde CSV";
+    std::cout << "\n26. Reporte completo por segmentos desde CSV (sin cargarlo en memoria)";
+    std::cout << "\n27. Aplicar altas, cambios y bajas con agregados incrementales";
+    std::cout << "\n28. Recargar conjunto de datos en segundo plano";
+    std::cout << "\n29. Ver progreso de la generación en segundo plano";
+    std::cout << "\n30. Cancelar la generación en segundo plano";
+    std::cout << "\n31. Reporte aproximado con muestra (intervalos de confianza)";
+    std::cout << "\n32. Percentiles de patrimonio, ingresos y deudas por ciudad y grupo";
+    std::cout << "\n33. Nombres completos y apellidos distintos por ciudad";
     std::cout << "\n22. Salir";
     std::cout << "\nSeleccione una opción: ";
 }
 
 /**
- * Punto de entrada principal del programa.
+ * Generación de un conjunto nuevo en un hilo aparte (opciones 0 y 28, --reload y
+ * --background).
  * 
- * POR QUÉ: Iniciar la aplicación y manejar el flujo principal.
- * CÓMO: Mediante un bucle que muestra el menú y procesa la opción seleccionada.
- * PARA QUÉ: Ejecutar las funcionalidades del sistema.
+ * El hilo solo toca el conjunto que construye, el publicador y los contadores
+ * atómicos; el resto de la sesión (monitor, caché) lo actualiza el hilo principal
+ * al recoger la recarga.
  */
-int main() {
-    srand(time(nullptr)); // Semilla para generación aleatoria
+struct RecargaEnCurso {
+    std::thread hilo;
+    std::atomic<bool> terminada{false};
+    std::atomic<bool> cancelar{false};      // Lo pide el hilo principal; el generador para en el siguiente bloque
+    std::atomic<size_t> generadas{0};       // Filas generadas hasta ahora
+    std::atomic<size_t> consultables{0};    // Filas de la última versión publicada por esta recarga
+    size_t total = 0;                       // Filas pedidas
+    bool parcial = false;                   // Publicar los segmentos ya generados mientras avanza
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+    size_t filas = 0;
+    double milisegundos = 0;
+    long memoriaInicio = 0;   // Memoria del proceso al iniciar (la anota el hilo principal)
+};
+
+/**
+ * Estado de una sesión: el conjunto de datos vigente y su monitor.
+ * 
+ * POR QUÉ: El menú interactivo y el modo por lotes operan sobre los mismos datos.
+ * CÓMO: Agrupando el publicador de la colección y el monitor en una estructura.
+ * PARA QUÉ: Compartir las mismas funciones de ejecución entre ambos modos.
+ */
+struct Sesion {
+    // Versión vigente de las personas; cada consulta fija la suya con datos.fijar()
+    PublicadorDatos datos;
+    ArenaConsulta arenaConsulta; // Memoria temporal de la consulta en curso
+    Monitor monitor; // Monitor para medir rendimiento
+    unsigned hilos = 0; // Hilos para la carga de archivos (0 = todos los núcleos)
+    size_t presupuestoMemoria = 256u << 20; // Bytes por segmento del reporte fuera de memoria
+    // Conjunto modificable (opción 27); se crea con el primer lote de cambios. Mientras
+    // personasDesactualizadas sea true, personas no refleja esos cambios todavía
+    std::unique_ptr<ConjuntoIncremental> incremental = nullptr;
+    bool personasDesactualizadas = false;
+    uint64_t version = 0; // Versión del último lote de cambios (las vistas de otra versión no sirven)
+    CacheResultados cache; // Resultados de las consultas 2 a 19 por versión
+    bool usarCache = true; // El modo por lotes la desactiva para medir cada repetición
+    std::unique_ptr<RecargaEnCurso> recarga = nullptr; // Generación en segundo plano, si hay una
+    // Planificador con robo de trabajo (--tasks); sin él la generación y las consultas son secuenciales
+    std::unique_ptr<PlanificadorTareas> planificador = nullptr;
+    size_t grano = 65536; // Filas por tarea del planificador
     
-    // Puntero inteligente para gestionar la colección de personas
-    // POR QUÉ: Evitar fugas de memoria y garantizar liberación automática.
-    std::unique_ptr<std::vector<Persona>> personas = nullptr;
+    ~Sesion() {
+        if (recarga && recarga->hilo.joinable()) recarga->hilo.join();
+    }
+};
+
+/**
+ * Hay personas en la versión vigente o en el conjunto incremental.
+ */
+bool hayDatos(const Sesion& sesion) {
+    if (sesion.personasDesactualizadas) return sesion.incremental->tamano() > 0;
+    auto vigente = sesion.datos.fijar();
+    return vigente && !vigente->personas.empty();
+}
+
+/**
+ * Versión de los datos que ven las consultas: la del último lote de cambios si aún
+ * no se copió a la colección, o la de la colección publicada.
+ */
+uint64_t versionVigente(const Sesion& sesion, const ConjuntoDatos* vigente) {
+    if (sesion.personasDesactualizadas) return sesion.version;
+    return vigente ? vigente->version : 0;
+}
+
+/**
+ * Aplica la política de páginas (--huge-pages, --prefault, --mlock) al vector de
+ * personas de una versión nueva antes de publicarla, para que la primera consulta
+ * no pague los fallos de página ni las misses de TLB de 4 KB.
+ */
+void prepararPaginas(const ConjuntoDatos& conjunto) {
+    prepararRegion(conjunto.personas.data(), conjunto.personas.capacity() * sizeof(Persona), false);
+}
+
+/**
+ * Genera un nuevo conjunto de datos (opción 0).
+ * 
+ * POR QUÉ: La generación se invoca desde el menú y desde --generate.
+ * CÓMO: Genera n personas, reemplaza la colección de la sesión y registra la medición.
+ * PARA QUÉ: Dejar listo el conjunto de datos para las consultas.
+ */
+void generarDatos(Sesion& sesion, int n) {
+    Monitor& monitor = sesion.monitor;
+    long memoria_inicio = monitor.obtener_memoria();
+    monitor.iniciar_tiempo();
     
-    Monitor monitor; // Monitor para medir rendimiento
+    if (n <= 0) {
+        std::cout << "Error: Debe generar al menos 1 persona\n";
+        return;
+    }
     
-    int opcion;
-    do {
-        mostrarMenu();
-        std::cin >> opcion;
-        
-        // Variables locales para uso en los casos
-        size_t tam = 0;
-        std::string idBusqueda;
-        
-        // Iniciar medición de tiempo y memoria para la operación actual
-        monitor.iniciar_tiempo();
+    // Generar el nuevo conjunto de personas con sus textos en una arena nueva
+    auto nuevo = std::make_shared<ConjuntoDatos>();
+    if (sesion.planificador) {
+        nuevo->personas = generarColeccionParalela(n, *sesion.planificador, sesion.grano, nuevo->arenasHilos);
+    } else {
+        nuevo->personas = generarColeccion(n, nuevo->arena.get());
+    }
+    prepararPaginas(*nuevo);
+    nuevo->muestra.agregar(nuevo->personas);
+    size_t tam = nuevo->personas.size();
+    
+    // Publicar la versión nueva; la anterior (personas y arena juntas) se libera
+    // cuando la suelte la última consulta que la tenga fijada
+    sesion.datos.publicar(std::move(nuevo));
+    sesion.incremental.reset();
+    sesion.personasDesactualizadas = false;
+    
+    // Medir tiempo y memoria usada
+    double tiempo_gen = monitor.detener_tiempo();
+    long memoria_gen = monitor.obtener_memoria() - memoria_inicio;
+    
+    std::cout << "Generadas " << tam << " personas en " 
+              << tiempo_gen << " ms, Memoria: " << memoria_gen << " KB\n";
+    
+    // Registrar la operación y el tamaño para las siguientes mediciones
+    monitor.establecer_tamano(tam);
+    monitor.registrar("Crear datos", tiempo_gen, memoria_gen);
+}
+
+/**
+ * Reemplaza el conjunto de la sesión por el contenido de un CSV (opción 25).
+ * 
+ * POR QUÉ: Analizar extractos reales además de datos generados.
+ * CÓMO: Se carga en paralelo un segmento de columnas por hilo y luego se
+ *       materializan las personas en una arena nueva, como hace generarDatos.
+ * PARA QUÉ: Que todas las consultas del menú funcionen sobre los datos importados.
+ * @return false si el archivo no se pudo importar; el conjunto anterior se conserva.
+ */
+bool importarDatos(Sesion& sesion, const std::string& archivo) {
+    Monitor& monitor = sesion.monitor;
+    long memoria_inicio = monitor.obtener_memoria();
+    monitor.iniciar_tiempo();
+    
+    SegmentosPersona columnas;
+    EstadisticasCsv lectura;
+    std::string error;
+    if (!importarPersonasCsvParalelo(archivo, sesion.hilos, columnas, lectura, error)) {
+        std::cout << "Error al importar " << archivo << ": " << error << "\n";
+        return false;
+    }
+    
+    auto nuevo = std::make_shared<ConjuntoDatos>();
+    nuevo->personas.reserve(columnas.tamano());
+    for (const auto& segmento : columnas.segmentos) {
+        for (size_t i = 0; i < segmento.tamano(); ++i) {
+            nuevo->personas.push_back(segmento.materializar(i, nuevo->arena.get()));
+        }
+    }
+    prepararPaginas(*nuevo);
+    nuevo->muestra.agregar(nuevo->personas);
+    sesion.datos.publicar(std::move(nuevo));
+    sesion.incremental.reset();
+    sesion.personasDesactualizadas = false;
+    
+    double tiempo_imp = monitor.detener_tiempo();
+    long memoria_imp = monitor.obtener_memoria() - memoria_inicio;
+    
+    std::cout << "Importadas " << lectura.filas << " personas (" << lectura.bytes / 1024 << " KB) en "
+              << tiempo_imp << " ms, lectura: " << static_cast<long>(lectura.filasPorSegundo())
+              << " filas/s con " << columnas.segmentos.size() << " segmentos, Memoria: "
+              << memoria_imp << " KB\n";
+    
+    monitor.establecer_tamano(lectura.filas);
+    monitor.registrar("Importar CSV", tiempo_imp, memoria_imp);
+    return true;
+}
+
+/**
+ * Copia el conjunto incremental a la colección de la sesión si tiene cambios pendientes.
+ * 
+ * POR QUÉ: Las consultas originales, la exportación y la comparación de layouts
+ *          recorren la colección publicada, que no se toca en cada cambio.
+ * CÓMO: Materializa el conjunto incremental en una versión nueva, en el orden de
+ *       carga, con el mismo número de versión que el último lote, y la publica.
+ * PARA QUÉ: Pagar la copia completa una vez por lote y solo si se usa una opción que
+ *           la necesita; las consultas mantenidas no esperan por ella.
+ */
+void sincronizarPersonas(Sesion& sesion) {
+    if (!sesion.personasDesactualizadas) return;
+    auto nuevo = std::make_shared<ConjuntoDatos>();
+    nuevo->personas = sesion.incremental->materializar(nuevo->arena.get());
+    nuevo->version = sesion.version;
+    prepararPaginas(*nuevo);
+    nuevo->muestra.agregar(nuevo->personas);
+    sesion.monitor.establecer_tamano(nuevo->personas.size());
+    sesion.datos.publicar(std::move(nuevo));
+    sesion.personasDesactualizadas = false;
+}
+
+// Un lote puede dar de baja todas las filas del conjunto incremental; entonces
+// sus máximos son nullptr
+void mostrarSiExiste(const Persona* persona) {
+    if (persona) {
+        persona->mostrar();
+    } else {
+        std::cout << "sin datos\n";
+    }
+}
+
+/**
+ * Aplica un lote de cambios aleatorios y muestra las consultas mantenidas (opción 27).
+ * 
+ * POR QUÉ: Las novedades diarias son altas, correcciones y bajas sueltas; regenerar
+ *          o recorrer todo el conjunto por cada lote no es aceptable.
+ * CÓMO: El primer lote indexa el conjunto vigente en un ConjuntoIncremental; cada
+ *       cambio actualiza solo los árboles y totales de su ciudad y grupo. Se miden
+ *       por separado la indexación y el lote.
+ * PARA QUÉ: Responder máximos, totales y el listado por umbral justo después del lote.
+ */
+void aplicarCambios(Sesion& sesion, size_t n) {
+    if (!hayDatos(sesion)) {
+        std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
+        return;
+    }
+    Monitor& monitor = sesion.monitor;
+    if (!sesion.incremental) {
         long memoria_inicio = monitor.obtener_memoria();
-        
-        switch(opcion) {
-            case 0: { // Crear nuevo conjunto de datos
-                int n;
-                std::cout << "\nIngrese el número de personas a generar: ";
-                std::cin >> n;
-                if(!std::cin){
-                std::cin.clear();
-                std::cin.ignore();
-                continue;
-                }
-                monitor.iniciar_tiempo();
-                
-                if (n <= 0) {
-                    std::cout << "Error: Debe generar al menos 1 persona\n";
-                    break;
-                }
-                
-                // Generar el nuevo conjunto de personas
-                auto nuevasPersonas = generarColeccion(n);
-                tam = nuevasPersonas.size();
-                
-                // Mover el conjunto al puntero inteligente (propiedad única)
-                personas = std::make_unique<std::vector<Persona>>(std::move(nuevasPersonas));
-                
-                // Medir tiempo y memoria usada
-                double tiempo_gen = monitor.detener_tiempo();
-                long memoria_gen = monitor.obtener_memoria() - memoria_inicio;
-                
-                std::cout << "Generadas " << tam << " personas en " 
-                          << tiempo_gen << " ms, Memoria: " << memoria_gen << " KB\n";
-                
-                // Registrar la operación
-                monitor.registrar("Crear datos", tiempo_gen, memoria_gen);
-                break;
+        monitor.iniciar_tiempo();
+        sesion.incremental = std::make_unique<ConjuntoIncremental>();
+        sesion.incremental->cargar(sesion.datos.fijar()->personas);
+        double tiempo_idx = monitor.detener_tiempo();
+        long memoria_idx = monitor.obtener_memoria() - memoria_inicio;
+        std::cout << "Indexadas " << sesion.incremental->tamano() << " personas en " << tiempo_idx
+                  << " ms, Memoria: " << memoria_idx << " KB\n";
+        monitor.registrar("Indexar conjunto incremental", tiempo_idx, memoria_idx);
+    }
+    
+    long memoria_inicio = monitor.obtener_memoria();
+    monitor.iniciar_tiempo();
+    ResumenCambios resumen = aplicarCambiosAleatorios(*sesion.incremental, n);
+    sesion.personasDesactualizadas = true;
+    sesion.version = nuevaVersion();
+    double tiempo_cam = monitor.detener_tiempo();
+    long memoria_cam = monitor.obtener_memoria() - memoria_inicio;
+    
+    const ConjuntoIncremental& conjunto = *sesion.incremental;
+    std::cout << "Aplicados " << n << " cambios (" << resumen.altas << " altas, " << resumen.actualizaciones
+              << " actualizaciones, " << resumen.bajas << " bajas) en " << tiempo_cam << " ms, "
+              << static_cast<long>(tiempo_cam > 0 ? n / (tiempo_cam / 1000.0) : 0) << " cambios/s, Memoria: "
+              << memoria_cam << " KB\n";
+    std::cout << "Personas: " << conjunto.tamano() << "\n";
+    auto mostrarExtremo = [](const char* titulo, const Persona* persona) {
+        std::cout << "\n" << titulo << ":\n";
+        mostrarSiExiste(persona);
+    };
+    mostrarExtremo("Persona más longeva del país", conjunto.longevaPais());
+    mostrarExtremo("Persona con mayor patrimonio del país", conjunto.mayorPatrimonioPais());
+    mostrarExtremo("Persona con mayor endeudamiento del país", conjunto.mayorDeudaPais());
+    auto ciudadRica = conjunto.ciudadMayorPatrimonio();
+    std::cout << "\nCiudad con mayor patrimonio: " << ciudadRica.first << " = " << ciudadRica.second << "\n";
+    std::cout << "Personas con patrimonio superior a 1.000 millones: " << conjunto.cantidadMayorUmbral() << "\n";
+    
+    monitor.establecer_tamano(conjunto.tamano());
+    monitor.registrar("Cambios incrementales", tiempo_cam, memoria_cam);
+}
+
+/**
+ * Empieza a generar un conjunto nuevo en segundo plano (opciones 0 y 28).
+ * 
+ * POR QUÉ: Con la recarga nocturna en primer plano, las consultas esperaban minutos,
+ *          y la opción 0 bloqueaba el menú sin avisar cuánto faltaba.
+ * CÓMO: Un hilo genera la versión nueva por bloques de filas, actualiza el contador
+ *       de progreso tras cada bloque y revisa si se pidió cancelar. Sin parcial, la
+ *       publica al terminar y hasta entonces las consultas siguen fijando la versión
+ *       actual; una cancelación la descarta. Con parcial, publica una copia de lo
+ *       generado cada vez que las filas se duplican (desde 1/64 del total), así que
+ *       copiar cuesta menos que una generación completa; al terminar o cancelar
+ *       publica las filas generadas sin copiarlas. Los cambios incrementales
+ *       pendientes se publican antes, porque la recarga reemplaza ese estado.
+ * PARA QUÉ: Que la latencia de las consultas no dependa de las recargas y poder
+ *           consultar una población grande mientras se construye.
+ * @param parcial Publicar los segmentos ya generados (opción 0 y --background).
+ * @return false si ya hay una recarga en curso.
+ */
+bool iniciarRecarga(Sesion& sesion, int n, bool parcial) {
+    if (sesion.recarga) {
+        std::cout << "Ya hay una recarga en curso.\n";
+        return false;
+    }
+    if (n <= 0) {
+        std::cout << "Error: Debe generar al menos 1 persona\n";
+        return false;
+    }
+    sincronizarPersonas(sesion);
+    sesion.incremental.reset();
+    
+    auto recarga = std::make_unique<RecargaEnCurso>();
+    recarga->memoriaInicio = sesion.monitor.obtener_memoria();
+    recarga->total = static_cast<size_t>(n);
+    recarga->parcial = parcial;
+    RecargaEnCurso* estado = recarga.get();
+    PublicadorDatos* datos = &sesion.datos;
+    recarga->hilo = std::thread([estado, datos]() {
+        const size_t BLOQUE = 16384;   // Filas entre revisiones de progreso y cancelación
+        auto nuevo = std::make_shared<ConjuntoDatos>();
+        nuevo->personas.reserve(estado->total);
+        size_t siguientePublicacion = std::max<size_t>(estado->total / 64, BLOQUE);
+        while (nuevo->personas.size() < estado->total && !estado->cancelar.load(std::memory_order_relaxed)) {
+            size_t fin = std::min(estado->total, nuevo->personas.size() + BLOQUE);
+            size_t desde = nuevo->personas.size();
+            while (nuevo->personas.size() < fin) nuevo->personas.push_back(generarPersona(nuevo->arena.get()));
+            nuevo->muestra.agregar(nuevo->personas, desde);
+            estado->generadas.store(fin, std::memory_order_relaxed);
+            if (estado->parcial && fin >= siguientePublicacion && fin < estado->total) {
+                // Las copias guardan sus textos fuera de la arena, así esta puede seguir creciendo
+                auto segmento = std::make_shared<ConjuntoDatos>();
+                segmento->personas.assign(nuevo->personas.begin(), nuevo->personas.end());
+                segmento->muestra = nuevo->muestra;
+                prepararPaginas(*segmento);
+                datos->publicar(std::move(segmento));
+                estado->consultables.store(fin, std::memory_order_relaxed);
+                siguientePublicacion = fin * 2;
             }
-                
-            case 1: { // Mostrar resumen de todas las personas
-                if (!personas || personas->empty()) {
-                    std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
-                    break;
-                }
-                
-                tam = personas->size();
-                std::cout << "\n=== RESUMEN DE PERSONAS (" << tam << ") ===\n";
-                for(size_t i = 0; i < tam; ++i) {
-                    std::cout << i << ". ";
-                    (*personas)[i].mostrarResumen();
-                    std::cout << "\n";
-                }
-                
-                double tiempo_mostrar = monitor.detener_tiempo();
-                long memoria_mostrar = monitor.obtener_memoria() - memoria_inicio;
-                monitor.registrar("Mostrar resumen", tiempo_mostrar, memoria_mostrar);
+        }
+        estado->filas = nuevo->personas.size();
+        bool cancelada = estado->filas < estado->total;
+        if ((!cancelada || estado->parcial) && estado->filas > 0) {
+            prepararPaginas(*nuevo);
+            datos->publicar(std::move(nuevo));
+            estado->consultables.store(estado->filas, std::memory_order_relaxed);
+        }
+        estado->milisegundos = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - estado->inicio).count();
+        estado->terminada.store(true, std::memory_order_release);
+    });
+    sesion.recarga = std::move(recarga);
+    if (parcial) {
+        std::cout << "Generación de " << n << " personas iniciada; los segmentos generados se pueden consultar "
+                  << "mientras avanza (opción 29: progreso, 30: cancelar).\n";
+    } else {
+        std::cout << "Recarga de " << n << " personas iniciada; las consultas siguen sobre la versión actual.\n";
+    }
+    return true;
+}
+
+/**
+ * Muestra el avance de la generación en segundo plano (opción 29).
+ * 
+ * La velocidad es la media desde el inicio y el tiempo restante supone que se mantiene.
+ */
+void mostrarProgreso(const Sesion& sesion) {
+    if (!sesion.recarga) {
+        std::cout << "No hay una generación en segundo plano.\n";
+        return;
+    }
+    const RecargaEnCurso& recarga = *sesion.recarga;
+    size_t generadas = recarga.generadas.load(std::memory_order_relaxed);
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - recarga.inicio).count();
+    double filasPorSegundo = segundos > 0 ? generadas / segundos : 0;
+    std::cout << "Generación en segundo plano: " << generadas << "/" << recarga.total << " ("
+              << 100.0 * generadas / recarga.total << "%), " << static_cast<long>(filasPorSegundo) << " filas/s, ";
+    if (filasPorSegundo > 0) {
+        std::cout << "faltan " << (recarga.total - generadas) / filasPorSegundo << " s";
+    } else {
+        std::cout << "tiempo restante desconocido";
+    }
+    if (recarga.parcial) std::cout << ", consultables: " << recarga.consultables.load(std::memory_order_relaxed);
+    if (recarga.cancelar.load(std::memory_order_relaxed)) std::cout << " (cancelando)";
+    std::cout << "\n";
+}
+
+/**
+ * Recoge la recarga en segundo plano si ya terminó (o la espera si esperar es true)
+ * y la registra en el monitor.
+ */
+void recogerRecarga(Sesion& sesion, bool esperar) {
+    if (!sesion.recarga) return;
+    if (!esperar && !sesion.recarga->terminada.load(std::memory_order_acquire)) return;
+    sesion.recarga->hilo.join();
+    
+    const RecargaEnCurso& recarga = *sesion.recarga;
+    long memoria_rec = sesion.monitor.obtener_memoria() - recarga.memoriaInicio;
+    bool cancelada = recarga.filas < recarga.total;
+    std::cout << (recarga.parcial ? "Generación" : "Recarga") << (cancelada ? " cancelada: " : " terminada: ")
+              << recarga.filas << " personas en " << recarga.milisegundos << " ms, Memoria: " << memoria_rec
+              << " KB, versiones en memoria: " << ConjuntoDatos::vivas().load() << "\n";
+    if (cancelada && (!recarga.parcial || recarga.filas == 0)) {
+        std::cout << "Se conserva la versión anterior.\n";
+    } else {
+        sesion.monitor.establecer_tamano(recarga.filas);
+    }
+    sesion.monitor.registrar(recarga.parcial ? "Crear datos (segundo plano)" : "Recarga en segundo plano",
+                             recarga.milisegundos, memoria_rec);
+    sesion.recarga.reset();
+}
+
+/**
+ * Pide cancelar la generación en segundo plano y espera a que el hilo se detenga
+ * (opción 30). Con publicación parcial quedan las filas ya generadas.
+ */
+void cancelarRecarga(Sesion& sesion) {
+    if (!sesion.recarga) {
+        std::cout << "No hay una generación en segundo plano.\n";
+        return;
+    }
+    sesion.recarga->cancelar.store(true, std::memory_order_relaxed);
+    recogerRecarga(sesion, true);
+}
+
+/**
+ * Escribe el conjunto de la sesión en un CSV (opción 24).
+ * 
+ * POR QUÉ: Guardar una población generada para reutilizarla.
+ * CÓMO: Con exportarPersonasCsv, registrando la medición en el monitor.
+ * PARA QUÉ: Reproducir un análisis o llevar los datos a otra herramienta.
+ */
+bool exportarDatos(Sesion& sesion, const std::string& archivo) {
+    sincronizarPersonas(sesion);
+    auto vigente = sesion.datos.fijar();
+    if (!vigente || vigente->personas.empty()) {
+        std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
+        return false;
+    }
+    Monitor& monitor = sesion.monitor;
+    long memoria_inicio = monitor.obtener_memoria();
+    monitor.iniciar_tiempo();
+    
+    EstadisticasCsv escritura;
+    if (!exportarPersonasCsv(vigente->personas, archivo, escritura)) {
+        std::cout << "Error al escribir " << archivo << "\n";
+        return false;
+    }
+    
+    double tiempo_exp = monitor.detener_tiempo();
+    long memoria_exp = monitor.obtener_memoria() - memoria_inicio;
+    std::cout << "Exportadas " << escritura.filas << " personas (" << escritura.bytes / 1024 << " KB) a "
+              << archivo << " en " << tiempo_exp << " ms, "
+              << static_cast<long>(escritura.filasPorSegundo()) << " filas/s\n";
+    monitor.registrar("Exportar CSV", tiempo_exp, memoria_exp);
+    return true;
+}
+
+/**
+ * Ejecuta el reporte completo leyendo un CSV por segmentos (opción 26).
+ * 
+ * POR QUÉ: Los archivos más grandes que la RAM no se pueden importar a la sesión.
+ * CÓMO: Con reporteFueraDeMemoria y el presupuesto de memoria de la sesión; el
+ *       conjunto cargado en la sesión no se modifica.
+ * PARA QUÉ: Obtener las mismas respuestas del menú sobre cualquier tamaño de archivo.
+ */
+bool reporteSegmentado(Sesion& sesion, const std::string& archivo) {
+    Monitor& monitor = sesion.monitor;
+    long memoria_inicio = monitor.obtener_memoria();
+    monitor.iniciar_tiempo();
+    
+    EstadoAgregado estado;
+    EstadisticasCsv lectura;
+    std::string error;
+    if (!reporteFueraDeMemoria(archivo, sesion.presupuestoMemoria, estado, lectura, error)) {
+        std::cout << "Error al procesar " << archivo << ": " << error << "\n";
+        return false;
+    }
+    mostrarReporte(estado);
+    
+    double tiempo_rep = monitor.detener_tiempo();
+    long memoria_rep = monitor.obtener_memoria() - memoria_inicio;
+    std::cout << "Procesadas " << lectura.filas << " personas en segmentos de "
+              << (sesion.presupuestoMemoria >> 20) << " MB, " << tiempo_rep << " ms, "
+              << static_cast<long>(lectura.filasPorSegundo()) << " filas/s, Memoria: "
+              << memoria_rep << " KB\n";
+    monitor.registrar("Reporte por segmentos", tiempo_rep, memoria_rep);
+    return true;
+}
+
+/**
+ * Ejecuta el reporte completo con las filas repartidas por nodo NUMA (--numa).
+ * 
+ * POR QUÉ: En un servidor de varios sockets el conjunto generado queda en el nodo
+ *          del hilo que lo escribió y los demás nodos lo leen de forma remota.
+ * CÓMO: Copia la versión publicada a un ConjuntoNuma (un trozo de columnas por hilo,
+ *       cada uno escrito desde su nodo) y calcula el reporte R veces con hilos
+ *       fijados al nodo de su trozo; la partición y cada reporte se miden aparte.
+ * PARA QUÉ: Comparar el reporte con y sin ubicación por nodo en la misma máquina.
+ */
+void reporteNuma(Sesion& sesion, unsigned hilosPorNodo, int repeticiones) {
+    Monitor& monitor = sesion.monitor;
+    sincronizarPersonas(sesion);
+    auto vigente = sesion.datos.fijar();
+    if (!vigente || vigente->personas.empty()) {
+        std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
+        return;
+    }
+    std::vector<NodoNuma> nodos = topologiaNuma();
+
+    long memoria_inicio = monitor.obtener_memoria();
+    monitor.iniciar_tiempo();
+    ConjuntoNuma conjunto;
+    conjunto.construir(vigente->personas, nodos, hilosPorNodo);
+    double tiempo_part = monitor.detener_tiempo();
+    long memoria_part = monitor.obtener_memoria() - memoria_inicio;
+    monitor.registrar("Particionar por nodo NUMA", tiempo_part, memoria_part);
+
+    std::vector<size_t> filas = conjunto.filasPorNodo();
+    std::cout << "Topología: " << nodos.size() << " nodo(s), " << conjunto.hilos() << " hilo(s)\n";
+    for (size_t k = 0; k < nodos.size(); ++k) {
+        std::cout << "  nodo " << nodos[k].id << ": " << nodos[k].cpus.size() << " procesador(es), "
+                  << filas[k] << " filas\n";
+    }
+
+    std::string nombre = "Reporte completo (NUMA, " + std::to_string(conjunto.nodos()) + " nodos, " +
+                         std::to_string(conjunto.hilos()) + " hilos)";
+    for (int r = 0; r < repeticiones; ++r) {
+        memoria_inicio = monitor.obtener_memoria();
+        monitor.iniciar_tiempo();
+        EstadoAgregado estado;
+        conjunto.reporte(estado);
+        mostrarReporte(estado);
+        double tiempo_rep = monitor.detener_tiempo();
+        long memoria_rep = monitor.obtener_memoria() - memoria_inicio;
+        std::cout << "Reporte NUMA sobre " << conjunto.tamano() << " personas: " << tiempo_rep
+                  << " ms, Memoria: " << memoria_rep << " KB\n";
+        monitor.registrar(nombre, tiempo_rep, memoria_rep);
+    }
+}
+
+/**
+ * Ejecuta el reporte completo sobre un conjunto virtual (--virtual).
+ * 
+ * POR QUÉ: Probar las consultas con más filas de las que caben en memoria.
+ * CÓMO: Con reporteVirtual, en las tareas del planificador si la sesión tiene uno;
+ *       el listado por umbral guarda solo las listado personas de mayor patrimonio
+ *       de cada ciudad, así la memoria medida no crece con el número de filas.
+ * PARA QUÉ: Llevar el motor de consultas a mil millones de filas en cualquier máquina.
+ */
+void reporteVirtualSesion(Sesion& sesion, uint64_t filas, uint64_t semilla, double umbral, size_t listado) {
+    Monitor& monitor = sesion.monitor;
+    long memoria_inicio = monitor.obtener_memoria();
+    monitor.iniciar_tiempo();
+    
+    ConjuntoVirtual conjunto(semilla, filas);
+    EstadoAgregado estado;
+    estado.umbral = umbral;
+    estado.limiteListado = listado;
+    reporteVirtual(conjunto, sesion.planificador.get(), sesion.grano, estado);
+    mostrarReporte(estado);
+    
+    double tiempo_rep = monitor.detener_tiempo();
+    long memoria_rep = monitor.obtener_memoria() - memoria_inicio;
+    std::cout << "Reporte virtual sobre " << filas << " personas (semilla " << semilla << "): " << tiempo_rep
+              << " ms, " << static_cast<long long>(filas / (tiempo_rep / 1000.0)) << " filas/s, Memoria: "
+              << memoria_rep << " KB\n";
+    monitor.establecer_tamano(filas);
+    monitor.registrar("Reporte completo (virtual)", tiempo_rep, memoria_rep);
+}
+
+/**
+ * Ejecuta el reporte aproximado sobre la muestra de la versión publicada (opción 31
+ * y --approx).
+ * 
+ * POR QUÉ: Un tablero exploratorio no necesita el valor exacto de cada agregado.
+ * CÓMO: Estima los agregados del reporte con la muestra que se llenó al cargar la
+ *       versión (uniforme o estratificada por ciudad), con intervalos del 95%.
+ * PARA QUÉ: Respuestas en milisegundos sin importar el tamaño del conjunto.
+ */
+void reporteAproximado(Sesion& sesion, bool estratificada, double umbral) {
+    Monitor& monitor = sesion.monitor;
+    sincronizarPersonas(sesion);
+    auto vigente = sesion.datos.fijar();
+    if (!vigente || vigente->personas.empty()) {
+        std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
+        return;
+    }
+    long memoria_inicio = monitor.obtener_memoria();
+    monitor.iniciar_tiempo();
+    mostrarReporteAproximado(vigente->muestra, estratificada, umbral);
+    double tiempo_rep = monitor.detener_tiempo();
+    long memoria_rep = monitor.obtener_memoria() - memoria_inicio;
+    std::cout << "Reporte aproximado con " << vigente->muestra.filasMuestra(estratificada) << " filas de muestra: "
+              << tiempo_rep << " ms, Memoria: " << memoria_rep << " KB\n";
+    monitor.establecer_tamano(vigente->personas.size());
+    monitor.registrar(estratificada ? "Reporte aproximado (estratificado)" : "Reporte aproximado (uniforme)",
+                      tiempo_rep, memoria_rep);
+}
+
+/**
+ * Calcula la mediana, el p90 y el p99 por ciudad y por grupo (opción 32 y --quantiles).
+ * 
+ * POR QUÉ: Las consultas solo daban extremos y ordenar millones de montos por
+ *          ciudad para sacar percentiles es lento y ocupa tanto como los datos.
+ * CÓMO: Con calcularCuantiles (sketches KLL), en las tareas del planificador si la
+ *       sesión tiene uno; la memoria de los resúmenes no crece con las filas.
+ * PARA QUÉ: Conocer la distribución de la riqueza en una pasada sobre los datos.
+ */
+void reporteCuantiles(Sesion& sesion) {
+    Monitor& monitor = sesion.monitor;
+    sincronizarPersonas(sesion);
+    auto vigente = sesion.datos.fijar();
+    if (!vigente || vigente->personas.empty()) {
+        std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
+        return;
+    }
+    long memoria_inicio = monitor.obtener_memoria();
+    monitor.iniciar_tiempo();
+    EstadoCuantiles estado;
+    calcularCuantiles(vigente->personas, sesion.planificador.get(), sesion.grano, estado);
+    mostrarCuantiles(estado);
+    double tiempo_rep = monitor.detener_tiempo();
+    long memoria_rep = monitor.obtener_memoria() - memoria_inicio;
+    std::cout << "Percentiles sobre " << estado.filas << " personas: " << tiempo_rep << " ms, Memoria: "
+              << memoria_rep << " KB\n";
+    monitor.establecer_tamano(estado.filas);
+    monitor.registrar("Percentiles por ciudad y grupo (KLL)", tiempo_rep, memoria_rep);
+}
+
+/**
+ * Estima los nombres completos y los pares de apellidos distintos por ciudad
+ * (opción 33 y --distinct).
+ * 
+ * POR QUÉ: Detectar identidades duplicadas con un conjunto de textos por ciudad
+ *          ocupa memoria proporcional a la población.
+ * CÓMO: Con calcularDistintos (HyperLogLog), en las tareas del planificador si la
+ *       sesión tiene uno; cada ciudad ocupa unos pocos KB con cualquier población.
+ * PARA QUÉ: Ver junto a los reportes por ciudad cuántas personas repiten nombre.
+ */
+void reporteDistintos(Sesion& sesion) {
+    Monitor& monitor = sesion.monitor;
+    sincronizarPersonas(sesion);
+    auto vigente = sesion.datos.fijar();
+    if (!vigente || vigente->personas.empty()) {
+        std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
+        return;
+    }
+    long memoria_inicio = monitor.obtener_memoria();
+    monitor.iniciar_tiempo();
+    EstadoDistintos estado;
+    calcularDistintos(vigente->personas, sesion.planificador.get(), sesion.grano, estado);
+    mostrarDistintos(estado);
+    double tiempo_rep = monitor.detener_tiempo();
+    long memoria_rep = monitor.obtener_memoria() - memoria_inicio;
+    std::cout << "Distintos sobre " << estado.filas << " personas: " << tiempo_rep << " ms, Memoria: "
+              << memoria_rep << " KB\n";
+    monitor.establecer_tamano(estado.filas);
+    monitor.registrar("Nombres distintos por ciudad (HyperLogLog)", tiempo_rep, memoria_rep);
+}
+
+/**
+ * Calcula una opción del menú sobre la colección de la sesión.
+ * 
+ * POR QUÉ: Las mismas consultas se piden desde el menú o desde --run.
+ * CÓMO: Mide tiempo y memoria alrededor de la opción y la registra en el monitor.
+ * PARA QUÉ: Que ambos modos produzcan estadísticas comparables.
+ * @param vigente Versión fijada por quien llama; sigue válida aunque se publique otra.
+ */
+void calcularOpcion(int opcion, Sesion& sesion, const ConjuntoDatos* vigente) {
+    const std::vector<Persona>* personas = vigente ? &vigente->personas : nullptr;
+    Monitor& monitor = sesion.monitor;
+    std::pmr::memory_resource* temporal = sesion.arenaConsulta.recurso();
+    
+    // Variables locales para uso en los casos
+    size_t tam = 0;
+    std::string idBusqueda;
+    
+    // Iniciar medición de tiempo y memoria para la operación actual
+    monitor.iniciar_tiempo();
+    long memoria_inicio = monitor.obtener_memoria();
+    
+    switch(opcion) {
+        case 1: { // Mostrar resumen de todas las personas
+            if (!personas || personas->empty()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
                 break;
             }
-                
-            case 2: { // Buscar por ID
-                if (!personas || personas->empty()) {
-                    std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
-                    break;
-                }                
-                
-                if(const Persona* encontrada = buscarLongevaPaisReferencia(*personas)) {
-                    encontrada->mostrar();
-                } else {
-                    std::cout << "No se encontró persona con ID " << idBusqueda << "\n";
-                }
-                
-                double tiempo_busqueda = monitor.detener_tiempo();
-                long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
-                monitor.registrar("Mostrar personas más longeva del país(Referencia)", tiempo_busqueda, memoria_busqueda);
-                break;
+            
+            tam = personas->size();
+            std::cout << "\n=== RESUMEN DE PERSONAS (" << tam << ") ===\n";
+            for(size_t i = 0; i < tam; ++i) {
+                std::cout << i << ". ";
+                (*personas)[i].mostrarResumen();
+                std::cout << "\n";
             }
-            case 3: {
-                if (!personas || personas->empty()) {
-                    std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
-                    break;
-                }                
-
-                Persona encontrada = buscarLongevaPaisValor(*personas);
-                encontrada.mostrar();
             
-                double tiempo_busqueda = monitor.detener_tiempo();
-                long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
-                monitor.registrar("Mostrar personas más longeva del país(Valor)", tiempo_busqueda, memoria_busqueda);
+            double tiempo_mostrar = monitor.detener_tiempo();
+            long memoria_mostrar = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Mostrar resumen", tiempo_mostrar, memoria_mostrar);
+            break;
+        }
+            
+        case 2: { // Buscar por ID
+            if (!personas || personas->empty()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
                 break;
+            }                
+            
+            if(const Persona* encontrada = buscarLongevaPaisReferencia(*personas)) {
+                encontrada->mostrar();
+            } else {
+                std::cout << "No se encontró persona con ID " << idBusqueda << "\n";
             }
-            case 4: {
-                if (!personas || personas->empty()) {
-                    std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
-                    break;
-                }                
-
-                std::unordered_map<std::string,const Persona*> resultado = mostrarPersonasLongevasCiudadReferencia(*personas);
-                for (const auto &pair : resultado)
-                {
-                    std::cout <<"\n" << pair.first << ":";
-                    pair.second->mostrar();
-                }
-                
             
-                double tiempo_busqueda = monitor.detener_tiempo();
-                long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
-                monitor.registrar("Mostrar personas mas longevas por ciudad (Referencia)", tiempo_busqueda, memoria_busqueda);
+            double tiempo_busqueda = monitor.detener_tiempo();
+            long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Mostrar personas más longeva del país(Referencia)", tiempo_busqueda, memoria_busqueda);
+            break;
+        }
+        case 3: {
+            if (!personas || personas->empty()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
+                break;
+            }                
+
+            Persona encontrada = buscarLongevaPaisValor(*personas);
+            encontrada.mostrar();
+        
+            double tiempo_busqueda = monitor.detener_tiempo();
+            long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Mostrar personas más longeva del país(Valor)", tiempo_busqueda, memoria_busqueda);
+            break;
+        }
+        case 4: {
+            if (!personas || personas->empty()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
                 break;
+            }                
+
+            auto resultado = mostrarPersonasLongevasCiudadReferencia(*personas, temporal);
+            for (const auto &pair : resultado)
+            {
+                std::cout <<"\n" << pair.first << ":";
+                pair.second->mostrar();
             }
-                
-            case 5: {
-                if (!personas || personas->empty()) {
-                    std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
-                    break;
-                }                
-
-                std::unordered_map<std::string,Persona> resultado = mostrarPersonasLongevasCiudadValor(*personas);
-                for (const auto &pair : resultado)
-                {
-                    std::cout <<"\n" << pair.first << ":";
-                    pair.second.mostrar();
-                }
-                
             
-                double tiempo_busqueda = monitor.detener_tiempo();
-                long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
-                monitor.registrar("Mostrar personas mas longevas por ciudad (Valor)", tiempo_busqueda, memoria_busqueda);
+        
+            double tiempo_busqueda = monitor.detener_tiempo();
+            long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Mostrar personas mas longevas por ciudad (Referencia)", tiempo_busqueda, memoria_busqueda);
+            break;
+        }
+            
+        case 5: {
+            if (!personas || personas->empty()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
                 break;
+            }                
+
+            auto resultado = mostrarPersonasLongevasCiudadValor(*personas);
+            for (const auto &pair : resultado)
+            {
+                std::cout <<"\n" << pair.first << ":";
+                pair.second.mostrar();
             }
-                
-            case 6: { 
-                if (!personas || personas->empty()) {
-                    std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
-                    break;
-                }                
-                
-                if(const Persona* encontrada = buscarMayorPatrimonioPaisReferencia(*personas)) {
-                    encontrada->mostrar();
-                } else {
-                    std::cout << "No se encontró persona " << "\n";
-                }
-                
-                double tiempo_busqueda = monitor.detener_tiempo();
-                long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
-                monitor.registrar("Mostrar personas más rica del país(Referencia)", tiempo_busqueda, memoria_busqueda);
+            
+        
+            double tiempo_busqueda = monitor.detener_tiempo();
+            long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Mostrar personas mas longevas por ciudad (Valor)", tiempo_busqueda, memoria_busqueda);
+            break;
+        }
+            
+        case 6: { 
+            if (!personas || personas->empty()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
                 break;
+            }                
+            
+            if(const Persona* encontrada = buscarMayorPatrimonioPaisReferencia(*personas)) {
+                encontrada->mostrar();
+            } else {
+                std::cout << "No se encontró persona " << "\n";
             }
-            case 7: {
-                if (!personas || personas->empty()) {
-                    std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
-                    break;
-                }                
-
-                Persona encontrada = buscarMayorPatrimonioPaisValor(*personas);
-                encontrada.mostrar();
             
-                double tiempo_busqueda = monitor.detener_tiempo();
-                long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
-                monitor.registrar("Mostrar personas más rica del país(Valor)", tiempo_busqueda, memoria_busqueda);
+            double tiempo_busqueda = monitor.detener_tiempo();
+            long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Mostrar personas más rica del país(Referencia)", tiempo_busqueda, memoria_busqueda);
+            break;
+        }
+        case 7: {
+            if (!personas || personas->empty()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
                 break;
+            }                
+
+            Persona encontrada = buscarMayorPatrimonioPaisValor(*personas);
+            encontrada.mostrar();
+        
+            double tiempo_busqueda = monitor.detener_tiempo();
+            long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Mostrar personas más rica del país(Valor)", tiempo_busqueda, memoria_busqueda);
+            break;
+        }
+        case 8: {
+            if (!personas || personas->empty()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
+                break;
+            }                
+            auto resultado = buscarMayorPatrimonioCiudadReferencia(*personas, temporal);
+            for (const auto &pair : resultado)
+            {
+                std::cout <<"\n" << pair.first << ":";
+                pair.second->mostrar();
             }
-            case 8: {
-                if (!personas || personas->empty()) {
-                    std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
-                    break;
-                }                
-                std::unordered_map<std::string,const Persona*> resultado = buscarMayorPatrimonioCiudadReferencia(*personas);
-                for (const auto &pair : resultado)
-                {
-                    std::cout <<"\n" << pair.first << ":";
-                    pair.second->mostrar();
-                }
-                
             
-                double tiempo_busqueda = monitor.detener_tiempo();
-                long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
-                monitor.registrar("Mostrar personas mas ricas por ciudad (Referencia)", tiempo_busqueda, memoria_busqueda);
+        
+            double tiempo_busqueda = monitor.detener_tiempo();
+            long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Mostrar personas mas ricas por ciudad (Referencia)", tiempo_busqueda, memoria_busqueda);
+            break;
+        }
+        case 9: {
+            if (!personas || personas->empty()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
                 break;
+            }                
+
+            auto resultado = buscarMayorPatrimonioCiudadValor(*personas);
+            for (const auto &pair : resultado)
+            {
+                std::cout <<"\n" << pair.first << ":";
+                pair.second.mostrar();
             }
-            case 9: {
-                if (!personas || personas->empty()) {
-                    std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
-                    break;
-                }                
-
-                std::unordered_map<std::string,Persona> resultado = buscarMayorPatrimonioCiudadValor(*personas);
-                for (const auto &pair : resultado)
-                {
-                    std::cout <<"\n" << pair.first << ":";
-                    pair.second.mostrar();
-                }
-                
-                double tiempo_busqueda = monitor.detener_tiempo();
-                long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
-                monitor.registrar("Mostrar personas mas ricas por ciudad (Valor)", tiempo_busqueda, memoria_busqueda);
+            
+            double tiempo_busqueda = monitor.detener_tiempo();
+            long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Mostrar personas mas ricas por ciudad (Valor)", tiempo_busqueda, memoria_busqueda);
+            break;
+        }
+        case 10: {
+            if (!personas || personas->empty()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
                 break;
+            }                
+            auto resultado = buscarMayorPatrimonioGrupoReferencia(*personas, temporal);
+            for (const auto &pair : resultado)
+            {
+                std::cout <<"\n" << pair.first << ":";
+                pair.second->mostrar();
             }
-            case 10: {
-                if (!personas || personas->empty()) {
-                    std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
-                    break;
-                }                
-                std::unordered_map<std::string,const Persona*> resultado = buscarMayorPatrimonioGrupoReferencia(*personas);
-                for (const auto &pair : resultado)
-                {
-                    std::cout <<"\n" << pair.first << ":";
-                    pair.second->mostrar();
-                }
-                
             
-                double tiempo_busqueda = monitor.detener_tiempo();
-                long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
-                monitor.registrar("Mostrar personas mas ricas por Grupo (Referencia)", tiempo_busqueda, memoria_busqueda);
+        
+            double tiempo_busqueda = monitor.detener_tiempo();
+            long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Mostrar personas mas ricas por Grupo (Referencia)", tiempo_busqueda, memoria_busqueda);
+            break;
+        }
+        case 11: {
+            if (!personas || personas->empty()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
                 break;
+            }                
+
+            auto resultado = buscarMayorPatrimonioGrupoValor(*personas);
+            for (const auto &pair : resultado)
+            {
+                std::cout <<"\n" << pair.first << ":";
+                pair.second.mostrar();
             }
-            case 11: {
-                if (!personas || personas->empty()) {
-                    std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
-                    break;
-                }                
-
-                std::unordered_map<std::string,Persona> resultado = buscarMayorPatrimonioGrupoValor(*personas);
-                for (const auto &pair : resultado)
+            
+            double tiempo_busqueda = monitor.detener_tiempo();
+            long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Mostrar personas mas ricas por Grupo (Valor)", tiempo_busqueda, memoria_busqueda);
+            break;
+        }
+        case 12: {
+            if (!personas || personas->empty()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
+                break;
+            }                
+            auto resultado = listarPersonasGrupoReferencia(*personas, temporal);
+            for (const auto &pair : resultado)
+            {
+                std::cout << "Personas del grupo:" << pair.first << "# de personas:" << pair.second.size() << "\n";
+                for (const auto &persona : pair.second)
                 {
-                    std::cout <<"\n" << pair.first << ":";
-                    pair.second.mostrar();
+                    persona->mostrarResumen();
+                    std::cout << "\n";
                 }
                 
-                double tiempo_busqueda = monitor.detener_tiempo();
-                long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
-                monitor.registrar("Mostrar personas mas ricas por Grupo (Valor)", tiempo_busqueda, memoria_busqueda);
-                break;
             }
-            case 12: {
-                if (!personas || personas->empty()) {
-                    std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
-                    break;
-                }                
-                auto resultado = listarPersonasGrupoReferencia(*personas);
-                for (const auto &pair : resultado)
-                {
-                    std::cout << "Personas del grupo:" << pair.first << "# de personas:" << pair.second.size() << "\n";
-                    for (const auto &persona : pair.second)
-                    {
-                        persona->mostrarResumen();
-                        std::cout << "\n";
-                    }
-                    
-                }
-            
-                double tiempo_busqueda = monitor.detener_tiempo();
-                long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
-                monitor.registrar("Listar personas por Grupo (Referencia)", tiempo_busqueda, memoria_busqueda);
+        
+            double tiempo_busqueda = monitor.detener_tiempo();
+            long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Listar personas por Grupo (Referencia)", tiempo_busqueda, memoria_busqueda);
+            break;
+        }
+        case 13: {
+            if (!personas || personas->empty()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
                 break;
-            }
-            case 13: {
-                if (!personas || personas->empty()) {
-                    std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
-                    break;
-                }                
-                auto resultado = listarPersonasGrupoValor(*personas);
-                for (const auto &pair : resultado)
+            }                
+            auto resultado = listarPersonasGrupoValor(*personas);
+            for (const auto &pair : resultado)
+            {
+                std::cout << "Personas del grupo:" << pair.first << "| # de personas:" << pair.second.size() << "\n";
+                for (const auto &persona : pair.second)
                 {
-                    std::cout << "Personas del grupo:" << pair.first << "| # de personas:" << pair.second.size() << "\n";
-                    for (const auto &persona : pair.second)
-                    {
-                        persona.mostrarResumen();
-                        std::cout << "\n";
-                    }
-                    
-                }
-                double tiempo_busqueda = monitor.detener_tiempo();
-                long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
-                monitor.registrar("Listar personas por grupo (Valor)", tiempo_busqueda, memoria_busqueda);
-                break;
-            }
-            case 14: { 
-                if (!personas || personas->empty()) {
-                    std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
-                    break;
-                }                
-                
-                if(const Persona* encontrada = buscarMayorDeudaPaisReferencia(*personas)) {
-                    encontrada->mostrar();
-                } else {
-                    std::cout << "No se encontró persona " << "\n";
+                    persona.mostrarResumen();
+                    std::cout << "\n";
                 }
                 
-                double tiempo_busqueda = monitor.detener_tiempo();
-                long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
-                monitor.registrar("Mostrar personas más endueduada del país(Referencia)", tiempo_busqueda, memoria_busqueda);
+            }
+            double tiempo_busqueda = monitor.detener_tiempo();
+            long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Listar personas por grupo (Valor)", tiempo_busqueda, memoria_busqueda);
+            break;
+        }
+        case 14: { 
+            if (!personas || personas->empty()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
                 break;
+            }                
+            
+            if(const Persona* encontrada = buscarMayorDeudaPaisReferencia(*personas)) {
+                encontrada->mostrar();
+            } else {
+                std::cout << "No se encontró persona " << "\n";
             }
-            case 15: {
-                if (!personas || personas->empty()) {
-                    std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
-                    break;
-                }                
-
-                Persona encontrada = buscarMayorDeudaPaisValor(*personas);
-                encontrada.mostrar();
             
-                double tiempo_busqueda = monitor.detener_tiempo();
-                long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
-                monitor.registrar("Mostrar personas más endueduada del país(Valor)", tiempo_busqueda, memoria_busqueda);
+            double tiempo_busqueda = monitor.detener_tiempo();
+            long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Mostrar personas más endueduada del país(Referencia)", tiempo_busqueda, memoria_busqueda);
+            break;
+        }
+        case 15: {
+            if (!personas || personas->empty()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
                 break;
-            }
-            case 16: {
-                if (!personas || personas->empty()) {
-                    std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
-                    break;
-                }                
-                auto resultado = buscarCiudadMayorPatrimonioReferencia(*personas);
-                std::cout<< "Ciudad con mayor patrimonio: " << resultado.first << " = " << resultado.second << "\n";
-                
+            }                
+
+            Persona encontrada = buscarMayorDeudaPaisValor(*personas);
+            encontrada.mostrar();
+        
+            double tiempo_busqueda = monitor.detener_tiempo();
+            long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Mostrar personas más endueduada del país(Valor)", tiempo_busqueda, memoria_busqueda);
+            break;
+        }
+        case 16: {
+            if (!personas || personas->empty()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
+                break;
+            }                
+            auto resultado = buscarCiudadMayorPatrimonioReferencia(*personas, temporal);
+            std::cout<< "Ciudad con mayor patrimonio: " << resultado.first << " = " << resultado.second << "\n";
             
-                double tiempo_busqueda = monitor.detener_tiempo();
-                long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
-                monitor.registrar("Mostrar ciudad con mayor patrimonio(Referencia)", tiempo_busqueda, memoria_busqueda);
+        
+            double tiempo_busqueda = monitor.detener_tiempo();
+            long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Mostrar ciudad con mayor patrimonio(Referencia)", tiempo_busqueda, memoria_busqueda);
+            break;
+        }
+        case 17: {
+            if (!personas || personas->empty()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
                 break;
-            }
-            case 17: {
-                if (!personas || personas->empty()) {
-                    std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
-                    break;
-                }                
-                auto resultado = buscarCiudadMayorPatrimonioValor(*personas);
-                std::cout<< "Ciudad con mayor patrimonio: " << resultado.first << " = " << resultado.second << "\n";
-                
+            }                
+            auto resultado = buscarCiudadMayorPatrimonioValor(*personas);
+            std::cout<< "Ciudad con mayor patrimonio: " << resultado.first << " = " << resultado.second << "\n";
             
-                double tiempo_busqueda = monitor.detener_tiempo();
-                long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
-                monitor.registrar("Mostrar ciudad con mayor patrimonio(Valor)", tiempo_busqueda, memoria_busqueda);
+        
+            double tiempo_busqueda = monitor.detener_tiempo();
+            long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Mostrar ciudad con mayor patrimonio(Valor)", tiempo_busqueda, memoria_busqueda);
+            break;
+        }
+        case 18: {
+            if (!personas || personas->empty()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
                 break;
-            }
-            case 18: {
-                if (!personas || personas->empty()) {
-                    std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
-                    break;
-                }                
-                auto resultado = listarPersonasConPatrimonioMayor1000Referencia(*personas);
-                std::cout<< "Personas tienen patrimonio superior a 1.000 millones(Referencia)\n";
-                for (const auto &pair : resultado)
+            }                
+            auto resultado = listarPersonasConPatrimonioMayor1000Referencia(*personas, temporal);
+            std::cout<< "Personas tienen patrimonio superior a 1.000 millones(Referencia)\n";
+            for (const auto &pair : resultado)
+            {
+                std::cout << "Ciudad:" << pair.first << "\n";
+                for (const auto& persona : pair.second)
                 {
-                    std::cout << "Ciudad:" << pair.first << "\n";
-                    for (const auto& persona : pair.second)
-                    {
-                        std::cout<< persona->getNombre()<<" "<<persona->getApellido()<<" Patrimonio: "<<persona->getPatrimonio() <<"\n"; 
-                    }
+                    std::cout<< persona->getNombre()<<" "<<persona->getApellido()<<" Patrimonio: "<<persona->getPatrimonio() <<"\n"; 
                 }
-                double tiempo_busqueda = monitor.detener_tiempo();
-                long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
-                monitor.registrar("Personas tienen patrimonio superior a 1.000 millones(Referencia)", tiempo_busqueda, memoria_busqueda);
-                break;
             }
-            case 19: {
-                if (!personas || personas->empty()) {
-                    std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
-                    break;
-                }                
-                auto resultado = listarPersonasConPatrimonioMayor1000Valor(*personas);
-                std::cout<< "Personas tienen patrimonio superior a 1.000 millones(Valor) "<< "\n";
-                for (const auto &pair : resultado)
+            double tiempo_busqueda = monitor.detener_tiempo();
+            long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Personas tienen patrimonio superior a 1.000 millones(Referencia)", tiempo_busqueda, memoria_busqueda);
+            break;
+        }
+        case 19: {
+            if (!personas || personas->empty()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
+                break;
+            }                
+            auto resultado = listarPersonasConPatrimonioMayor1000Valor(*personas);
+            std::cout<< "Personas tienen patrimonio superior a 1.000 millones(Valor) "<< "\n";
+            for (const auto &pair : resultado)
+            {
+                std::cout << "Ciudad:" << pair.first << "\n";
+                for (const auto& persona : pair.second)
                 {
-                    std::cout << "Ciudad:" << pair.first << "\n";
-                    for (const auto& persona : pair.second)
-                    {
-                        std::cout<< persona.getNombre()<<" "<<persona.getApellido()<<" Patrimonio: "<<persona.getPatrimonio() <<"\n"; 
-                    }
+                    std::cout<< persona.getNombre()<<" "<<persona.getApellido()<<" Patrimonio: "<<persona.getPatrimonio() <<"\n"; 
                 }
+            }
+        
+            double tiempo_busqueda = monitor.detener_tiempo();
+            long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Personas tienen patrimonio superior a 1.000 millones(Valor)", tiempo_busqueda, memoria_busqueda);
+            break;
+        }
+
+        case 20: // Mostrar estadísticas de rendimiento
+            monitor.mostrar_resumen();
+            break;
             
-                double tiempo_busqueda = monitor.detener_tiempo();
-                long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
-                monitor.registrar("Personas tienen patrimonio superior a 1.000 millones(Valor)", tiempo_busqueda, memoria_busqueda);
+        case 21: // Exportar estadísticas a CSV
+            monitor.exportar_csv();
+            break;
+            
+        case 23: { // Mismas consultas instanciadas para cada layout
+            if (!personas || personas->empty()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
                 break;
             }
+            compararLayouts(*personas, monitor);
+            break;
+        }
+            
+        default:
+            std::cout << "Opción inválida!\n";
+    }
+    
+    // Los resultados de la opción ya se destruyeron; se descarta su memoria temporal
+    sesion.arenaConsulta.reiniciar();
+}
 
-            case 20: // Mostrar estadísticas de rendimiento
-                monitor.mostrar_resumen();
-                break;
-                
-            case 21: // Exportar estadísticas a CSV
-                monitor.exportar_csv();
-                break;
-                
-            case 22: // Salir
-                std::cout << "Saliendo...\n";
-                break;
-                
-            default:
-                std::cout << "Opción inválida!\n";
+// Opciones que consultarIncremental puede responder
+bool respondeIncremental(int opcion) {
+    return opcion == 2 || opcion == 4 || opcion == 6 || opcion == 8 || opcion == 10 ||
+           opcion == 14 || opcion == 16 || opcion == 18;
+}
+
+/**
+ * Responde una consulta por referencia con los agregados del conjunto incremental.
+ * 
+ * POR QUÉ: Después de un lote de cambios, la colección de la sesión está vieja y
+ *          copiarla para recorrerla entera es justo lo que se quiere evitar.
+ * CÓMO: Las opciones 2, 4, 6, 8, 10, 14, 16 y 18 leen el máximo, los totales o el
+ *       listado que el ConjuntoIncremental ya mantiene y los imprimen con el mismo
+ *       formato de la opción; se registran con el sufijo "(incremental)".
+ * PARA QUÉ: Refrescar las vistas de los tableros en O(ciudades) tras cada lote.
+ * @return false si la opción no se puede responder así.
+ */
+bool consultarIncremental(int opcion, Sesion& sesion) {
+    const ConjuntoIncremental& conjunto = *sesion.incremental;
+    Monitor& monitor = sesion.monitor;
+    std::pmr::memory_resource* temporal = sesion.arenaConsulta.recurso();
+    std::string nombre;
+    
+    monitor.iniciar_tiempo();
+    long memoria_inicio = monitor.obtener_memoria();
+    
+    // Mismo formato de las opciones 4, 8 y 10
+    auto mostrarPorLlave = [](const MapaPlano<std::string, const Persona*>& resultado) {
+        for (const auto &pair : resultado) {
+            std::cout << "\n" << pair.first << ":";
+            pair.second->mostrar();
+        }
+    };
+    
+    switch (opcion) {
+        case 2:
+            mostrarSiExiste(conjunto.longevaPais());
+            nombre = "Mostrar personas más longeva del país(Referencia)";
+            break;
+        case 4:
+            mostrarPorLlave(conjunto.longevaPorCiudad(temporal));
+            nombre = "Mostrar personas mas longevas por ciudad (Referencia)";
+            break;
+        case 6:
+            mostrarSiExiste(conjunto.mayorPatrimonioPais());
+            nombre = "Mostrar personas más rica del país(Referencia)";
+            break;
+        case 8:
+            mostrarPorLlave(conjunto.mayorPatrimonioPorCiudad(temporal));
+            nombre = "Mostrar personas mas ricas por ciudad (Referencia)";
+            break;
+        case 10:
+            mostrarPorLlave(conjunto.mayorPatrimonioPorGrupo(temporal));
+            nombre = "Mostrar personas mas ricas por Grupo (Referencia)";
+            break;
+        case 14:
+            mostrarSiExiste(conjunto.mayorDeudaPais());
+            nombre = "Mostrar personas más endueduada del país(Referencia)";
+            break;
+        case 16: {
+            auto resultado = conjunto.ciudadMayorPatrimonio();
+            std::cout<< "Ciudad con mayor patrimonio: " << resultado.first << " = " << resultado.second << "\n";
+            nombre = "Mostrar ciudad con mayor patrimonio(Referencia)";
+            break;
+        }
+        case 18: {
+            auto resultado = conjunto.patrimonioMayorUmbral(temporal);
+            std::cout<< "Personas tienen patrimonio superior a 1.000 millones(Referencia)\n";
+            for (const auto &pair : resultado) {
+                std::cout << "Ciudad:" << pair.first << "\n";
+                for (const auto& persona : pair.second) {
+                    std::cout<< persona->getNombre()<<" "<<persona->getApellido()<<" Patrimonio: "<<persona->getPatrimonio() <<"\n";
+                }
+            }
+            nombre = "Personas tienen patrimonio superior a 1.000 millones(Referencia)";
+            break;
+        }
+        default:
+            return false;
+    }
+    
+    double tiempo_consulta = monitor.detener_tiempo();
+    long memoria_consulta = monitor.obtener_memoria() - memoria_inicio;
+    monitor.registrar(nombre + " (incremental)", tiempo_consulta, memoria_consulta);
+    sesion.arenaConsulta.reiniciar();
+    return true;
+}
+
+/**
+ * Responde una consulta por referencia leyendo un segmento de memoria compartida.
+ * 
+ * POR QUÉ: Los procesos de consulta que se adjuntan al conjunto publicado por otro
+ *          no tienen personas propias, solo las columnas del segmento.
+ * CÓMO: Las opciones 2, 4, 6, 8, 10, 14, 16 y 18 usan las consultas de consultas.h
+ *       con LayoutCompartido y materializan solo las personas que se muestran, con
+ *       el mismo formato de la opción; se registran con el sufijo "(compartida)".
+ * PARA QUÉ: Medir y usar varios lectores sobre una sola copia de los datos.
+ * @return false si la opción no se puede responder así.
+ */
+bool consultarCompartido(int opcion, const ConjuntoCompartido& conjunto, Monitor& monitor) {
+    using L = LayoutCompartido;
+    std::string nombre;
+    
+    monitor.iniciar_tiempo();
+    long memoria_inicio = monitor.obtener_memoria();
+    
+    // Mismo formato de las opciones 4, 8 y 10
+    auto mostrarPorLlave = [&](const MapaPlano<L::Clave, size_t>& resultado, bool porCiudad) {
+        for (const auto &pair : resultado) {
+            std::cout << "\n" << (porCiudad ? conjunto.textoCiudad(pair.first) : conjunto.textoGrupo(pair.first)) << ":";
+            conjunto.materializar(pair.second).mostrar();
+        }
+    };
+    
+    switch (opcion) {
+        case 2:
+            conjunto.materializar(longevaPais<L>(conjunto)).mostrar();
+            nombre = "Mostrar personas más longeva del país(Referencia)";
+            break;
+        case 4:
+            mostrarPorLlave(longevaPorCiudad<L>(conjunto), true);
+            nombre = "Mostrar personas mas longevas por ciudad (Referencia)";
+            break;
+        case 6:
+            conjunto.materializar(mayorPatrimonioPais<L>(conjunto)).mostrar();
+            nombre = "Mostrar personas más rica del país(Referencia)";
+            break;
+        case 8:
+            mostrarPorLlave(mayorPatrimonioPorCiudad<L>(conjunto), true);
+            nombre = "Mostrar personas mas ricas por ciudad (Referencia)";
+            break;
+        case 10:
+            mostrarPorLlave(mayorPatrimonioPorGrupo<L>(conjunto), false);
+            nombre = "Mostrar personas mas ricas por Grupo (Referencia)";
+            break;
+        case 14:
+            conjunto.materializar(mayorDeudaPais<L>(conjunto)).mostrar();
+            nombre = "Mostrar personas más endueduada del país(Referencia)";
+            break;
+        case 16: {
+            auto resultado = ciudadMayorPatrimonio<L>(conjunto);
+            std::cout<< "Ciudad con mayor patrimonio: " << conjunto.textoCiudad(resultado.first) << " = " << resultado.second << "\n";
+            nombre = "Mostrar ciudad con mayor patrimonio(Referencia)";
+            break;
+        }
+        case 18: {
+            auto resultado = listarPatrimonioMayor<L>(conjunto, 1000000000.0);
+            std::cout<< "Personas tienen patrimonio superior a 1.000 millones(Referencia)\n";
+            for (const auto &pair : resultado) {
+                std::cout << "Ciudad:" << conjunto.textoCiudad(pair.first) << "\n";
+                for (size_t i : pair.second) {
+                    std::cout<< conjunto.textoNombre(conjunto.nombre()[i])<<" "<<conjunto.textoApellido(conjunto.apellido()[i])<<" Patrimonio: "<<conjunto.patrimonio()[i] <<"\n";
+                }
+            }
+            nombre = "Personas tienen patrimonio superior a 1.000 millones(Referencia)";
+            break;
+        }
+        default:
+            return false;
+    }
+    
+    double tiempo_consulta = monitor.detener_tiempo();
+    long memoria_consulta = monitor.obtener_memoria() - memoria_inicio;
+    monitor.registrar(nombre + " (compartida)", tiempo_consulta, memoria_consulta);
+    return true;
+}
+
+/**
+ * Responde una consulta por referencia repartiendo las filas (procesos.h).
+ * 
+ * POR QUÉ: Comparar procesos hijos y tareas con robo de trabajo contra el recorrido
+ *          en un solo hilo con las mismas opciones y el mismo formato de salida.
+ * CÓMO: Con procesos > 0 usa consultaMultiproceso; si no, consultaConTareas con el
+ *       planificador de la sesión. Ambas devuelven índices de fila del conjunto
+ *       vigente, que se imprimen como en la opción; se registra con el sufijo
+ *       "(N procesos)" o "(N hilos, tareas)".
+ * PARA QUÉ: Reportes largos aislados de fallos o independientes del sesgo.
+ * @return false si la opción no se puede responder así o algún hijo falló.
+ */
+bool consultarParticionado(int opcion, Sesion& sesion, unsigned procesos) {
+    sincronizarPersonas(sesion);
+    auto vigente = sesion.datos.fijar();
+    if (!vigente || vigente->personas.empty()) {
+        std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
+        return false;
+    }
+    const std::vector<Persona>& personas = vigente->personas;
+    Monitor& monitor = sesion.monitor;
+    
+    monitor.iniciar_tiempo();
+    long memoria_inicio = monitor.obtener_memoria();
+    ResultadoParticionado resultado;
+    std::string error;
+    std::string sufijo;
+    if (procesos > 0) {
+        if (!consultaMultiproceso(opcion, personas, procesos, resultado, error)) {
+            monitor.detener_tiempo();
+            std::cerr << error << "\n";
+            return false;
+        }
+        sufijo = " (" + std::to_string(resultado.partes) + " procesos)";
+    } else {
+        consultaConTareas(opcion, personas, *sesion.planificador, sesion.grano, resultado);
+        sufijo = " (" + std::to_string(sesion.planificador->hilos()) + " hilos, tareas)";
+    }
+    
+    // Mismo formato de las opciones 4, 8 y 10
+    auto mostrarPorLlave = [&]() {
+        for (const auto &pair : resultado.porLlave) {
+            std::cout << "\n" << pair.first << ":";
+            personas[pair.second].mostrar();
+        }
+    };
+    
+    std::string nombre;
+    switch (opcion) {
+        case 2:
+            personas[resultado.fila].mostrar();
+            nombre = "Mostrar personas más longeva del país(Referencia)";
+            break;
+        case 4:
+            mostrarPorLlave();
+            nombre = "Mostrar personas mas longevas por ciudad (Referencia)";
+            break;
+        case 6:
+            personas[resultado.fila].mostrar();
+            nombre = "Mostrar personas más rica del país(Referencia)";
+            break;
+        case 8:
+            mostrarPorLlave();
+            nombre = "Mostrar personas mas ricas por ciudad (Referencia)";
+            break;
+        case 10:
+            mostrarPorLlave();
+            nombre = "Mostrar personas mas ricas por Grupo (Referencia)";
+            break;
+        case 14:
+            personas[resultado.fila].mostrar();
+            nombre = "Mostrar personas más endueduada del país(Referencia)";
+            break;
+        case 16: {
+            std::pair<std::string, long double> ciudadRica = {"", 0};
+            for (const auto &pair : resultado.totales) {
+                if (pair.second > ciudadRica.second) ciudadRica = pair;
+            }
+            std::cout<< "Ciudad con mayor patrimonio: " << ciudadRica.first << " = " << ciudadRica.second << "\n";
+            nombre = "Mostrar ciudad con mayor patrimonio(Referencia)";
+            break;
+        }
+        case 18:
+            std::cout<< "Personas tienen patrimonio superior a 1.000 millones(Referencia)\n";
+            for (const auto &pair : resultado.listado) {
+                std::cout << "Ciudad:" << pair.first << "\n";
+                for (size_t i : pair.second) {
+                    std::cout<< personas[i].getNombre()<<" "<<personas[i].getApellido()<<" Patrimonio: "<<personas[i].getPatrimonio() <<"\n";
+                }
+            }
+            nombre = "Personas tienen patrimonio superior a 1.000 millones(Referencia)";
+            break;
+        default:
+            monitor.detener_tiempo();
+            return false;
+    }
+    
+    double tiempo_consulta = monitor.detener_tiempo();
+    long memoria_consulta = monitor.obtener_memoria() - memoria_inicio;
+    monitor.registrar(nombre + sufijo, tiempo_consulta, memoria_consulta);
+    return true;
+}
+
+/**
+ * Ejecuta una opción del menú distinta de crear datos y salir.
+ * 
+ * POR QUÉ: Los tableros repiten las mismas consultas cada pocos segundos, casi
+ *          siempre sin que los datos hayan cambiado.
+ * CÓMO: Las consultas 2 a 19 se sirven de la caché si hay una vista de la versión
+ *       vigente (se registra como "Consulta N (caché)"). Si no, se calculan
+ *       (con los agregados incrementales si hay cambios sin copiar a la sesión) con
+ *       la salida capturada, que se imprime y se guarda como vista nueva.
+ * PARA QUÉ: Pagar cada consulta una vez por versión de los datos.
+ */
+void ejecutarOpcion(int opcion, Sesion& sesion) {
+    if (!respondeIncremental(opcion)) sincronizarPersonas(sesion);
+    // La consulta, la vista y su versión usan la misma versión fijada
+    auto vigente = sesion.datos.fijar();
+    uint64_t version = versionVigente(sesion, vigente.get());
+    auto calcular = [&]() {
+        if (sesion.personasDesactualizadas && consultarIncremental(opcion, sesion)) return;
+        calcularOpcion(opcion, sesion, vigente.get());
+    };
+    if (!sesion.usarCache || !hayDatos(sesion) || opcion < 2 || opcion > 19) {
+        calcular();
+        return;
+    }
+    
+    Monitor& monitor = sesion.monitor;
+    std::string parametros = (opcion == 18 || opcion == 19) ? "umbral=1000000000" : "";
+    monitor.iniciar_tiempo();
+    long memoria_inicio = monitor.obtener_memoria();
+    if (const std::string* vista = sesion.cache.buscar(opcion, parametros, version)) {
+        std::cout << *vista;
+        double tiempo_vista = monitor.detener_tiempo();
+        long memoria_vista = monitor.obtener_memoria() - memoria_inicio;
+        monitor.registrar("Consulta " + std::to_string(opcion) + " (caché)", tiempo_vista, memoria_vista);
+        return;
+    }
+    
+    // Se captura aunque la salida esté suprimida (--quiet), para que la vista quede completa
+    // (rdbuf() limpia el estado del flujo, así que se guarda antes)
+    std::ostringstream captura;
+    std::ios::iostate estado = std::cout.rdstate();
+    std::streambuf* consola = std::cout.rdbuf(captura.rdbuf());
+    calcular();
+    std::cout.rdbuf(consola);
+    std::cout.setstate(estado);
+    std::string texto = captura.str();
+    std::cout << texto;
+    sesion.cache.guardar(opcion, parametros, version, std::move(texto));
+}
+
+/**
+ * Ejecuta generación, consultas y exportación sin menú.
+ * 
+ * POR QUÉ: En cron y pipelines de carga no hay nadie que escriba opciones.
+ * CÓMO: Sigue las opciones de la línea de comandos; la salida de las consultas
+ *       se suprime (--quiet) o se redirige (--output) para no medir la consola.
+ * PARA QUÉ: Obtener mediciones reproducibles y exportables.
+ * @return 0 si todo se ejecutó, 2 si alguna opción es inválida.
+ */
+int ejecutarLote(const OpcionesCli& opciones) {
+    bool adjunto = !opciones.adjuntarCompartida.empty();
+    for (int opcion : opciones.consultas) {
+        if (opcion < 1 || (opcion > 19 && opcion != 23) || ((adjunto || opciones.procesos > 0 || opciones.tareas > 0) && !respondeIncremental(opcion))) {
+            std::cerr << "Opción no disponible en modo por lotes: " << opcion << "\n";
+            return 2;
+        }
+    }
+    
+    std::ofstream salida;
+    if (!opciones.archivoSalida.empty()) {
+        salida.open(opciones.archivoSalida);
+        if (!salida) {
+            std::cerr << "Error al abrir archivo: " << opciones.archivoSalida << std::endl;
+            return 2;
+        }
+    }
+    
+    // Con badbit los operadores << no formatean nada, así la salida no cuesta tiempo
+    std::streambuf* consola = std::cout.rdbuf();
+    auto desviarSalida = [&]() {
+        if (opciones.silencioso) {
+            std::cout.setstate(std::ios::badbit);
+        } else if (salida.is_open()) {
+            std::cout.rdbuf(salida.rdbuf());
+        }
+    };
+    auto restaurarSalida = [&]() {
+        std::cout.rdbuf(consola);
+        std::cout.clear();
+    };
+    
+    if (opciones.conSemilla) {
+        establecerSemilla(opciones.semilla);
+    } else {
+        establecerSemilla(static_cast<unsigned>(time(nullptr)));
+    }
+    PerfilDatos perfil;
+    perfil.sesgado = opciones.perfil == "skewed";
+    perfil.zipf = opciones.zipf;
+    perfil.duplicados = opciones.duplicados;
+    establecerPerfil(perfil);
+    MuestraPersonas::capacidadPorDefecto() = opciones.tamanoMuestra;
+    SketchKll::kPorDefecto() = opciones.kCuantiles;
+    HyperLogLog::precisionPorDefecto() = opciones.precisionDistintos;
+    
+    // La política de páginas se fija antes de crear cualquier conjunto
+    PoliticaPaginas paginas;
+    if (opciones.paginasGrandes == "thp") paginas.modo = PoliticaPaginas::Modo::Transparentes;
+    if (opciones.paginasGrandes == "explicit") paginas.modo = PoliticaPaginas::Modo::Explicitas;
+    paginas.prellenar = opciones.prellenar;
+    paginas.bloquear = opciones.bloquearMemoria;
+    configurarPaginas(paginas);
+    
+    Sesion sesion;
+    sesion.hilos = opciones.hilos;
+    sesion.presupuestoMemoria = opciones.presupuestoMB << 20;
+    sesion.usarCache = opciones.cache;
+    if (opciones.tareas > 0) {
+        sesion.planificador = std::make_unique<PlanificadorTareas>(opciones.tareas);
+        sesion.grano = opciones.grano;
+    }
+    if (opciones.generar > 0) {
+        desviarSalida();
+        if (opciones.segundoPlano) {
+            iniciarRecarga(sesion, opciones.generar, true);
+        } else {
+            generarDatos(sesion, opciones.generar);
+        }
+        restaurarSalida();
+    } else if (!opciones.importar.empty()) {
+        desviarSalida();
+        bool importado = importarDatos(sesion, opciones.importar);
+        restaurarSalida();
+        if (!importado) {
+            std::cerr << "No se pudo importar: " << opciones.importar << "\n";
+            return 2;
+        }
+    }
+    if (opciones.cambios > 0) {
+        desviarSalida();
+        aplicarCambios(sesion, opciones.cambios);
+        restaurarSalida();
+    }
+    if (!opciones.exportarDatos.empty()) {
+        desviarSalida();
+        bool exportado = exportarDatos(sesion, opciones.exportarDatos);
+        restaurarSalida();
+        if (!exportado) {
+            std::cerr << "No se pudo exportar: " << opciones.exportarDatos << "\n";
+            return 2;
+        }
+    }
+    if (!opciones.publicarCompartida.empty()) {
+        sincronizarPersonas(sesion);
+        auto vigente = sesion.datos.fijar();
+        size_t bytes = 0;
+        std::string error;
+        if (!publicarCompartido(opciones.publicarCompartida, vigente->personas, vigente->version, bytes, error)) {
+            std::cerr << error << "\n";
+            return 2;
+        }
+        desviarSalida();
+        std::cout << "Publicadas " << vigente->personas.size() << " personas en memoria compartida ("
+                  << bytes / 1024 << " KB): " << opciones.publicarCompartida << "\n";
+        restaurarSalida();
+    }
+    ConjuntoCompartido compartido;
+    if (adjunto) {
+        std::string error;
+        if (!compartido.adjuntar(opciones.adjuntarCompartida, error)) {
+            std::cerr << error << "\n";
+            return 2;
+        }
+        desviarSalida();
+        std::cout << "Adjuntado a " << opciones.adjuntarCompartida << ": " << compartido.tamano() << " personas ("
+                  << compartido.bytes() / 1024 << " KB, versión " << compartido.version() << ")\n";
+        restaurarSalida();
+    }
+    if (paginas.activa()) {
+        desviarSalida();
+        std::cout << describirPaginas() << "\n";
+        restaurarSalida();
+    }
+    if (opciones.recargar > 0) {
+        desviarSalida();
+        iniciarRecarga(sesion, opciones.recargar, false);
+        restaurarSalida();
+    }
+    for (int opcion : opciones.consultas) {
+        for (int r = 0; r < opciones.repeticiones; ++r) {
+            desviarSalida();
+            if (sesion.recarga && sesion.recarga->parcial) {
+                // Sin un primer segmento no hay nada que consultar; después no se espera más
+                const RecargaEnCurso& recarga = *sesion.recarga;
+                while (recarga.consultables.load(std::memory_order_relaxed) == 0 &&
+                       !recarga.terminada.load(std::memory_order_acquire)) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                }
+                // Cada consulta se registra con el tamaño que había publicado al empezar
+                mostrarProgreso(sesion);
+                sesion.monitor.establecer_tamano(sesion.recarga->consultables.load(std::memory_order_relaxed));
+            }
+            if (adjunto) {
+                consultarCompartido(opcion, compartido, sesion.monitor);
+            } else if (opciones.procesos > 0 || sesion.planificador) {
+                consultarParticionado(opcion, sesion, opciones.procesos);
+            } else {
+                ejecutarOpcion(opcion, sesion);
+            }
+            restaurarSalida();
+        }
+    }
+    desviarSalida();
+    recogerRecarga(sesion, true);
+    restaurarSalida();
+    if (opciones.filasVirtuales > 0) {
+        desviarSalida();
+        uint64_t semilla = opciones.conSemilla ? opciones.semilla : static_cast<uint64_t>(time(nullptr));
+        for (int r = 0; r < opciones.repeticiones; ++r) {
+            reporteVirtualSesion(sesion, opciones.filasVirtuales, semilla, opciones.umbralVirtual,
+                                 opciones.listadoVirtual);
+        }
+        restaurarSalida();
+    }
+    if (!opciones.aproximado.empty()) {
+        desviarSalida();
+        for (int r = 0; r < opciones.repeticiones; ++r) {
+            reporteAproximado(sesion, opciones.aproximado == "stratified", opciones.umbralAproximado);
+        }
+        restaurarSalida();
+    }
+    if (opciones.cuantiles) {
+        desviarSalida();
+        for (int r = 0; r < opciones.repeticiones; ++r) reporteCuantiles(sesion);
+        restaurarSalida();
+    }
+    if (opciones.distintos) {
+        desviarSalida();
+        for (int r = 0; r < opciones.repeticiones; ++r) reporteDistintos(sesion);
+        restaurarSalida();
+    }
+    if (opciones.numa) {
+        desviarSalida();
+        reporteNuma(sesion, opciones.hilosNuma, opciones.repeticiones);
+        restaurarSalida();
+    }
+    if (!opciones.servir.empty()) {
+        // El servidor lee la versión publicada, así que los cambios incrementales se materializan antes
+        sincronizarPersonas(sesion);
+        std::string error;
+        if (!ejecutarServidor(opciones.servir, opciones.trabajadores, sesion.datos, error)) {
+            std::cerr << error << "\n";
+            return 2;
+        }
+    }
+    if (!opciones.fueraDeMemoria.empty()) {
+        desviarSalida();
+        bool procesado = reporteSegmentado(sesion, opciones.fueraDeMemoria);
+        restaurarSalida();
+        if (!procesado) {
+            std::cerr << "No se pudo procesar: " << opciones.fueraDeMemoria << "\n";
+            return 2;
+        }
+    }
+    if (!opciones.archivoCsv.empty()) {
+        desviarSalida();
+        sesion.monitor.exportar_csv(opciones.archivoCsv);
+        restaurarSalida();
+    }
+    if (!opciones.silencioso) {
+        sesion.monitor.mostrar_resumen();
+    }
+    return 0;
+}
+
+/**
+ * Punto de entrada principal del programa.
+ * 
+ * POR QUÉ: Iniciar la aplicación y manejar el flujo principal.
+ * CÓMO: Sin argumentos, un bucle que muestra el menú y procesa la opción seleccionada;
+ *       con argumentos, el modo por lotes o la comparación de CSV (ver --help).
+ * PARA QUÉ: Ejecutar las funcionalidades del sistema.
+ */
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        OpcionesCli opciones;
+        std::string error;
+        if (!analizarArgumentos(argc, argv, opciones, error)) {
+            std::cerr << error << "\n";
+            mostrarAyuda(argv[0]);
+            return 2;
+        }
+        if (opciones.ayuda) {
+            mostrarAyuda(argv[0]);
+            return 0;
+        }
+        // Modo comparación: devuelve el resultado como código de salida
+        if (!opciones.compararBase.empty()) {
+            return compararResultados(opciones.compararBase, opciones.compararNuevo, opciones.umbral);
+        }
+        if (!opciones.retirarCompartida.empty()) {
+            if (!retirarCompartido(opciones.retirarCompartida, error)) {
+                std::cerr << error << "\n";
+                return 2;
+            }
+            return 0;
+        }
+        // Modo cliente: una consulta a un servidor ya en marcha
+        if (!opciones.preguntar.empty()) {
+            if (!consultarServidor(opciones.preguntar, opciones.consultaRemota, opciones.umbralRemoto, error)) {
+                std::cerr << error << "\n";
+                return 2;
+            }
+            return 0;
+        }
+        return ejecutarLote(opciones);
+    }
+
+    srand(time(nullptr)); // Semilla para generación aleatoria
+    
+    Sesion sesion;
+    
+    int opcion;
+    do {
+        recogerRecarga(sesion, false);
+        if (sesion.recarga) mostrarProgreso(sesion);
+        mostrarMenu();
+        std::cin >> opcion;
+        if (!std::cin) {
+            if (std::cin.eof()) break;
+            std::cin.clear();
+            std::cin.ignore();
+            continue;
         }
         
-        // Mostrar estadísticas de la operación (excepto para opciones 4,5,6)
+        // Un solo escritor a la vez: las opciones que reemplazan o modifican los datos
+        // (y usan el generador aleatorio) esperan a que termine la recarga
+        if (sesion.recarga && (opcion == 0 || opcion == 25 || opcion == 27 || opcion == 28)) {
+            std::cout << "\nHay una recarga en curso; las consultas siguen disponibles.\n";
+            continue;
+        }
+        
+        if (opcion == 0) { // Crear nuevo conjunto de datos
+            int n;
+            std::cout << "\nIngrese el número de personas a generar: ";
+            std::cin >> n;
+            if (!std::cin) {
+                std::cin.clear();
+                std::cin.ignore();
+                continue;
+            }
+            // En el menú la generación no bloquea: se consulta lo generado mientras avanza
+            iniciarRecarga(sesion, n, true);
+        } else if (opcion == 29) {
+            mostrarProgreso(sesion);
+        } else if (opcion == 30) {
+            cancelarRecarga(sesion);
+        } else if (opcion == 31) {
+            int tipo;
+            std::cout << "\nTipo de muestra (1. uniforme, 2. estratificada por ciudad): ";
+            std::cin >> tipo;
+            if (!std::cin) {
+                std::cin.clear();
+                std::cin.ignore();
+                continue;
+            }
+            reporteAproximado(sesion, tipo == 2, 1'000'000'000.0);
+        } else if (opcion == 32) {
+            reporteCuantiles(sesion);
+        } else if (opcion == 33) {
+            reporteDistintos(sesion);
+        } else if (opcion >= 24 && opcion <= 26) { // Opciones que reciben un archivo CSV
+            std::string archivo;
+            std::cout << "\nIngrese el nombre del archivo CSV: ";
+            std::cin >> archivo;
+            if (!std::cin) break;
+            if (opcion == 24) {
+                exportarDatos(sesion, archivo);
+            } else if (opcion == 25) {
+                importarDatos(sesion, archivo);
+            } else {
+                reporteSegmentado(sesion, archivo);
+            }
+        } else if (opcion == 27) { // Cambios incrementales
+            long long n;
+            std::cout << "\nIngrese el número de cambios a aplicar: ";
+            std::cin >> n;
+            if (!std::cin || n <= 0) {
+                std::cin.clear();
+                std::cin.ignore();
+                continue;
+            }
+            aplicarCambios(sesion, static_cast<size_t>(n));
+        } else if (opcion == 28) { // Recarga en segundo plano
+            int n;
+            std::cout << "\nIngrese el número de personas a generar: ";
+            std::cin >> n;
+            if (!std::cin) {
+                std::cin.clear();
+                std::cin.ignore();
+                continue;
+            }
+            iniciarRecarga(sesion, n, false);
+        } else if (opcion == 22) { // Salir
+            recogerRecarga(sesion, true);
+            std::cout << "Saliendo...\n";
+        } else {
+            ejecutarOpcion(opcion, sesion);
+        }
         
     } while(opcion != 22);
     
     return 0;
-}
\ No newline at end of file
+}
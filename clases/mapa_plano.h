@@ -0,0 +1,328 @@
+#ifndef MAPA_PLANO_H
+#define MAPA_PLANO_H
+
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * Mezcla final de 64 bits (fmix64 de MurmurHash3).
+ *
+ * POR QUÉ: Los códigos pequeños y los textos parecidos producen hashes cercanos.
+ * CÓMO: Multiplicaciones y desplazamientos que reparten cada bit de entrada.
+ * PARA QUÉ: Que los bits altos y bajos del hash sirvan como posición y etiqueta.
+ */
+inline uint64_t mezclarHash(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/**
+ * Hash de un texto leyendo 8 bytes por paso.
+ */
+inline uint64_t hashTexto(std::string_view texto) {
+    uint64_t h = 0x9e3779b97f4a7c15ULL ^ texto.size();
+    const char* p = texto.data();
+    size_t n = texto.size();
+    while (n >= 8) {
+        uint64_t palabra;
+        std::memcpy(&palabra, p, 8);
+        h = (h ^ mezclarHash(palabra)) * 0x9fb21c651e98df25ULL;
+        p += 8;
+        n -= 8;
+    }
+    uint64_t resto = 0;
+    std::memcpy(&resto, p, n);
+    return mezclarHash(h ^ resto);
+}
+
+/**
+ * Función hash de MapaPlano. Los textos aceptan cualquier tipo convertible a
+ * std::string_view (búsqueda heterogénea, sin construir un std::string).
+ */
+template <class K, class = void>
+struct HashPlano;
+
+template <class K>
+struct HashPlano<K, std::enable_if_t<std::is_integral_v<K>>> {
+    uint64_t operator()(K clave) const { return mezclarHash(static_cast<uint64_t>(clave)); }
+};
+
+template <>
+struct HashPlano<std::string> {
+    uint64_t operator()(std::string_view clave) const { return hashTexto(clave); }
+};
+
+/**
+ * Tabla hash plana de direccionamiento abierto para resultados agrupados.
+ *
+ * POR QUÉ: std::unordered_map reserva un nodo por llave y las consultas hacían
+ *          count() seguido de varios operator[], es decir 3 a 5 hashes por fila.
+ * CÓMO: Las entradas viven en un arreglo contiguo; un byte de control por posición
+ *       guarda 7 bits del hash (o vacío). La búsqueda compara 16 bytes de control a
+ *       la vez con SSE2 y solo revisa la llave de las posiciones que coinciden.
+ *       insertar() busca y, si no existe, inserta en la misma pasada.
+ * PARA QUÉ: Una sola sonda por fila en las consultas por ciudad y por grupo.
+ *
+ * borrar() deja una marca en la posición para no cortar las secuencias de sondeo;
+ * las marcas cuentan en la carga y desaparecen al reconstruir la tabla. La memoria
+ * se toma del recurso recibido, normalmente la ArenaConsulta de la sesión.
+ */
+template <class K, class V, class Hash = HashPlano<K>>
+class MapaPlano {
+public:
+    using value_type = std::pair<const K, V>;
+
+    template <bool Constante>
+    class Iterador {
+    public:
+        using Mapa = std::conditional_t<Constante, const MapaPlano, MapaPlano>;
+        using Referencia = std::conditional_t<Constante, const value_type&, value_type&>;
+        Iterador(Mapa* mapa, size_t posicion) : mapa(mapa), posicion(posicion) { saltarVacios(); }
+        Referencia operator*() const { return *mapa->entrada(posicion); }
+        auto operator->() const { return &**this; }
+        Iterador& operator++() { ++posicion; saltarVacios(); return *this; }
+        bool operator==(const Iterador& otro) const { return posicion == otro.posicion; }
+        bool operator!=(const Iterador& otro) const { return posicion != otro.posicion; }
+
+    private:
+        void saltarVacios() {
+            while (posicion < mapa->capacidad && mapa->control[posicion] < 0) ++posicion;
+        }
+        Mapa* mapa;
+        size_t posicion;
+    };
+    using iterator = Iterador<false>;
+    using const_iterator = Iterador<true>;
+
+    explicit MapaPlano(std::pmr::memory_resource* recurso = std::pmr::get_default_resource())
+        : recurso(recurso) {}
+
+    MapaPlano(const MapaPlano&) = delete;
+    MapaPlano& operator=(const MapaPlano&) = delete;
+
+    MapaPlano(MapaPlano&& otro) noexcept
+        : recurso(otro.recurso), control(otro.control), entradas(otro.entradas),
+          capacidad(otro.capacidad), cantidad(otro.cantidad), borrados(otro.borrados) {
+        otro.control = nullptr;
+        otro.entradas = nullptr;
+        otro.capacidad = 0;
+        otro.cantidad = 0;
+        otro.borrados = 0;
+    }
+
+    MapaPlano& operator=(MapaPlano&& otro) noexcept {
+        if (this != &otro) {
+            liberar();
+            recurso = otro.recurso;
+            std::swap(control, otro.control);
+            std::swap(entradas, otro.entradas);
+            std::swap(capacidad, otro.capacidad);
+            std::swap(cantidad, otro.cantidad);
+            std::swap(borrados, otro.borrados);
+        }
+        return *this;
+    }
+
+    ~MapaPlano() { liberar(); }
+
+    /**
+     * Busca la llave y, si no existe, la inserta con el valor construido con args.
+     *
+     * @param clave Llave o cualquier tipo que Hash acepte (p. ej. std::string_view).
+     * @param hash Hash ya calculado de la llave.
+     * @return Puntero a la entrada y true si fue insertada.
+     */
+    template <class Q, class... Args>
+    std::pair<value_type*, bool> insertarConHash(const Q& clave, uint64_t hash, Args&&... args) {
+        if (capacidad == 0 || (cantidad + borrados + 1) * 8 > capacidad * 7) {
+            crecer();
+        }
+        size_t posicion = 0;
+        if (value_type* existente = sondear(clave, hash, posicion)) {
+            return {existente, false};
+        }
+        value_type* nueva = entrada(posicion);
+        construir(nueva, clave, std::forward<Args>(args)...);
+        marcar(posicion, etiqueta(hash));
+        ++cantidad;
+        return {nueva, true};
+    }
+
+    template <class Q, class... Args>
+    std::pair<value_type*, bool> insertar(const Q& clave, Args&&... args) {
+        return insertarConHash(clave, Hash{}(clave), std::forward<Args>(args)...);
+    }
+
+    template <class Q>
+    value_type* buscar(const Q& clave) const {
+        if (capacidad == 0) return nullptr;
+        size_t posicion = 0;
+        return sondear(clave, Hash{}(clave), posicion);
+    }
+
+    template <class Q>
+    V& operator[](const Q& clave) { return insertar(clave).first->second; }
+
+    /**
+     * Elimina la llave si existe.
+     * @return true si la llave estaba en la tabla.
+     */
+    template <class Q>
+    bool borrar(const Q& clave) {
+        value_type* existente = buscar(clave);
+        if (existente == nullptr) return false;
+        size_t posicion = static_cast<size_t>(existente - entrada(0));
+        existente->~value_type();
+        marcar(posicion, BORRADO);
+        --cantidad;
+        ++borrados;
+        return true;
+    }
+
+    size_t size() const { return cantidad; }
+    bool empty() const { return cantidad == 0; }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, capacidad); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, capacidad); }
+
+private:
+    static constexpr int8_t VACIO = -128;   // Byte de control de una posición libre
+    static constexpr int8_t BORRADO = -2;   // Posición libre que no corta el sondeo
+    static constexpr size_t GRUPO = 16;     // Bytes de control comparados por paso
+
+    static int8_t etiqueta(uint64_t hash) { return static_cast<int8_t>(hash & 0x7f); }
+
+    value_type* entrada(size_t posicion) const {
+        return std::launder(reinterpret_cast<value_type*>(entradas) + posicion);
+    }
+
+    // Escribe el control de la posición y su copia al final (para leer grupos sin dar la vuelta)
+    void marcar(size_t posicion, int8_t valor) {
+        control[posicion] = valor;
+        if (posicion < GRUPO) control[capacidad + posicion] = valor;
+    }
+
+    // Máscara de bits: posiciones del grupo cuyo control es igual a valor
+    static uint32_t coincidencias(const int8_t* grupo, int8_t valor) {
+#ifdef __SSE2__
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(grupo));
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(valor))));
+#else
+        uint32_t mascara = 0;
+        for (size_t i = 0; i < GRUPO; ++i) {
+            if (grupo[i] == valor) mascara |= 1u << i;
+        }
+        return mascara;
+#endif
+    }
+
+    // Devuelve la entrada si existe; si no, deja en posicion el primer hueco de la secuencia
+    template <class Q>
+    value_type* sondear(const Q& clave, uint64_t hash, size_t& posicion) const {
+        size_t mascara = capacidad - 1;
+        size_t inicio = (hash >> 7) & mascara;
+        int8_t buscada = etiqueta(hash);
+        while (true) {
+            const int8_t* grupo = control + inicio;
+            for (uint32_t m = coincidencias(grupo, buscada); m != 0; m &= m - 1) {
+                size_t i = (inicio + __builtin_ctz(m)) & mascara;
+                value_type* candidata = entrada(i);
+                if (candidata->first == clave) return candidata;
+            }
+            uint32_t vacios = coincidencias(grupo, VACIO);
+            if (vacios != 0) {
+                posicion = (inicio + __builtin_ctz(vacios)) & mascara;
+                return nullptr;
+            }
+            inicio = (inicio + GRUPO) & mascara;
+        }
+    }
+
+    template <class Q, class... Args>
+    void construir(value_type* destino, const Q& clave, Args&&... args) {
+        if constexpr (sizeof...(Args) == 0 &&
+                      std::uses_allocator_v<V, std::pmr::polymorphic_allocator<std::byte>>) {
+            // Valores que son contenedores pmr (p. ej. listas) usan la misma arena
+            ::new (destino) value_type(std::piecewise_construct, std::forward_as_tuple(clave),
+                                       std::forward_as_tuple(std::pmr::polymorphic_allocator<std::byte>(recurso)));
+        } else {
+            ::new (destino) value_type(std::piecewise_construct, std::forward_as_tuple(clave),
+                                       std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+    }
+
+    void crecer() {
+        // Si la carga viene sobre todo de marcas de borrado, basta con reconstruir
+        size_t nuevaCapacidad = capacidad == 0 ? GRUPO : (cantidad * 2 < capacidad ? capacidad : capacidad * 2);
+        int8_t* controlAnterior = control;
+        std::byte* entradasAnteriores = entradas;
+        size_t capacidadAnterior = capacidad;
+
+        control = static_cast<int8_t*>(recurso->allocate(nuevaCapacidad + GRUPO, alignof(int8_t)));
+        entradas = static_cast<std::byte*>(recurso->allocate(nuevaCapacidad * sizeof(value_type),
+                                                             alignof(value_type)));
+        std::memset(control, static_cast<unsigned char>(VACIO), nuevaCapacidad + GRUPO);
+        capacidad = nuevaCapacidad;
+        borrados = 0;
+
+        // Reubica cada entrada; no hay llaves repetidas, así que basta con buscar un hueco
+        for (size_t i = 0; i < capacidadAnterior; ++i) {
+            if (controlAnterior[i] < 0) continue;
+            value_type* vieja = std::launder(reinterpret_cast<value_type*>(entradasAnteriores) + i);
+            uint64_t hash = Hash{}(vieja->first);
+            size_t posicion = 0;
+            sondear(vieja->first, hash, posicion);
+            ::new (entrada(posicion)) value_type(std::piecewise_construct,
+                                                 std::forward_as_tuple(std::move(const_cast<K&>(vieja->first))),
+                                                 std::forward_as_tuple(std::move(vieja->second)));
+            marcar(posicion, etiqueta(hash));
+            vieja->~value_type();
+        }
+        if (capacidadAnterior > 0) {
+            recurso->deallocate(controlAnterior, capacidadAnterior + GRUPO, alignof(int8_t));
+            recurso->deallocate(entradasAnteriores, capacidadAnterior * sizeof(value_type), alignof(value_type));
+        }
+    }
+
+    void liberar() {
+        if (capacidad == 0) return;
+        if constexpr (!std::is_trivially_destructible_v<value_type>) {
+            for (size_t i = 0; i < capacidad; ++i) {
+                if (control[i] >= 0) entrada(i)->~value_type();
+            }
+        }
+        recurso->deallocate(control, capacidad + GRUPO, alignof(int8_t));
+        recurso->deallocate(entradas, capacidad * sizeof(value_type), alignof(value_type));
+        control = nullptr;
+        entradas = nullptr;
+        capacidad = 0;
+        cantidad = 0;
+        borrados = 0;
+    }
+
+    std::pmr::memory_resource* recurso;
+    int8_t* control = nullptr;      // capacidad + GRUPO bytes (los últimos copian los primeros)
+    std::byte* entradas = nullptr;  // capacidad entradas, construidas solo si control != VACIO
+    size_t capacidad = 0;           // Potencia de 2
+    size_t cantidad = 0;            // Entradas ocupadas
+    size_t borrados = 0;            // Posiciones con marca de borrado
+};
+
+#endif // MAPA_PLANO_H
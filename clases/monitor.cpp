@@ -1,6 +1,54 @@
 #include "monitor.h"
 #include <unistd.h> // sysconf
 #include <cstdio>   // FILE, fscanf
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+
+/**
+ * Abre el contador de misses de TLB de datos.
+ * 
+ * POR QUÉ: Las páginas grandes solo se justifican si reducen las misses de TLB.
+ * CÓMO: perf_event_open sobre el proceso, solo espacio de usuario (funciona con
+ *       perf_event_paranoid 2) y heredado por los hilos creados después, cuyos
+ *       conteos se suman al terminar. En máquinas virtuales o contenedores sin PMU
+ *       la llamada falla y las misses se informan como no disponibles.
+ * PARA QUÉ: Confirmar el efecto de --huge-pages junto con los fallos de página.
+ */
+Monitor::Monitor() {
+    perf_event_attr atributos;
+    std::memset(&atributos, 0, sizeof(atributos));
+    atributos.size = sizeof(atributos);
+    atributos.type = PERF_TYPE_HW_CACHE;
+    atributos.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                       (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    atributos.inherit = 1;
+    atributos.exclude_kernel = 1;
+    atributos.exclude_hv = 1;
+    contador_tlb = static_cast<int>(syscall(SYS_perf_event_open, &atributos, 0, -1, -1, 0));
+}
+
+Monitor::~Monitor() {
+    if (contador_tlb >= 0) close(contador_tlb);
+}
+
+/**
+ * Lee los fallos de página acumulados por el proceso y las misses de TLB.
+ */
+Monitor::Fallos Monitor::leer_fallos() const {
+    Fallos fallos;
+    rusage uso;
+    if (getrusage(RUSAGE_SELF, &uso) == 0) {
+        fallos.menores = uso.ru_minflt;
+        fallos.mayores = uso.ru_majflt;
+    }
+    long long valor = 0;
+    if (contador_tlb >= 0 && read(contador_tlb, &valor, sizeof(valor)) == static_cast<ssize_t>(sizeof(valor))) {
+        fallos.tlb = valor;
+    }
+    return fallos;
+}
 
 /**
  * Inicia el cronómetro.
@@ -10,6 +58,7 @@
  * PARA QUÉ: Poder calcular la duración después.
  */
 void Monitor::iniciar_tiempo() {
+    fallos_inicio = leer_fallos();
     inicio = std::chrono::high_resolution_clock::now();
 }
 
@@ -24,6 +73,10 @@ void Monitor::iniciar_tiempo() {
 double Monitor::detener_tiempo() {
     auto fin = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double, std::milli> duracion = fin - inicio;
+    Fallos actuales = leer_fallos();
+    fallos_ultimos.menores = actuales.menores - fallos_inicio.menores;
+    fallos_ultimos.mayores = actuales.mayores - fallos_inicio.mayores;
+    fallos_ultimos.tlb = actuales.tlb >= 0 && fallos_inicio.tlb >= 0 ? actuales.tlb - fallos_inicio.tlb : -1;
     return duracion.count();
 }
 
@@ -56,15 +109,28 @@ long Monitor::obtener_memoria() {
     return resident * page_size_kb;
 }
 
+/**
+ * Fija el tamaño del conjunto de datos sobre el que se miden las operaciones.
+ * 
+ * POR QUÉ: El tiempo de una consulta solo es comparable con otra del mismo tamaño.
+ * CÓMO: Guardando el valor para anotarlo en cada registro posterior.
+ * PARA QUÉ: Emparejar operaciones por nombre y tamaño al comparar ejecuciones.
+ */
+void Monitor::establecer_tamano(size_t tamano) {
+    tamano_actual = tamano;
+}
+
 /**
  * Registra una operación con sus métricas de tiempo y memoria.
  * 
  * POR QUÉ: Almacenar estadísticas para análisis posterior.
- * CÓMO: Guardando un nuevo Registro en el vector y actualizando acumulados.
+ * CÓMO: Guardando un nuevo Registro en el vector, con los fallos de la última
+ *       medición, y actualizando acumulados.
  * PARA QUÉ: Tener un histórico de rendimiento.
  */
 void Monitor::registrar(const std::string& operacion, double tiempo, long memoria) {
-    registros.push_back({operacion, tiempo, memoria});
+    registros.push_back({operacion, tamano_actual, tiempo, memoria, fallos_ultimos.menores, fallos_ultimos.mayores,
+                         fallos_ultimos.tlb});
     total_tiempo += tiempo;
     if (memoria > max_memoria) {
         max_memoria = memoria;
@@ -95,7 +161,13 @@ void Monitor::mostrar_resumen() {
     std::cout << "\n=== RESUMEN DE ESTADÍSTICAS ===";
     for (const auto& reg : registros) {
         std::cout << "\n" << reg.operacion << ": "
-                  << reg.tiempo << " ms, " << reg.memoria << " KB";
+                  << reg.tiempo << " ms, " << reg.memoria << " KB, fallos de página "
+                  << reg.fallosMenores << "/" << reg.fallosMayores << ", TLB ";
+        if (reg.fallosTlb >= 0) {
+            std::cout << reg.fallosTlb;
+        } else {
+            std::cout << "n/d";
+        }
     }
     std::cout << "\nTotal tiempo: " << total_tiempo << " ms";
     std::cout << "\nMemoria máxima: " << max_memoria << " KB\n";
@@ -115,9 +187,10 @@ void Monitor::exportar_csv(const std::string& nombre_archivo) {
         std::cerr << "Error al abrir archivo: " << nombre_archivo << std::endl;
         return;
     }
-    archivo << "Operacion,Tiempo(ms),Memoria(KB)\n";
+    archivo << "Operacion,Tamano,Tiempo(ms),Memoria(KB),FallosMenores,FallosMayores,FallosTLB\n";
     for (const auto& reg : registros) {
-        archivo << reg.operacion << "," << reg.tiempo << "," << reg.memoria << "\n";
+        archivo << reg.operacion << "," << reg.tamano << "," << reg.tiempo << "," << reg.memoria << ","
+                << reg.fallosMenores << "," << reg.fallosMayores << "," << reg.fallosTlb << "\n";
     }
     archivo.close();
     std::cout << "Estadísticas exportadas a " << nombre_archivo << "\n";
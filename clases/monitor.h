@@ -11,14 +11,23 @@
  * Clase para monitorear el rendimiento (tiempo y memoria).
  * 
  * POR QUÉ: Cuantificar el rendimiento de las operaciones.
- * CÓMO: Midiendo tiempo con chrono y memoria con /proc/self/statm (Linux).
+ * CÓMO: Midiendo tiempo con chrono y memoria con /proc/self/statm (Linux). Entre
+ *       iniciar_tiempo y detener_tiempo también cuenta los fallos de página del
+ *       proceso (getrusage) y las misses de TLB de datos (perf_event_open, si el
+ *       kernel lo permite), que se guardan con el siguiente registro.
  * PARA QUÉ: Optimización y análisis de rendimiento.
  */
 class Monitor {
 public:
+    Monitor();
+    ~Monitor();
+    Monitor(const Monitor&) = delete;
+    Monitor& operator=(const Monitor&) = delete;
+
     void iniciar_tiempo();
     double detener_tiempo();
     long obtener_memoria();
+    void establecer_tamano(size_t tamano);
     
     void registrar(const std::string& operacion, double tiempo, long memoria);
     void mostrar_estadistica(const std::string& operacion, double tiempo, long memoria);
@@ -29,14 +38,30 @@ private:
     // Estructura para almacenar métricas de una operación
     struct Registro {
         std::string operacion; // Nombre de la operación
+        size_t tamano;         // Número de personas del conjunto medido
         double tiempo;         // Tiempo en milisegundos
         long memoria;          // Memoria en KB
+        long fallosMenores;    // Fallos de página resueltos sin disco
+        long fallosMayores;    // Fallos de página que leyeron del disco
+        long long fallosTlb;   // Misses de dTLB en lecturas (-1 si no hay contador)
+    };
+
+    // Contadores al llamar iniciar_tiempo y diferencias al llamar detener_tiempo
+    struct Fallos {
+        long menores = 0;
+        long mayores = 0;
+        long long tlb = -1;
     };
+    Fallos leer_fallos() const;
     
     std::chrono::high_resolution_clock::time_point inicio; // Punto de inicio del cronómetro
     std::vector<Registro> registros; // Historial de registros
     double total_tiempo = 0;         // Tiempo total acumulado
     long max_memoria = 0;            // Máximo de memoria utilizado
+    size_t tamano_actual = 0;        // Tamaño del conjunto de datos vigente
+    int contador_tlb = -1;           // Descriptor de perf_event_open (-1 si no está disponible)
+    Fallos fallos_inicio;            // Lectura al iniciar el cronómetro
+    Fallos fallos_ultimos;           // Diferencia de la última medición
 };
 
 #endif // MONITOR_H
\ No newline at end of file
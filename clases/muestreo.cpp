@@ -0,0 +1,118 @@
+#include "muestreo.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+const double Z_95 = 1.96;   // Cuantil normal del intervalo del 95%
+
+} // namespace
+
+void MuestraPersonas::agregar(const std::vector<Persona>& personas, size_t desde) {
+    for (size_t i = desde; i < personas.size(); ++i) agregar(personas[i]);
+}
+
+void MuestraPersonas::agregar(const Persona& persona) {
+    FilaMuestra fila{nombresCiudad.codificar(persona.getCiudadNacimiento()),
+                     nombresGrupo.codificar(persona.getGrupoDeclaracion()), persona.getIngresosAnuales(),
+                     persona.getPatrimonio()};
+    if (fila.ciudad >= porCiudad.size()) porCiudad.resize(fila.ciudad + 1);
+    if (fila.grupo >= porGrupo.size()) porGrupo.resize(fila.grupo + 1, 0);
+    ++total;
+    ++porGrupo[fila.grupo];
+    muestrear(uniforme, fila);
+    muestrear(porCiudad[fila.ciudad], fila);
+}
+
+// Algoritmo R: la fila k-ésima del estrato reemplaza a una al azar con probabilidad capacidad / k
+void MuestraPersonas::muestrear(Estrato& estrato, const FilaMuestra& fila) {
+    ++estrato.poblacion;
+    if (estrato.filas.size() < capacidad) {
+        estrato.filas.push_back(fila);
+        return;
+    }
+    uint64_t j = azar() % estrato.poblacion;
+    if (j < capacidad) estrato.filas[j] = fila;
+}
+
+size_t MuestraPersonas::filasMuestra(bool estratificada) const {
+    if (!estratificada) return uniforme.filas.size();
+    size_t n = 0;
+    for (const Estrato& estrato : porCiudad) n += estrato.filas.size();
+    return n;
+}
+
+template <class Variable>
+Estimacion MuestraPersonas::estimarTotal(bool estratificada, Variable z) const {
+    double total = 0, varianza = 0;
+    auto sumarEstrato = [&](const Estrato& estrato) {
+        size_t n = estrato.filas.size();
+        if (n == 0) return;
+        double suma = 0, sumaCuadrados = 0;
+        for (const FilaMuestra& fila : estrato.filas) {
+            double valor = z(fila);
+            suma += valor;
+            sumaCuadrados += valor * valor;
+        }
+        double N = static_cast<double>(estrato.poblacion);
+        double media = suma / n;
+        total += N * media;
+        if (n > 1) {
+            double s2 = std::max(0.0, (sumaCuadrados - n * media * media) / (n - 1));
+            varianza += N * N * (1.0 - n / N) * s2 / n;   // Con corrección por población finita
+        }
+    };
+    if (estratificada) {
+        for (const Estrato& estrato : porCiudad) sumarEstrato(estrato);
+    } else {
+        sumarEstrato(uniforme);
+    }
+    return {total, Z_95 * std::sqrt(varianza)};
+}
+
+Estimacion MuestraPersonas::patrimonioCiudad(size_t c, bool estratificada) const {
+    return estimarTotal(estratificada, [c](const FilaMuestra& f) { return f.ciudad == c ? f.patrimonio : 0.0; });
+}
+
+Estimacion MuestraPersonas::ingresoPromedioGrupo(size_t g, bool estratificada) const {
+    // El tamaño del grupo es exacto, así que el promedio es el total estimado entre ese tamaño
+    Estimacion total = estimarTotal(estratificada, [g](const FilaMuestra& f) { return f.grupo == g ? f.ingresos : 0.0; });
+    double N = static_cast<double>(porGrupo[g]);
+    return {total.valor / N, total.margen / N};
+}
+
+Estimacion MuestraPersonas::mayoresUmbral(double umbral, bool estratificada) const {
+    return estimarTotal(estratificada, [umbral](const FilaMuestra& f) { return f.patrimonio > umbral ? 1.0 : 0.0; });
+}
+
+void mostrarReporteAproximado(const MuestraPersonas& muestra, bool estratificada, double umbral) {
+    std::cout << "\n=== REPORTE APROXIMADO (" << muestra.filasMuestra(estratificada) << " de " << muestra.filas()
+              << " personas, muestra " << (estratificada ? "estratificada por ciudad" : "uniforme")
+              << ", IC 95%) ===\n";
+    if (muestra.filas() == 0) return;
+    // Totales de billones de pesos: el formato de Persona::mostrar, no 6 cifras significativas
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "\nPatrimonio total por ciudad:\n";
+    size_t mayor = 0;
+    Estimacion mejor;
+    for (size_t c = 0; c < muestra.ciudades(); ++c) {
+        Estimacion e = muestra.patrimonioCiudad(c, estratificada);
+        std::cout << muestra.ciudad(c) << ": " << e.valor << " ± " << e.margen << "\n";
+        if (c == 0 || mejor.valor < e.valor) {
+            mayor = c;
+            mejor = e;
+        }
+    }
+    std::cout << "Ciudad con mayor patrimonio: " << muestra.ciudad(mayor) << " = " << mejor.valor << " ± "
+              << mejor.margen << "\n";
+    std::cout << "\nIngreso promedio por grupo de declaración:\n";
+    for (size_t g = 0; g < muestra.grupos(); ++g) {
+        Estimacion e = muestra.ingresoPromedioGrupo(g, estratificada);
+        std::cout << muestra.grupo(g) << " (" << muestra.tamanoGrupo(g) << " personas): " << e.valor << " ± "
+                  << e.margen << "\n";
+    }
+    Estimacion e = muestra.mayoresUmbral(umbral, estratificada);
+    std::cout << "\nPersonas con patrimonio superior a " << umbral << ": " << e.valor << " ± " << e.margen << "\n";
+}
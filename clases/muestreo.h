@@ -0,0 +1,99 @@
+#ifndef MUESTREO_H
+#define MUESTREO_H
+
+#include "persona.h"
+#include "columnas.h"
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Estimación con su intervalo de confianza del 95%: valor ± margen.
+ */
+struct Estimacion {
+    double valor = 0;
+    double margen = 0;
+};
+
+/**
+ * Muestras de un conjunto de datos para responder consultas aproximadas.
+ *
+ * POR QUÉ: En un tablero exploratorio no hace falta recorrer 100M filas para
+ *          saber el patrimonio de cada ciudad con un par de cifras significativas.
+ * CÓMO: Se alimenta fila por fila mientras se carga el conjunto y mantiene, con
+ *       muestreo de reservorio (algoritmo R), una muestra uniforme de todo el
+ *       conjunto y otra por estrato (una por ciudad) de la misma capacidad cada
+ *       una, además de los tamaños exactos de cada ciudad y grupo. Cada consulta
+ *       es el total de una variable z por fila (patrimonio si la fila es de la
+ *       ciudad, 1 si supera el umbral...), estimado como la suma sobre estratos de
+ *       N_h por la media de z en la muestra del estrato, con varianza
+ *       N_h² (1 - n_h/N_h) s_h² / n_h; la muestra uniforme es un solo estrato.
+ *       Los intervalos usan la aproximación normal (1.96).
+ * PARA QUÉ: Respuestas en milisegundos cuyo costo depende de la capacidad de la
+ *           muestra y no del tamaño del conjunto.
+ */
+class MuestraPersonas {
+public:
+    explicit MuestraPersonas(size_t capacidad = capacidadPorDefecto()) : capacidad(capacidad) {}
+
+    /**
+     * Capacidad de cada reservorio para las muestras nuevas (--sample-size).
+     */
+    static size_t& capacidadPorDefecto() {
+        static size_t capacidad = 10000;
+        return capacidad;
+    }
+
+    // Agrega las filas [desde, fin) del vector, en orden
+    void agregar(const std::vector<Persona>& personas, size_t desde = 0);
+    void agregar(const Persona& persona);
+
+    size_t filas() const { return total; }
+    size_t filasMuestra(bool estratificada) const;
+    size_t ciudades() const { return nombresCiudad.tamano(); }
+    const std::string& ciudad(size_t c) const { return nombresCiudad.valor(static_cast<uint32_t>(c)); }
+    size_t grupos() const { return nombresGrupo.tamano(); }
+    const std::string& grupo(size_t g) const { return nombresGrupo.valor(static_cast<uint32_t>(g)); }
+    size_t tamanoGrupo(size_t g) const { return porGrupo[g]; }
+
+    Estimacion patrimonioCiudad(size_t c, bool estratificada) const;
+    Estimacion ingresoPromedioGrupo(size_t g, bool estratificada) const;
+    Estimacion mayoresUmbral(double umbral, bool estratificada) const;
+
+private:
+    // Solo los campos que usan las estimaciones
+    struct FilaMuestra {
+        uint32_t ciudad;
+        uint32_t grupo;
+        double ingresos;
+        double patrimonio;
+    };
+
+    struct Estrato {
+        size_t poblacion = 0;             // Filas vistas del estrato
+        std::vector<FilaMuestra> filas;   // Reservorio
+    };
+
+    void muestrear(Estrato& estrato, const FilaMuestra& fila);
+
+    template <class Variable>
+    Estimacion estimarTotal(bool estratificada, Variable z) const;
+
+    size_t capacidad;
+    size_t total = 0;
+    Estrato uniforme;
+    std::vector<Estrato> porCiudad;      // Índice: código de ciudad
+    std::vector<size_t> porGrupo;        // Filas exactas por código de grupo
+    Diccionario nombresCiudad;
+    Diccionario nombresGrupo;
+    std::mt19937_64 azar{0x5EED5EEDull};  // Propio: no altera la secuencia de la generación
+};
+
+/**
+ * Imprime el reporte aproximado: patrimonio por ciudad, ciudad con mayor
+ * patrimonio, ingreso promedio por grupo y personas sobre el umbral.
+ */
+void mostrarReporteAproximado(const MuestraPersonas& muestra, bool estratificada, double umbral);
+
+#endif // MUESTREO_H
@@ -0,0 +1,140 @@
+#include "numa.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <pthread.h>
+#include <sched.h>
+
+namespace {
+
+// Convierte una lista de procesadores del kernel ("0-3,8-11") en sus números
+std::vector<int> leerListaCpus(const std::string& texto) {
+    std::vector<int> cpus;
+    std::stringstream lista(texto);
+    std::string parte;
+    while (std::getline(lista, parte, ',')) {
+        if (parte.empty() || parte == "\n") continue;
+        try {
+            size_t guion = parte.find('-');
+            int desde = std::stoi(parte.substr(0, guion));
+            int hasta = guion == std::string::npos ? desde : std::stoi(parte.substr(guion + 1));
+            for (int cpu = desde; cpu <= hasta; ++cpu) cpus.push_back(cpu);
+        } catch (const std::exception&) {
+            return {};
+        }
+    }
+    return cpus;
+}
+
+std::vector<int> cpusPermitidas() {
+    std::vector<int> cpus;
+    cpu_set_t mascara;
+    CPU_ZERO(&mascara);
+    if (sched_getaffinity(0, sizeof(mascara), &mascara) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &mascara)) cpus.push_back(cpu);
+        }
+    }
+    if (cpus.empty()) {
+        for (unsigned cpu = 0; cpu < std::max(1u, std::thread::hardware_concurrency()); ++cpu) cpus.push_back(static_cast<int>(cpu));
+    }
+    return cpus;
+}
+
+} // namespace
+
+std::vector<NodoNuma> topologiaNuma() {
+    std::vector<int> permitidas = cpusPermitidas();
+    std::vector<NodoNuma> nodos;
+    std::ifstream enLinea("/sys/devices/system/node/online");
+    std::string texto;
+    if (enLinea && std::getline(enLinea, texto)) {
+        for (int id : leerListaCpus(texto)) {
+            std::ifstream archivo("/sys/devices/system/node/node" + std::to_string(id) + "/cpulist");
+            std::string lista;
+            if (!archivo || !std::getline(archivo, lista)) continue;
+            NodoNuma nodo;
+            nodo.id = id;
+            for (int cpu : leerListaCpus(lista)) {
+                if (std::find(permitidas.begin(), permitidas.end(), cpu) != permitidas.end()) nodo.cpus.push_back(cpu);
+            }
+            // Los nodos sin procesadores permitidos (solo memoria) no reciben trozos
+            if (!nodo.cpus.empty()) nodos.push_back(std::move(nodo));
+        }
+    }
+    if (nodos.empty()) nodos.push_back({0, permitidas});
+    return nodos;
+}
+
+bool fijarHilo(const std::vector<int>& cpus) {
+    cpu_set_t mascara;
+    CPU_ZERO(&mascara);
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) CPU_SET(cpu, &mascara);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(mascara), &mascara) == 0;
+}
+
+void ConjuntoNuma::construir(const std::vector<Persona>& personas, const std::vector<NodoNuma>& nodos,
+                             unsigned hilosPorNodo) {
+    trozos.clear();
+    cantidadNodos = nodos.size();
+    size_t totalCpus = 0;
+    for (const NodoNuma& nodo : nodos) totalCpus += nodo.cpus.size();
+    if (totalCpus == 0) return;
+
+    // Filas de cada nodo en proporción a sus procesadores; dentro del nodo, partes iguales
+    std::vector<std::pair<size_t, size_t>> rangos;   // [inicio, fin) de cada trozo
+    size_t cpusAntes = 0;
+    for (size_t k = 0; k < nodos.size(); ++k) {
+        size_t inicioNodo = personas.size() * cpusAntes / totalCpus;
+        cpusAntes += nodos[k].cpus.size();
+        size_t finNodo = personas.size() * cpusAntes / totalCpus;
+        size_t partes = hilosPorNodo > 0 ? hilosPorNodo : nodos[k].cpus.size();
+        for (size_t p = 0; p < partes; ++p) {
+            trozos.push_back({k, nodos[k].cpus, ColumnasPersona()});
+            rangos.push_back({inicioNodo + (finNodo - inicioNodo) * p / partes,
+                              inicioNodo + (finNodo - inicioNodo) * (p + 1) / partes});
+        }
+    }
+
+    // Cada trozo lo reserva y escribe un hilo del nodo: el primer toque ubica sus páginas ahí
+    std::vector<std::thread> hilos;
+    for (size_t t = 0; t < trozos.size(); ++t) {
+        hilos.emplace_back([&, t]() {
+            Trozo& trozo = trozos[t];
+            fijarHilo(trozo.cpus);
+            trozo.columnas.reservar(rangos[t].second - rangos[t].first);
+            for (size_t i = rangos[t].first; i < rangos[t].second; ++i) trozo.columnas.agregar(personas[i]);
+        });
+    }
+    for (auto& hilo : hilos) hilo.join();
+}
+
+void ConjuntoNuma::reporte(EstadoAgregado& estado) const {
+    std::vector<EstadoAgregado> parciales(trozos.size());
+    std::vector<std::thread> hilos;
+    for (size_t t = 0; t < trozos.size(); ++t) {
+        parciales[t].umbral = estado.umbral;
+        parciales[t].limiteListado = estado.limiteListado;
+        hilos.emplace_back([&, t]() {
+            fijarHilo(trozos[t].cpus);
+            parciales[t].agregar(trozos[t].columnas);
+        });
+    }
+    for (auto& hilo : hilos) hilo.join();
+    for (auto& parcial : parciales) estado.combinar(std::move(parcial));
+}
+
+size_t ConjuntoNuma::tamano() const {
+    size_t total = 0;
+    for (const Trozo& trozo : trozos) total += trozo.columnas.tamano();
+    return total;
+}
+
+std::vector<size_t> ConjuntoNuma::filasPorNodo() const {
+    std::vector<size_t> filas(cantidadNodos, 0);
+    for (const Trozo& trozo : trozos) filas[trozo.nodo] += trozo.columnas.tamano();
+    return filas;
+}
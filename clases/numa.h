@@ -0,0 +1,81 @@
+#ifndef NUMA_H
+#define NUMA_H
+
+#include "persona.h"
+#include "columnas.h"
+#include "agregados.h"
+#include <string>
+#include <vector>
+
+/**
+ * Nodo NUMA: un banco de memoria y los procesadores más cercanos a él.
+ */
+struct NodoNuma {
+    int id = 0;
+    std::vector<int> cpus;   // Solo los que el proceso tiene permitidos
+};
+
+/**
+ * Nodos NUMA de la máquina con sus procesadores.
+ *
+ * CÓMO: Lee /sys/devices/system/node/nodeN/cpulist y descarta los procesadores que
+ *       la máscara de afinidad del proceso no permite. Sin esa información (otro
+ *       sistema, contenedor) devuelve un solo nodo con todos los procesadores.
+ */
+std::vector<NodoNuma> topologiaNuma();
+
+/**
+ * Restringe el hilo actual a los procesadores indicados.
+ * @return false si el sistema no lo permitió.
+ */
+bool fijarHilo(const std::vector<int>& cpus);
+
+/**
+ * Copia del conjunto repartida en trozos de columnas ubicados en cada nodo NUMA.
+ *
+ * POR QUÉ: generarColeccion toca todas las páginas del vector desde un solo hilo,
+ *          así que en un servidor de dos sockets todo queda en un nodo y los hilos
+ *          del otro leen memoria remota y compiten por el mismo ancho de banda.
+ * CÓMO: Las filas se reparten entre los nodos en proporción a sus procesadores y,
+ *       dentro de cada nodo, en un trozo por hilo. Cada trozo lo construye un hilo
+ *       fijado a los procesadores de su nodo, y la política de primer toque del
+ *       kernel ubica sus páginas en ese nodo. Las consultas usan un hilo fijado igual
+ *       por trozo, que solo lee memoria local; los estados parciales se combinan en
+ *       orden de fila, así los empates se resuelven como en el recorrido secuencial.
+ * PARA QUÉ: Que el recorrido escale con el número de sockets.
+ */
+class ConjuntoNuma {
+public:
+    /**
+     * Reparte las personas entre los nodos.
+     * @param hilosPorNodo Trozos por nodo (0 = uno por procesador del nodo).
+     */
+    void construir(const std::vector<Persona>& personas, const std::vector<NodoNuma>& nodos,
+                   unsigned hilosPorNodo = 0);
+
+    /**
+     * Calcula el reporte completo (ver EstadoAgregado) con un hilo por trozo.
+     */
+    void reporte(EstadoAgregado& estado) const;
+
+    size_t nodos() const { return cantidadNodos; }
+    size_t hilos() const { return trozos.size(); }
+    size_t tamano() const;
+
+    /**
+     * Filas ubicadas en cada nodo, en el orden de topologiaNuma().
+     */
+    std::vector<size_t> filasPorNodo() const;
+
+private:
+    struct Trozo {
+        size_t nodo;              // Índice en el vector de nodos
+        std::vector<int> cpus;    // Procesadores del nodo
+        ColumnasPersona columnas;
+    };
+
+    std::vector<Trozo> trozos;    // En orden de fila
+    size_t cantidadNodos = 0;
+};
+
+#endif // NUMA_H
@@ -0,0 +1,173 @@
+#include "paginas.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#ifndef MADV_COLLAPSE
+#define MADV_COLLAPSE 25   // Linux 6.1; glibc todavía no lo declara en todas las versiones
+#endif
+
+namespace {
+
+const size_t PAGINA_GRANDE = 2 * 1024 * 1024;
+
+size_t redondear(size_t valor, size_t multiplo) { return (valor + multiplo - 1) / multiplo * multiplo; }
+
+PoliticaPaginas politicaGlobal;
+// Se crea una vez y no se destruye: las arenas que lo usan pueden vivir hasta el final del proceso
+RecursoPaginas* recursoGlobal = nullptr;
+std::atomic<size_t> colapsadas{0};
+std::atomic<size_t> bloqueosFallidos{0};
+
+// Toca una palabra por página; respaldo para kernels sin MADV_POPULATE_* (anteriores a 5.14)
+void tocarPaginas(char* inicio, size_t bytes, bool soloLectura) {
+    size_t pagina = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    for (size_t i = 0; i < bytes; i += pagina) {
+        if (soloLectura) {
+            (void)*static_cast<volatile char*>(inicio + i);
+        } else {
+            volatile char* p = inicio + i;
+            *p = *p;
+        }
+    }
+}
+
+void prellenar(char* inicio, size_t bytes, bool soloLectura) {
+    if (madvise(inicio, bytes, soloLectura ? MADV_POPULATE_READ : MADV_POPULATE_WRITE) != 0) {
+        tocarPaginas(inicio, bytes, soloLectura);
+    }
+}
+
+} // namespace
+
+void* RecursoPaginas::do_allocate(size_t bytes, size_t alineacion) {
+    if (alineacion > PAGINA_GRANDE) throw std::bad_alloc();
+    size_t longitud = redondear(std::max<size_t>(bytes, 1), PAGINA_GRANDE);
+    void* bloque = MAP_FAILED;
+    bool explicito = false;
+
+    if (politica.modo == PoliticaPaginas::Modo::Explicitas) {
+        int banderas = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (politica.prellenar ? MAP_POPULATE : 0);
+        bloque = mmap(nullptr, longitud, PROT_READ | PROT_WRITE, banderas, -1, 0);
+        explicito = bloque != MAP_FAILED;
+    }
+    if (bloque == MAP_FAILED) {
+        // Se pide 2 MB de más y se recorta para que el bloque quede alineado a una página grande
+        size_t holgura = longitud + PAGINA_GRANDE;
+        void* mapa = mmap(nullptr, holgura, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapa == MAP_FAILED) throw std::bad_alloc();
+        uintptr_t base = reinterpret_cast<uintptr_t>(mapa);
+        uintptr_t alineado = redondear(base, PAGINA_GRANDE);
+        if (alineado > base) munmap(mapa, alineado - base);
+        if (alineado + longitud < base + holgura) {
+            munmap(reinterpret_cast<void*>(alineado + longitud), base + holgura - alineado - longitud);
+        }
+        bloque = reinterpret_cast<void*>(alineado);
+        if (politica.modo != PoliticaPaginas::Modo::Normales) madvise(bloque, longitud, MADV_HUGEPAGE);
+        if (politica.prellenar) prellenar(static_cast<char*>(bloque), longitud, false);
+    }
+    bool bloqueado = !politica.bloquear || mlock(bloque, longitud) == 0;
+
+    std::lock_guard<std::mutex> bloqueo(mutex);
+    bloques[bloque] = longitud;
+    contadores.bytesMapeados += longitud;
+    if (explicito) contadores.bytesExplicitos += longitud;
+    if (politica.modo == PoliticaPaginas::Modo::Explicitas && !explicito) ++contadores.retrocesos;
+    if (!bloqueado) ++contadores.fallosBloqueo;
+    return bloque;
+}
+
+void RecursoPaginas::do_deallocate(void* p, size_t, size_t) {
+    size_t longitud;
+    {
+        std::lock_guard<std::mutex> bloqueo(mutex);
+        auto it = bloques.find(p);
+        if (it == bloques.end()) return;
+        longitud = it->second;
+        bloques.erase(it);
+    }
+    munmap(p, longitud);
+}
+
+EstadisticasPaginas RecursoPaginas::estadisticas() const {
+    std::lock_guard<std::mutex> bloqueo(mutex);
+    return contadores;
+}
+
+void configurarPaginas(const PoliticaPaginas& politica) {
+    politicaGlobal = politica;
+    recursoGlobal = politica.activa() ? new RecursoPaginas(politica) : nullptr;
+}
+
+const PoliticaPaginas& politicaPaginas() { return politicaGlobal; }
+
+std::unique_ptr<ArenaDatos> nuevaArenaDatos() {
+    if (!recursoGlobal) return std::make_unique<ArenaDatos>();
+    return std::make_unique<ArenaDatos>(PAGINA_GRANDE, recursoGlobal);
+}
+
+void prepararRegion(const void* inicio, size_t bytes, bool soloLectura) {
+    if (!politicaGlobal.activa() || bytes == 0) return;
+    char* base = static_cast<char*>(const_cast<void*>(inicio));
+    size_t pagina = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    // madvise y mlock trabajan sobre páginas completas
+    uintptr_t desde = reinterpret_cast<uintptr_t>(base) / pagina * pagina;
+    uintptr_t hasta = redondear(reinterpret_cast<uintptr_t>(base) + bytes, pagina);
+    char* region = reinterpret_cast<char*>(desde);
+    size_t longitud = hasta - desde;
+
+    if (politicaGlobal.modo != PoliticaPaginas::Modo::Normales) {
+        madvise(region, longitud, MADV_HUGEPAGE);
+        // Solo la parte alineada a 2 MB puede ser una página grande
+        uintptr_t desdeGrande = redondear(desde, PAGINA_GRANDE);
+        uintptr_t hastaGrande = hasta / PAGINA_GRANDE * PAGINA_GRANDE;
+        if (hastaGrande > desdeGrande &&
+            madvise(reinterpret_cast<void*>(desdeGrande), hastaGrande - desdeGrande, MADV_COLLAPSE) == 0) {
+            colapsadas.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    if (politicaGlobal.prellenar) prellenar(region, longitud, soloLectura);
+    if (politicaGlobal.bloquear && mlock(region, longitud) != 0) {
+        bloqueosFallidos.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+EstadisticasPaginas estadisticasPaginas() {
+    EstadisticasPaginas total = recursoGlobal ? recursoGlobal->estadisticas() : EstadisticasPaginas();
+    total.regionesColapsadas += colapsadas.load(std::memory_order_relaxed);
+    total.fallosBloqueo += bloqueosFallidos.load(std::memory_order_relaxed);
+    return total;
+}
+
+std::string describirPaginas() {
+    static const char* modos[] = {"normales", "transparentes", "explícitas"};
+    EstadisticasPaginas e = estadisticasPaginas();
+    std::ostringstream texto;
+    texto << "Páginas " << modos[static_cast<int>(politicaGlobal.modo)]
+          << (politicaGlobal.prellenar ? ", prellenadas" : "") << (politicaGlobal.bloquear ? ", bloqueadas" : "")
+          << ": arenas " << e.bytesMapeados / 1024 << " KB (" << e.bytesExplicitos / 1024 << " KB con MAP_HUGETLB";
+    if (e.retrocesos > 0) texto << ", " << e.retrocesos << " sin páginas reservadas";
+    texto << "), " << e.regionesColapsadas << " región(es) colapsada(s)";
+    if (e.fallosBloqueo > 0) texto << ", " << e.fallosBloqueo << " mlock rechazado(s)";
+
+    // Lo que el kernel realmente respalda con páginas grandes
+    std::ifstream rollup("/proc/self/smaps_rollup");
+    std::string linea;
+    while (std::getline(rollup, linea)) {
+        std::istringstream campos(linea);
+        std::string nombre;
+        long kb = 0;
+        if (!(campos >> nombre >> kb)) continue;
+        if (nombre == "AnonHugePages:" || nombre == "ShmemPmdMapped:" || nombre == "Private_Hugetlb:" ||
+            nombre == "Shared_Hugetlb:") {
+            nombre.pop_back();
+            texto << ", " << nombre << " " << kb << " KB";
+        }
+    }
+    return texto.str();
+}
@@ -0,0 +1,101 @@
+#ifndef PAGINAS_H
+#define PAGINAS_H
+
+#include "arena.h"
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * Cómo se respalda la memoria de los conjuntos de datos.
+ */
+struct PoliticaPaginas {
+    enum class Modo { Normales, Transparentes, Explicitas };
+    Modo modo = Modo::Normales;   // Normales: 4 KB; Transparentes: THP con madvise; Explicitas: MAP_HUGETLB
+    bool prellenar = false;       // Crear las tablas de páginas al reservar y no en el primer acceso
+    bool bloquear = false;        // mlock: que las páginas no salgan de la RAM
+
+    bool activa() const { return modo != Modo::Normales || prellenar || bloquear; }
+};
+
+/**
+ * Lo que realmente se obtuvo al aplicar la política (el kernel puede negarse).
+ */
+struct EstadisticasPaginas {
+    size_t bytesMapeados = 0;      // Bloques de arena reservados con mmap
+    size_t bytesExplicitos = 0;    // De ellos, respaldados con MAP_HUGETLB
+    size_t retrocesos = 0;         // MAP_HUGETLB sin páginas reservadas: se usaron páginas normales
+    size_t regionesColapsadas = 0; // Vectores convertidos a páginas grandes con MADV_COLLAPSE
+    size_t fallosBloqueo = 0;      // mlock rechazado (RLIMIT_MEMLOCK)
+};
+
+/**
+ * Recurso de memoria que entrega bloques mapeados con mmap según la política.
+ *
+ * POR QUÉ: Con páginas de 4 KB, recorrer 10M personas necesita cientos de miles de
+ *          entradas de TLB, y la primera consulta después de generar paga un fallo
+ *          de página por cada página que toca.
+ * CÓMO: Cada bloque es un mmap anónimo alineado a 2 MB: con MAP_HUGETLB (si no hay
+ *       páginas reservadas en /proc/sys/vm/nr_hugepages vuelve a páginas normales) o
+ *       con madvise(MADV_HUGEPAGE). Prellenar usa MAP_POPULATE o MADV_POPULATE_WRITE
+ *       después del madvise, para que los fallos ya se resuelvan con páginas grandes.
+ *       Bloquear aplica mlock al bloque.
+ * PARA QUÉ: Ser el origen de las arenas de textos (ArenaDatos) de cada conjunto.
+ */
+class RecursoPaginas : public std::pmr::memory_resource {
+public:
+    explicit RecursoPaginas(const PoliticaPaginas& politica) : politica(politica) {}
+
+    EstadisticasPaginas estadisticas() const;
+
+protected:
+    void* do_allocate(size_t bytes, size_t alineacion) override;
+    void do_deallocate(void* p, size_t bytes, size_t alineacion) override;
+    bool do_is_equal(const std::pmr::memory_resource& otro) const noexcept override { return this == &otro; }
+
+private:
+    PoliticaPaginas politica;
+    mutable std::mutex mutex;
+    std::unordered_map<void*, size_t> bloques;   // Inicio -> bytes mapeados
+    EstadisticasPaginas contadores;
+};
+
+/**
+ * Fija la política de páginas del proceso. Debe llamarse antes de crear conjuntos.
+ */
+void configurarPaginas(const PoliticaPaginas& politica);
+
+const PoliticaPaginas& politicaPaginas();
+
+/**
+ * Arena nueva para los textos de un conjunto, con origen en el recurso de páginas
+ * si hay una política activa (bloques iniciales de 2 MB para no desperdiciar páginas grandes).
+ */
+std::unique_ptr<ArenaDatos> nuevaArenaDatos();
+
+/**
+ * Aplica la política a una región ya reservada por otro asignador (el vector de
+ * personas, un segmento compartido adjuntado).
+ *
+ * Sobre la parte alineada a 2 MB aplica MADV_HUGEPAGE y MADV_COLLAPSE, que convierte
+ * en el momento las páginas ya escritas; MAP_HUGETLB no es posible aquí porque la
+ * memoria ya existe. Prellenar usa MADV_POPULATE_READ/WRITE y bloquear, mlock.
+ * @param soloLectura La región no admite escritura (se prellena para lectura).
+ */
+void prepararRegion(const void* inicio, size_t bytes, bool soloLectura);
+
+/**
+ * Contadores acumulados del proceso desde configurarPaginas.
+ */
+EstadisticasPaginas estadisticasPaginas();
+
+/**
+ * Resumen de una línea: política, contadores y páginas grandes del proceso según
+ * /proc/self/smaps_rollup (AnonHugePages, Shmem y Hugetlb).
+ */
+std::string describirPaginas();
+
+#endif // PAGINAS_H
@@ -5,21 +5,23 @@
  * Implementación del constructor de Persona.
  * 
  * POR QUÉ: Inicializar los miembros de la clase.
- * CÓMO: Usando la lista de inicialización y moviendo los strings para evitar copias.
+ * CÓMO: Usando la lista de inicialización; cada texto se copia una sola vez
+ *       al recurso de memoria recibido.
  * PARA QUÉ: Eficiencia y correcta construcción del objeto.
  */
-Persona::Persona(std::string nom, std::string ape, std::string id, 
-                 std::string ciudad, std::tuple<int,int,int> fecha, double ingresos, 
-                 double patri, double deud, std::string declara)
-    : nombre(std::move(nom)), 
-      apellido(std::move(ape)), 
-      id(std::move(id)), 
-      ciudadResidencia(std::move(ciudad)),
+Persona::Persona(std::string_view nom, std::string_view ape, std::string_view id, 
+                 std::string_view ciudad, std::tuple<int,int,int> fecha, double ingresos, 
+                 double patri, double deud, std::string_view declara,
+                 std::pmr::memory_resource* recurso)
+    : nombre(nom, recurso), 
+      apellido(ape, recurso), 
+      id(id, recurso), 
+      ciudadResidencia(ciudad, recurso),
       fechaNacimiento(std::move(fecha)), 
       ingresosAnuales(ingresos), 
       patrimonio(patri),
       deudas(deud), 
-      grupoDeclaracion(declara) {}
+      grupoDeclaracion(declara, recurso) {}
 
 /**
  * Implementación de mostrar.
@@ -2,6 +2,8 @@
 #define PERSONA_H
 
 #include <string>
+#include <string_view>
+#include <memory_resource>
 #include <iostream>
 #include <iomanip>
 #include <tuple>
@@ -15,15 +17,17 @@
  */
 class Persona {
 private:
-    std::string nombre;           // Nombre de pila
-    std::string apellido;         // Apellidos
-    std::string id;               // Identificador único (cédula)
-    std::string ciudadResidencia; // Ciudad de Residencia
+    // Los textos usan std::pmr::string para poder vivir en la arena del conjunto de datos.
+    // Las copias (consultas por valor) vuelven al recurso por defecto del programa.
+    std::pmr::string nombre;           // Nombre de pila
+    std::pmr::string apellido;         // Apellidos
+    std::pmr::string id;               // Identificador único (cédula)
+    std::pmr::string ciudadResidencia; // Ciudad de Residencia
     std::tuple<int,int,int> fechaNacimiento;  // Fecha de nacimiento en formato DD/MM/AAAA
     double ingresosAnuales;       // Ingresos anuales en pesos colombianos
     double patrimonio;            // Patrimonio total (activos)
     double deudas;                // Deudas totales (pasivos)
-    std::string grupoDeclaracion; // Grupo de declaracion(A/B/C)
+    std::pmr::string grupoDeclaracion; // Grupo de declaracion(A/B/C)
 
 public:
     Persona() = default;
@@ -31,23 +35,30 @@ public:
      * Constructor para inicializar todos los atributos de la persona.
      * 
      * POR QUÉ: Necesidad de crear instancias de Persona con todos sus datos.
-     * CÓMO: Recibe cada atributo por valor y los mueve a los miembros correspondientes.
-     * PARA QUÉ: Construir objetos Persona completos y válidos.
+     * CÓMO: Copia cada texto directamente en el recurso de memoria indicado.
+     * PARA QUÉ: Construir objetos Persona completos y válidos; con una arena
+     *           los textos de todo el conjunto se reservan sin malloc por persona.
      */
-    Persona(std::string nom, std::string ape, std::string id, 
-            std::string ciudad, std::tuple<int,int,int> fecha, double ingresos, 
-            double patri, double deud, std::string declara);
+    Persona(std::string_view nom, std::string_view ape, std::string_view id, 
+            std::string_view ciudad, std::tuple<int,int,int> fecha, double ingresos, 
+            double patri, double deud, std::string_view declara,
+            std::pmr::memory_resource* recurso = std::pmr::get_default_resource());
     
     // Métodos de acceso (getters) - Implementados inline para eficiencia
-    std::string getNombre() const { return nombre; }
-    std::string getApellido() const { return apellido; }
-    std::string getId() const { return id; }
-    std::string getCiudadNacimiento() const { return ciudadResidencia; }
+    std::string getNombre() const { return std::string(nombre); }
+    std::string getApellido() const { return std::string(apellido); }
+    std::string getId() const { return std::string(id); }
+    std::string getCiudadNacimiento() const { return std::string(ciudadResidencia); }
     std::tuple<int,int,int> getFechaNacimiento() const { return fechaNacimiento; }
     double getIngresosAnuales() const { return ingresosAnuales; }
     double getPatrimonio() const { return patrimonio; }
     double getDeudas() const { return deudas; }
-    std::string getGrupoDeclaracion() const { return grupoDeclaracion; }
+    std::string getGrupoDeclaracion() const { return std::string(grupoDeclaracion); }
+
+    // Vistas sin copia de las llaves de agrupación, válidas mientras viva la persona:
+    // los recorridos por ciudad o grupo no crean un std::string por fila
+    std::string_view getCiudadVista() const { return ciudadResidencia; }
+    std::string_view getGrupoVista() const { return grupoDeclaracion; }
 
     /**
      * Muestra toda la información de la persona de forma detallada.
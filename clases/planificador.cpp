@@ -0,0 +1,134 @@
+#include "planificador.h"
+#include <algorithm>
+
+namespace {
+
+thread_local unsigned indiceHilo = 0;
+
+// Generador xorshift por hilo para elegir víctimas sin compartir estado
+uint32_t azarHilo() {
+    thread_local uint32_t estado = 0x9E3779B9u ^ static_cast<uint32_t>(
+        std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    estado ^= estado << 13;
+    estado ^= estado >> 17;
+    estado ^= estado << 5;
+    return estado;
+}
+
+} // namespace
+
+PlanificadorTareas::PlanificadorTareas(unsigned hilos) {
+    if (hilos == 0) hilos = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned i = 0; i < hilos; ++i) colas.push_back(std::make_unique<Cola>());
+    for (unsigned i = 1; i < hilos; ++i) trabajadores.emplace_back([this, i]() { trabajar(i); });
+}
+
+PlanificadorTareas::~PlanificadorTareas() {
+    {
+        std::lock_guard<std::mutex> bloqueo(mutexEspera);
+        detenido = true;
+    }
+    hayTrabajo.notify_all();
+    for (auto& hilo : trabajadores) hilo.join();
+}
+
+unsigned PlanificadorTareas::hiloActual() { return indiceHilo; }
+
+void PlanificadorTareas::paraCada(size_t bloques, const std::function<void(size_t)>& cuerpo) {
+    if (bloques == 0) return;
+    std::lock_guard<std::mutex> turno(mutexTrabajo);
+    unsigned anterior = indiceHilo;
+    indiceHilo = 0;
+    this->cuerpo = &cuerpo;
+    pendientes.store(bloques, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> bloqueo(colas[0]->mutex);
+        colas[0]->rangos.push_back({0, bloques});
+    }
+    {
+        std::lock_guard<std::mutex> bloqueo(mutexEspera);
+        ++ronda;
+    }
+    hayTrabajo.notify_all();
+
+    // El que llama trabaja como hilo 0 hasta que no queden bloques
+    while (pendientes.load(std::memory_order_acquire) > 0) {
+        Rango rango;
+        if (tomar(0, rango) || robar(0, rango)) {
+            ejecutar(0, rango);
+        } else {
+            // Lo que queda ya lo tienen otros hilos
+            std::unique_lock<std::mutex> bloqueo(mutexEspera);
+            terminado.wait(bloqueo, [this]() { return pendientes.load(std::memory_order_acquire) == 0; });
+        }
+    }
+    this->cuerpo = nullptr;
+    indiceHilo = anterior;
+}
+
+void PlanificadorTareas::trabajar(unsigned indice) {
+    indiceHilo = indice;
+    size_t vista = 0;   // Última ronda atendida
+    while (true) {
+        {
+            std::unique_lock<std::mutex> bloqueo(mutexEspera);
+            hayTrabajo.wait(bloqueo, [&]() { return detenido || ronda != vista; });
+            if (detenido) return;
+            vista = ronda;
+        }
+        // Buscar trabajo propio o ajeno mientras queden bloques de esta ronda
+        while (pendientes.load(std::memory_order_acquire) > 0) {
+            Rango rango;
+            if (tomar(indice, rango) || robar(indice, rango)) {
+                ejecutar(indice, rango);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+}
+
+bool PlanificadorTareas::tomar(unsigned indice, Rango& rango) {
+    Cola& cola = *colas[indice];
+    std::lock_guard<std::mutex> bloqueo(cola.mutex);
+    if (cola.rangos.empty()) return false;
+    rango = cola.rangos.back();
+    cola.rangos.pop_back();
+    return true;
+}
+
+bool PlanificadorTareas::robar(unsigned indice, Rango& rango) {
+    unsigned n = hilos();
+    if (n < 2) return false;
+    unsigned inicio = azarHilo() % n;
+    for (unsigned k = 0; k < n; ++k) {
+        unsigned victima = (inicio + k) % n;
+        if (victima == indice) continue;
+        Cola& cola = *colas[victima];
+        std::lock_guard<std::mutex> bloqueo(cola.mutex);
+        if (cola.rangos.empty()) continue;
+        rango = cola.rangos.front();
+        cola.rangos.pop_front();
+        contadorRobos.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void PlanificadorTareas::ejecutar(unsigned indice, Rango rango) {
+    // Partir por la mitad y dejar la derecha a disposición de los ladrones
+    while (rango.fin - rango.inicio > 1) {
+        size_t mitad = rango.inicio + (rango.fin - rango.inicio) / 2;
+        {
+            std::lock_guard<std::mutex> bloqueo(colas[indice]->mutex);
+            colas[indice]->rangos.push_back({mitad, rango.fin});
+        }
+        rango.fin = mitad;
+    }
+    (*cuerpo)(rango.inicio);
+    contadorTareas.fetch_add(1, std::memory_order_relaxed);
+    if (pendientes.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> bloqueo(mutexEspera);
+        terminado.notify_all();
+    }
+}
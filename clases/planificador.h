@@ -0,0 +1,89 @@
+#ifndef PLANIFICADOR_H
+#define PLANIFICADOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Grupo de hilos con robo de trabajo para recorrer bloques de filas en paralelo.
+ *
+ * POR QUÉ: Repartir el trabajo por ciudad entre hilos deja núcleos ociosos cuando la
+ *          población está sesgada (Bogotá tiene muchas más filas que Tunja), y un
+ *          reparto fijo por filas sufre lo mismo si un hilo se retrasa.
+ * CÓMO: Cada hilo tiene su cola doble de rangos de bloques. Un rango grande se parte
+ *       por la mitad: el hilo deja la mitad derecha al final de su cola y sigue con
+ *       la izquierda, hasta llegar a un solo bloque. El dueño toma de su cola por el
+ *       final (lo más reciente, aún en caché) y un hilo sin trabajo roba del frente
+ *       de la cola de una víctima elegida al azar (los rangos más grandes, así un
+ *       robo reparte mucho trabajo). El hilo que llama a paraCada también trabaja.
+ * PARA QUÉ: Que el tiempo de los reportes por ciudad y por grupo y de la generación
+ *           dependa del total de filas y no de cómo se reparten entre llaves.
+ */
+class PlanificadorTareas {
+public:
+    /**
+     * @param hilos Hilos en total, contando al que llama a paraCada (0 = todos los núcleos).
+     */
+    explicit PlanificadorTareas(unsigned hilos = 0);
+    ~PlanificadorTareas();
+    PlanificadorTareas(const PlanificadorTareas&) = delete;
+    PlanificadorTareas& operator=(const PlanificadorTareas&) = delete;
+
+    unsigned hilos() const { return static_cast<unsigned>(colas.size()); }
+
+    /**
+     * Índice del hilo que ejecuta el bloque actual, en [0, hilos()); 0 es el que
+     * llamó a paraCada. Sirve para dar a cada hilo su propio estado (p. ej. una arena).
+     */
+    static unsigned hiloActual();
+
+    /**
+     * Ejecuta cuerpo(b) para cada bloque b en [0, bloques) y espera a que terminen.
+     * Los bloques corren en cualquier orden y en cualquier hilo; cuerpo no debe lanzar
+     * excepciones ni volver a llamar a paraCada. Las llamadas concurrentes se atienden
+     * una tras otra.
+     */
+    void paraCada(size_t bloques, const std::function<void(size_t)>& cuerpo);
+
+    size_t tareas() const { return contadorTareas.load(std::memory_order_relaxed); }
+    size_t robos() const { return contadorRobos.load(std::memory_order_relaxed); }
+
+private:
+    struct Rango {
+        size_t inicio, fin;   // Bloques [inicio, fin)
+    };
+
+    struct alignas(64) Cola {
+        std::mutex mutex;
+        std::deque<Rango> rangos;
+    };
+
+    void trabajar(unsigned indice);
+    bool tomar(unsigned indice, Rango& rango);
+    bool robar(unsigned indice, Rango& rango);
+    void ejecutar(unsigned indice, Rango rango);
+
+    std::vector<std::unique_ptr<Cola>> colas;          // Una por hilo; la 0 es del que llama
+    std::vector<std::thread> trabajadores;
+
+    std::mutex mutexTrabajo;                            // Serializa las llamadas a paraCada
+    std::mutex mutexEspera;
+    std::condition_variable hayTrabajo;                 // Despierta a los hilos dormidos
+    std::condition_variable terminado;                  // Avisa al que llamó que no quedan bloques
+    const std::function<void(size_t)>* cuerpo = nullptr;
+    size_t ronda = 0;                                   // Cuenta los paraCada (protegida por mutexEspera)
+    std::atomic<size_t> pendientes{0};                  // Bloques sin terminar
+    bool detenido = false;
+
+    std::atomic<size_t> contadorTareas{0};
+    std::atomic<size_t> contadorRobos{0};
+};
+
+#endif // PLANIFICADOR_H
@@ -0,0 +1,288 @@
+#include "procesos.h"
+#include "binario.h"
+#include "columnas.h"
+#include "consultas.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+const double UMBRAL_LISTADO = 1'000'000'000.0;   // Mismo umbral de la opción 18
+
+/**
+ * Rango contiguo de filas del vector original.
+ */
+struct TramoPersonas {
+    const Persona* filas;
+    size_t n;
+};
+
+// Política de consultas.h sobre un tramo: las mismas lecturas que las funciones por
+// referencia de generador.cpp, con índices relativos al inicio del tramo
+struct LayoutTramo {
+    using Almacen = TramoPersonas;
+    using Clave = std::string;
+
+    static size_t tamano(const Almacen& a) { return a.n; }
+    static Clave ciudad(const Almacen& a, size_t i) { return a.filas[i].getCiudadNacimiento(); }
+    static Clave grupo(const Almacen& a, size_t i) { return a.filas[i].getGrupoDeclaracion(); }
+    static int32_t fecha(const Almacen& a, size_t i) { return empaquetarFecha(a.filas[i].getFechaNacimiento()); }
+    static double patrimonio(const Almacen& a, size_t i) { return a.filas[i].getPatrimonio(); }
+    static double deudas(const Almacen& a, size_t i) { return a.filas[i].getDeudas(); }
+};
+
+/**
+ * Parcial que calcula un hijo sobre [inicio, fin), con índices absolutos:
+ *   2, 6, 14   -> u64 fila
+ *   4, 8, 10   -> u32 n y n veces (texto llave, u64 fila)
+ *   16         -> u32 n y n veces (texto ciudad, long double total)
+ *   18         -> u32 n y n veces (texto ciudad, u32 m, m veces u64 fila)
+ */
+std::string calcularParcial(int consulta, const std::vector<Persona>& personas, size_t inicio, size_t fin) {
+    using L = LayoutTramo;
+    TramoPersonas tramo{personas.data() + inicio, fin - inicio};
+    EscritorBinario w;
+    auto escribirPorLlave = [&](const MapaPlano<std::string, size_t>& resultado) {
+        w.valor(static_cast<uint32_t>(resultado.size()));
+        for (const auto& [llave, fila] : resultado) {
+            w.texto(llave);
+            w.valor(static_cast<uint64_t>(inicio + fila));
+        }
+    };
+    switch (consulta) {
+        case 2: w.valor(static_cast<uint64_t>(inicio + longevaPais<L>(tramo))); break;
+        case 4: escribirPorLlave(longevaPorCiudad<L>(tramo)); break;
+        case 6: w.valor(static_cast<uint64_t>(inicio + mayorPatrimonioPais<L>(tramo))); break;
+        case 8: escribirPorLlave(mayorPatrimonioPorCiudad<L>(tramo)); break;
+        case 10: escribirPorLlave(mayorPatrimonioPorGrupo<L>(tramo)); break;
+        case 14: w.valor(static_cast<uint64_t>(inicio + mayorDeudaPais<L>(tramo))); break;
+        case 16: {
+            // Se envían todos los totales: la ciudad ganadora depende de las sumas de todos los rangos
+            MapaPlano<std::string, long double> totales;
+            for (size_t i = 0; i < tramo.n; ++i) {
+                totales.insertar(L::ciudad(tramo, i), 0.0L).first->second += L::patrimonio(tramo, i);
+            }
+            w.valor(static_cast<uint32_t>(totales.size()));
+            for (const auto& [ciudad, total] : totales) {
+                w.texto(ciudad);
+                w.valor(total);
+            }
+            break;
+        }
+        case 18: {
+            auto resultado = listarPatrimonioMayor<L>(tramo, UMBRAL_LISTADO);
+            w.valor(static_cast<uint32_t>(resultado.size()));
+            for (const auto& [ciudad, filas] : resultado) {
+                w.texto(ciudad);
+                w.valor(static_cast<uint32_t>(filas.size()));
+                for (size_t fila : filas) w.valor(static_cast<uint64_t>(inicio + fila));
+            }
+            break;
+        }
+    }
+    return std::move(w.bytes);
+}
+
+/**
+ * Suma el parcial de un rango a los de los rangos anteriores.
+ *
+ * La fila candidata solo reemplaza a la actual si es estrictamente mejor, así
+ * que en un empate gana la de menor índice, como en el recorrido secuencial.
+ */
+bool combinarParcial(int consulta, const std::vector<Persona>& personas, const std::string& parcial, bool primero,
+                     ResultadoParticionado& resultado) {
+    auto mejor = [&](size_t actual, size_t candidata) {
+        const Persona& a = personas[actual];
+        const Persona& c = personas[candidata];
+        switch (consulta) {
+            case 2:
+            case 4: return empaquetarFecha(c.getFechaNacimiento()) < empaquetarFecha(a.getFechaNacimiento());
+            case 14: return a.getDeudas() < c.getDeudas();
+            default: return a.getPatrimonio() - a.getDeudas() < c.getPatrimonio() - c.getDeudas();
+        }
+    };
+    LectorBinario lector(parcial.data(), parcial.size());
+    auto leerFila = [&](size_t& fila) {
+        uint64_t valor;
+        if (!lector.valor(valor) || valor >= personas.size()) return false;
+        fila = static_cast<size_t>(valor);
+        return true;
+    };
+    std::string llave;
+    size_t fila = 0;
+    uint32_t n = 0;
+    switch (consulta) {
+        case 2:
+        case 6:
+        case 14:
+            if (!leerFila(fila)) return false;
+            if (primero || mejor(resultado.fila, fila)) resultado.fila = fila;
+            break;
+        case 4:
+        case 8:
+        case 10:
+            if (!lector.valor(n)) return false;
+            for (uint32_t i = 0; i < n; ++i) {
+                if (!lector.texto(llave) || !leerFila(fila)) return false;
+                auto [entrada, nueva] = resultado.porLlave.insertar(llave, fila);
+                if (!nueva && mejor(entrada->second, fila)) entrada->second = fila;
+            }
+            break;
+        case 16:
+            if (!lector.valor(n)) return false;
+            for (uint32_t i = 0; i < n; ++i) {
+                long double total;
+                if (!lector.texto(llave) || !lector.valor(total)) return false;
+                resultado.totales.insertar(llave, 0.0L).first->second += total;
+            }
+            break;
+        case 18:
+            if (!lector.valor(n)) return false;
+            for (uint32_t i = 0; i < n; ++i) {
+                uint32_t m;
+                if (!lector.texto(llave) || !lector.valor(m)) return false;
+                auto& filas = resultado.listado[llave];
+                for (uint32_t j = 0; j < m; ++j) {
+                    if (!leerFila(fila)) return false;
+                    filas.push_back(fila);
+                }
+            }
+            break;
+    }
+    return lector.restantes() == 0;
+}
+
+// Escribe todo el búfer; false si la tubería se cerró
+bool escribirTodo(int fd, const std::string& datos) {
+    size_t escritos = 0;
+    while (escritos < datos.size()) {
+        ssize_t r = write(fd, datos.data() + escritos, datos.size() - escritos);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return false;
+        escritos += static_cast<size_t>(r);
+    }
+    return true;
+}
+
+struct Hijo {
+    pid_t pid;
+    int tuberia;           // Extremo de lectura (-1 al llegar al final)
+    size_t inicio, fin;    // Filas asignadas
+    std::string parcial;
+};
+
+} // namespace
+
+bool consultaMultiproceso(int consulta, const std::vector<Persona>& personas, unsigned procesos,
+                          ResultadoParticionado& resultado, std::string& error) {
+    resultado = ResultadoParticionado();
+    if (personas.empty()) {
+        error = "No hay datos disponibles";
+        return false;
+    }
+    size_t n = std::min<size_t>(std::max(procesos, 1u), personas.size());
+
+    std::vector<Hijo> hijos;
+    for (size_t k = 0; k < n; ++k) {
+        size_t inicio = personas.size() * k / n;
+        size_t fin = personas.size() * (k + 1) / n;
+        int tuberia[2];
+        if (pipe(tuberia) != 0) {
+            error = std::string("pipe: ") + std::strerror(errno);
+            break;
+        }
+        pid_t pid = fork();
+        if (pid < 0) {
+            error = std::string("fork: ") + std::strerror(errno);
+            close(tuberia[0]);
+            close(tuberia[1]);
+            break;
+        }
+        if (pid == 0) {
+            // Hijo: solo conserva su extremo de escritura. _exit evita vaciar los búferes
+            // de stdio heredados del padre (se imprimirían dos veces)
+            close(tuberia[0]);
+            for (const Hijo& anterior : hijos) close(anterior.tuberia);
+            bool enviado = escribirTodo(tuberia[1], calcularParcial(consulta, personas, inicio, fin));
+            _exit(enviado ? 0 : 1);
+        }
+        close(tuberia[1]);
+        hijos.push_back({pid, tuberia[0], inicio, fin, {}});
+    }
+
+    // Se leen todas las tuberías a la vez para que ningún hijo quede bloqueado escribiendo
+    std::vector<pollfd> esperas;
+    size_t abiertas = hijos.size();
+    while (abiertas > 0) {
+        esperas.clear();
+        for (const Hijo& hijo : hijos) {
+            if (hijo.tuberia >= 0) esperas.push_back({hijo.tuberia, POLLIN, 0});
+        }
+        if (poll(esperas.data(), esperas.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            error = std::string("poll: ") + std::strerror(errno);
+            break;
+        }
+        for (Hijo& hijo : hijos) {
+            if (hijo.tuberia < 0) continue;
+            auto espera = std::find_if(esperas.begin(), esperas.end(),
+                                       [&](const pollfd& p) { return p.fd == hijo.tuberia; });
+            if (espera == esperas.end() || espera->revents == 0) continue;
+            char bufer[64 * 1024];
+            ssize_t leidos = read(hijo.tuberia, bufer, sizeof(bufer));
+            if (leidos > 0) {
+                hijo.parcial.append(bufer, static_cast<size_t>(leidos));
+            } else if (leidos == 0 || errno != EINTR) {
+                close(hijo.tuberia);
+                hijo.tuberia = -1;
+                --abiertas;
+            }
+        }
+    }
+
+    // Un hijo que falla (señal, código distinto de 0) solo invalida esta consulta
+    for (Hijo& hijo : hijos) {
+        if (hijo.tuberia >= 0) close(hijo.tuberia);
+        int estado = 0;
+        while (waitpid(hijo.pid, &estado, 0) < 0 && errno == EINTR) {}
+        if (!error.empty()) continue;
+        std::string rango = " (filas " + std::to_string(hijo.inicio) + "-" + std::to_string(hijo.fin) + ")";
+        if (WIFSIGNALED(estado)) {
+            error = "El proceso " + std::to_string(hijo.pid) + rango + " terminó por la señal " +
+                    std::to_string(WTERMSIG(estado));
+        } else if (!WIFEXITED(estado) || WEXITSTATUS(estado) != 0) {
+            error = "El proceso " + std::to_string(hijo.pid) + rango + " terminó con error";
+        }
+    }
+    if (!error.empty()) return false;
+
+    for (size_t k = 0; k < hijos.size(); ++k) {
+        resultado.bytesRecibidos += hijos[k].parcial.size();
+        if (!combinarParcial(consulta, personas, hijos[k].parcial, k == 0, resultado)) {
+            error = "Parcial inválido del proceso " + std::to_string(hijos[k].pid);
+            return false;
+        }
+    }
+    resultado.partes = hijos.size();
+    return true;
+}
+
+void consultaConTareas(int consulta, const std::vector<Persona>& personas, PlanificadorTareas& planificador,
+                       size_t grano, ResultadoParticionado& resultado) {
+    resultado = ResultadoParticionado();
+    grano = std::max<size_t>(grano, 1);
+    size_t bloques = (personas.size() + grano - 1) / grano;
+    std::vector<std::string> parciales(bloques);
+    planificador.paraCada(bloques, [&](size_t b) {
+        parciales[b] = calcularParcial(consulta, personas, b * grano, std::min(personas.size(), (b + 1) * grano));
+    });
+    for (size_t b = 0; b < bloques; ++b) {
+        resultado.bytesRecibidos += parciales[b].size();
+        combinarParcial(consulta, personas, parciales[b], b == 0, resultado);
+    }
+    resultado.partes = bloques;
+}
@@ -0,0 +1,65 @@
+#ifndef PROCESOS_H
+#define PROCESOS_H
+
+#include "persona.h"
+#include "mapa_plano.h"
+#include "planificador.h"
+#include <string>
+#include <vector>
+
+// Consultas por referencia (opciones 2, 4, 6, 8, 10, 14, 16 y 18) repartidas por
+// rangos de filas: en procesos hijos o en tareas del planificador. Ambas versiones
+// calculan el mismo parcial por rango y lo combinan igual, así que dan el mismo
+// resultado que el recorrido secuencial.
+
+/**
+ * Resultado combinado de una consulta ejecutada por partes.
+ *
+ * Guarda índices de fila del vector original (el padre tiene las mismas filas que
+ * los hijos), así que mostrar el resultado no necesita copiar personas.
+ */
+struct ResultadoParticionado {
+    size_t fila = 0;                                        // Opciones 2, 6 y 14
+    MapaPlano<std::string, size_t> porLlave;                // Opciones 4, 8 y 10
+    MapaPlano<std::string, long double> totales;            // Opción 16 (patrimonio por ciudad)
+    MapaPlano<std::string, std::vector<size_t>> listado;    // Opción 18 (en orden de fila)
+    size_t partes = 0;                                      // Procesos hijos o bloques de filas
+    size_t bytesRecibidos = 0;                              // Tamaño de los parciales combinados
+};
+
+/**
+ * Ejecuta una consulta por referencia repartiendo las filas entre procesos hijos.
+ *
+ * POR QUÉ: Un reporte largo que falla dentro de un hilo tumba todo el programa, y
+ *          hacía falta una base con procesos para compararla con la versión con hilos.
+ * CÓMO: fork() crea un hijo por rango contiguo de filas; el hijo ve el vector del
+ *       padre por copia en escritura (solo lo lee, así que no se copia ninguna
+ *       página), calcula el parcial de la consulta con consultas.h sobre su rango y lo
+ *       escribe en su tubería con la codificación de binario.h: índices de fila,
+ *       llaves y sumas, nunca personas. El padre lee todas las tuberías con poll,
+ *       combina los parciales en orden de rango (los empates se resuelven como en el
+ *       recorrido secuencial) y recoge a cada hijo con waitpid.
+ * PARA QUÉ: Aislar fallos (un hijo que muere se informa como error sin afectar al
+ *           padre) y medir el costo de procesos frente a hilos.
+ * @param consulta Opción del menú: 2, 4, 6, 8, 10, 14, 16 o 18.
+ * @param procesos Hijos a crear (se limita al número de filas).
+ * @return false si no se pudo crear un hijo o alguno falló; el motivo queda en error.
+ */
+bool consultaMultiproceso(int consulta, const std::vector<Persona>& personas, unsigned procesos,
+                          ResultadoParticionado& resultado, std::string& error);
+
+/**
+ * Ejecuta una consulta por referencia en bloques de filas con robo de trabajo.
+ *
+ * POR QUÉ: Con la población sesgada, repartir las ciudades o los grupos entre hilos
+ *          deja a uno con Bogotá y al resto esperando.
+ * CÓMO: El trabajo se parte por filas, no por llaves: cada bloque de grano filas es
+ *       una tarea del planificador que calcula el mismo parcial que un proceso hijo;
+ *       los parciales se combinan en orden de bloque.
+ * PARA QUÉ: Reportes por ciudad y por grupo cuyo tiempo no depende del sesgo.
+ * @param grano Filas por tarea.
+ */
+void consultaConTareas(int consulta, const std::vector<Persona>& personas, PlanificadorTareas& planificador,
+                       size_t grano, ResultadoParticionado& resultado);
+
+#endif // PROCESOS_H
@@ -0,0 +1,552 @@
+#include "servidor.h"
+#include "binario.h"
+#include "generador.h"
+#include "consultas.h"
+#include "layouts.h"
+#include "columnas.h"
+#include "mapa_plano.h"
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+const size_t MAXIMA_SOLICITUD = 4096;            // Bytes de una solicitud sin el prefijo de longitud
+const double UMBRAL_POR_DEFECTO = 1'000'000'000.0;
+
+// Arma una respuesta completa: prefijo de longitud, estado, versión y resultado
+std::string armarRespuesta(EstadoRespuesta estado, uint64_t version, const std::string& resultado) {
+    EscritorBinario w;
+    w.valor(static_cast<uint32_t>(sizeof(uint8_t) + sizeof(uint64_t) + resultado.size()));
+    w.valor(static_cast<uint8_t>(estado));
+    w.valor(version);
+    w.bytes += resultado;
+    return std::move(w.bytes);
+}
+
+template <class Mapa>
+void escribirPorLlave(EscritorBinario& w, const Mapa& resultado) {
+    w.valor(static_cast<uint32_t>(resultado.size()));
+    for (const auto& [llave, persona] : resultado) {
+        w.texto(llave);
+        w.persona(*persona);
+    }
+}
+
+/**
+ * Calcula la respuesta de una solicitud (sin su prefijo de longitud).
+ *
+ * Fija la versión vigente al empezar y la usa hasta el final; los resultados
+ * temporales van a una arena local que se libera de una vez.
+ */
+std::string responder(const std::string& solicitud, const PublicadorDatos& datos) {
+    LectorBinario lector(solicitud.data(), solicitud.size());
+    uint8_t consulta;
+    if (!lector.valor(consulta)) return armarRespuesta(EstadoRespuesta::SolicitudInvalida, 0, "");
+    double umbral = UMBRAL_POR_DEFECTO;
+    if (consulta == 18 && lector.restantes() >= sizeof(double)) lector.valor(umbral);
+
+    auto vigente = datos.fijar();
+    uint64_t version = vigente ? vigente->version : 0;
+    EscritorBinario w;
+    if (consulta == 0) {
+        w.valor(static_cast<uint64_t>(vigente ? vigente->personas.size() : 0));
+        return armarRespuesta(EstadoRespuesta::Ok, version, w.bytes);
+    }
+    bool conocida = consulta == 2 || consulta == 4 || consulta == 6 || consulta == 8 || consulta == 10 ||
+                    consulta == 14 || consulta == 16 || consulta == 18;
+    if (!conocida) return armarRespuesta(EstadoRespuesta::ConsultaDesconocida, version, "");
+    if (!vigente || vigente->personas.empty()) return armarRespuesta(EstadoRespuesta::SinDatos, version, "");
+
+    const std::vector<Persona>& personas = vigente->personas;
+    std::pmr::monotonic_buffer_resource temporal;
+    switch (consulta) {
+        case 2:
+            w.persona(*buscarLongevaPaisReferencia(personas));
+            break;
+        case 4:
+            escribirPorLlave(w, mostrarPersonasLongevasCiudadReferencia(personas, &temporal));
+            break;
+        case 6:
+            w.persona(*buscarMayorPatrimonioPaisReferencia(personas));
+            break;
+        case 8:
+            escribirPorLlave(w, buscarMayorPatrimonioCiudadReferencia(personas, &temporal));
+            break;
+        case 10:
+            escribirPorLlave(w, buscarMayorPatrimonioGrupoReferencia(personas, &temporal));
+            break;
+        case 14:
+            w.persona(*buscarMayorDeudaPaisReferencia(personas));
+            break;
+        case 16: {
+            auto resultado = buscarCiudadMayorPatrimonioReferencia(personas, &temporal);
+            w.texto(resultado.first);
+            w.valor(resultado.second);   // long double completo, como lo calcula la consulta local
+            break;
+        }
+        case 18: {
+            auto resultado = listarPatrimonioMayor<LayoutClase>(personas, umbral);
+            w.valor(static_cast<uint32_t>(resultado.size()));
+            for (const auto& [ciudad, filas] : resultado) {
+                w.texto(ciudad);
+                w.valor(static_cast<uint32_t>(filas.size()));
+                for (size_t i : filas) {
+                    w.texto(personas[i].getNombre());
+                    w.texto(personas[i].getApellido());
+                    w.valor(personas[i].getPatrimonio());
+                }
+            }
+            break;
+        }
+    }
+    return armarRespuesta(EstadoRespuesta::Ok, version, w.bytes);
+}
+
+struct Tarea {
+    int fd;
+    uint64_t serie;          // Identifica la conexión aunque el descriptor se reutilice
+    std::string solicitud;
+};
+
+/**
+ * Hilos que calculan las consultas fuera del bucle de eventos.
+ *
+ * Las tareas entran por una cola protegida con un mutex; cada respuesta terminada
+ * se deja en otra lista y se avisa al bucle escribiendo en el eventfd.
+ */
+class GrupoTrabajadores {
+public:
+    GrupoTrabajadores(unsigned n, const PublicadorDatos& datos, int aviso) : datos(datos), aviso(aviso) {
+        for (unsigned i = 0; i < n; ++i) hilos.emplace_back([this]() { trabajar(); });
+    }
+
+    ~GrupoTrabajadores() {
+        {
+            std::lock_guard<std::mutex> bloqueo(mutex);
+            detenido = true;
+        }
+        hayTareas.notify_all();
+        for (auto& hilo : hilos) hilo.join();
+    }
+
+    void encolar(Tarea tarea) {
+        {
+            std::lock_guard<std::mutex> bloqueo(mutex);
+            tareas.push_back(std::move(tarea));
+        }
+        hayTareas.notify_one();
+    }
+
+    std::vector<Tarea> recoger() {
+        std::lock_guard<std::mutex> bloqueo(mutex);
+        return std::exchange(terminadas, {});
+    }
+
+private:
+    void trabajar() {
+        while (true) {
+            Tarea tarea;
+            {
+                std::unique_lock<std::mutex> bloqueo(mutex);
+                hayTareas.wait(bloqueo, [this]() { return detenido || !tareas.empty(); });
+                if (detenido) return;
+                tarea = std::move(tareas.front());
+                tareas.pop_front();
+            }
+            // La respuesta reemplaza a la solicitud en la misma tarea
+            tarea.solicitud = responder(tarea.solicitud, datos);
+            {
+                std::lock_guard<std::mutex> bloqueo(mutex);
+                terminadas.push_back(std::move(tarea));
+            }
+            uint64_t uno = 1;
+            ssize_t escritos = write(aviso, &uno, sizeof(uno));
+            (void)escritos;   // Si el contador ya tiene avisos pendientes, el bucle igual despierta
+        }
+    }
+
+    const PublicadorDatos& datos;
+    int aviso;
+    std::mutex mutex;
+    std::condition_variable hayTareas;
+    std::deque<Tarea> tareas;
+    std::vector<Tarea> terminadas;
+    bool detenido = false;
+    std::vector<std::thread> hilos;
+};
+
+struct Conexion {
+    uint64_t serie = 0;
+    std::string entrada;        // Bytes recibidos que aún no forman una solicitud procesada
+    std::string salida;         // Respuestas por enviar
+    size_t enviados = 0;        // Bytes de salida ya enviados
+    bool enCurso = false;       // Hay una solicitud en los trabajadores (se responden en orden)
+    bool esperandoEscritura = false;   // EPOLLOUT registrado
+};
+
+/**
+ * Bucle de eventos del servidor: aceptar, leer, despachar y escribir sin bloquearse.
+ */
+class BucleServidor {
+public:
+    BucleServidor(int epoll, int escucha, GrupoTrabajadores& trabajadores)
+        : epoll(epoll), escucha(escucha), trabajadores(trabajadores) {}
+
+    void aceptar() {
+        while (true) {
+            int fd = accept4(escucha, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) return;   // EAGAIN: no quedan conexiones pendientes
+            epoll_event ev{};
+            ev.events = EPOLLIN | EPOLLRDHUP;
+            ev.data.fd = fd;
+            epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &ev);
+            conexiones.insertar(fd).first->second.serie = ++series;
+            ++clientes;
+        }
+    }
+
+    void leer(int fd) {
+        char bufer[64 * 1024];
+        while (true) {
+            ssize_t leidos = read(fd, bufer, sizeof(bufer));
+            if (leidos > 0) {
+                conexiones.buscar(fd)->second.entrada.append(bufer, static_cast<size_t>(leidos));
+            } else if (leidos < 0 && errno == EINTR) {
+                continue;
+            } else if (leidos < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            } else {
+                cerrar(fd);   // Fin de archivo o error
+                return;
+            }
+        }
+        despachar(fd);
+    }
+
+    // Intenta enviar lo pendiente; false si la conexión se cerró
+    bool escribir(int fd) {
+        Conexion& c = conexiones.buscar(fd)->second;
+        while (c.enviados < c.salida.size()) {
+            ssize_t enviados = send(fd, c.salida.data() + c.enviados, c.salida.size() - c.enviados, MSG_NOSIGNAL);
+            if (enviados >= 0) {
+                c.enviados += static_cast<size_t>(enviados);
+            } else if (errno == EINTR) {
+                continue;
+            } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                esperarEscritura(fd, c, true);
+                return true;
+            } else {
+                cerrar(fd);
+                return false;
+            }
+        }
+        c.salida.clear();
+        c.enviados = 0;
+        esperarEscritura(fd, c, false);
+        return true;
+    }
+
+    void entregar() {
+        for (Tarea& tarea : trabajadores.recoger()) {
+            auto* entrada = conexiones.buscar(tarea.fd);
+            // La conexión se cerró (y quizá su descriptor ya es de otra) antes de la respuesta
+            if (entrada == nullptr || entrada->second.serie != tarea.serie) continue;
+            entrada->second.salida += tarea.solicitud;
+            entrada->second.enCurso = false;
+            ++respondidas;
+            if (escribir(tarea.fd)) despachar(tarea.fd);
+        }
+    }
+
+    void cerrarTodas() {
+        std::vector<int> abiertas;
+        for (const auto& [fd, conexion] : conexiones) abiertas.push_back(fd);
+        for (int fd : abiertas) cerrar(fd);
+    }
+
+    size_t clientes = 0;
+    size_t respondidas = 0;
+
+private:
+    // Pasa a los trabajadores la siguiente solicitud completa, si no hay otra en curso
+    void despachar(int fd) {
+        Conexion& c = conexiones.buscar(fd)->second;
+        if (c.enCurso || c.entrada.size() < sizeof(uint32_t)) return;
+        uint32_t longitud;
+        std::memcpy(&longitud, c.entrada.data(), sizeof(longitud));
+        if (longitud == 0 || longitud > MAXIMA_SOLICITUD) {
+            cerrar(fd);
+            return;
+        }
+        if (c.entrada.size() < sizeof(uint32_t) + longitud) return;
+        Tarea tarea{fd, c.serie, c.entrada.substr(sizeof(uint32_t), longitud)};
+        c.entrada.erase(0, sizeof(uint32_t) + longitud);
+        c.enCurso = true;
+        trabajadores.encolar(std::move(tarea));
+    }
+
+    void esperarEscritura(int fd, Conexion& c, bool activar) {
+        if (c.esperandoEscritura == activar) return;
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLRDHUP | (activar ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+        ev.data.fd = fd;
+        epoll_ctl(epoll, EPOLL_CTL_MOD, fd, &ev);
+        c.esperandoEscritura = activar;
+    }
+
+    void cerrar(int fd) {
+        epoll_ctl(epoll, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        conexiones.borrar(fd);
+    }
+
+    int epoll;
+    int escucha;
+    GrupoTrabajadores& trabajadores;
+    MapaPlano<int, Conexion> conexiones;
+    uint64_t series = 0;
+};
+
+// Conecta un socket al servidor; -1 si falla
+int conectar(const std::string& ruta, std::string& error) {
+    sockaddr_un direccion{};
+    if (ruta.size() >= sizeof(direccion.sun_path)) {
+        error = "Ruta de socket demasiado larga: " + ruta;
+        return -1;
+    }
+    direccion.sun_family = AF_UNIX;
+    std::memcpy(direccion.sun_path, ruta.c_str(), ruta.size() + 1);
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&direccion), sizeof(direccion)) < 0) {
+        error = "No se pudo conectar a " + ruta + ": " + std::strerror(errno);
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+} // namespace
+
+bool ejecutarServidor(const std::string& ruta, unsigned trabajadores, const PublicadorDatos& datos,
+                      std::string& error) {
+    sockaddr_un direccion{};
+    if (ruta.size() >= sizeof(direccion.sun_path)) {
+        error = "Ruta de socket demasiado larga: " + ruta;
+        return false;
+    }
+    // Un socket que quedó de una ejecución anterior se reemplaza; cualquier otro archivo no
+    struct stat info;
+    if (stat(ruta.c_str(), &info) == 0) {
+        if (!S_ISSOCK(info.st_mode)) {
+            error = "La ruta existe y no es un socket: " + ruta;
+            return false;
+        }
+        unlink(ruta.c_str());
+    }
+    direccion.sun_family = AF_UNIX;
+    std::memcpy(direccion.sun_path, ruta.c_str(), ruta.size() + 1);
+    int escucha = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (escucha < 0 || bind(escucha, reinterpret_cast<sockaddr*>(&direccion), sizeof(direccion)) < 0 ||
+        listen(escucha, SOMAXCONN) < 0) {
+        error = "No se pudo abrir " + ruta + ": " + std::strerror(errno);
+        if (escucha >= 0) close(escucha);
+        return false;
+    }
+
+    // SIGINT y SIGTERM se bloquean antes de crear los trabajadores (que heredan la
+    // máscara) y se leen en el bucle desde un signalfd
+    sigset_t senales, anteriores;
+    sigemptyset(&senales);
+    sigaddset(&senales, SIGINT);
+    sigaddset(&senales, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &senales, &anteriores);
+    int descriptorSenales = signalfd(-1, &senales, SFD_NONBLOCK | SFD_CLOEXEC);
+    int aviso = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    int epoll = epoll_create1(EPOLL_CLOEXEC);
+    for (int fd : {escucha, aviso, descriptorSenales}) {
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &ev);
+    }
+
+    if (trabajadores == 0) trabajadores = std::max(1u, std::thread::hardware_concurrency());
+    auto vigente = datos.fijar();
+    std::cout << "Servidor escuchando en " << ruta << " con " << trabajadores << " trabajadores ("
+              << (vigente ? vigente->personas.size() : 0) << " personas). Ctrl+C para terminar.\n";
+    vigente.reset();
+
+    size_t clientes = 0;
+    size_t respondidas = 0;
+    {
+        GrupoTrabajadores grupo(trabajadores, datos, aviso);
+        BucleServidor bucle(epoll, escucha, grupo);
+        std::vector<epoll_event> eventos(256);
+        bool activo = true;
+        while (activo) {
+            int n = epoll_wait(epoll, eventos.data(), static_cast<int>(eventos.size()), -1);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                error = std::string("epoll_wait: ") + std::strerror(errno);
+                break;
+            }
+            for (int k = 0; k < n; ++k) {
+                int fd = eventos[k].data.fd;
+                uint32_t tipo = eventos[k].events;
+                if (fd == escucha) {
+                    bucle.aceptar();
+                } else if (fd == aviso) {
+                    uint64_t avisos;
+                    ssize_t leidos = read(aviso, &avisos, sizeof(avisos));
+                    (void)leidos;
+                    bucle.entregar();
+                } else if (fd == descriptorSenales) {
+                    // Leerla la consume; si no, quedaría pendiente y mataría al proceso al restaurar la máscara
+                    signalfd_siginfo senal;
+                    ssize_t leidos = read(descriptorSenales, &senal, sizeof(senal));
+                    (void)leidos;
+                    activo = false;
+                } else if (tipo & EPOLLOUT) {
+                    if (bucle.escribir(fd) && (tipo & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))) bucle.leer(fd);
+                } else {
+                    bucle.leer(fd);
+                }
+            }
+        }
+        bucle.cerrarTodas();
+        clientes = bucle.clientes;
+        respondidas = bucle.respondidas;
+    }
+
+    close(epoll);
+    close(aviso);
+    close(descriptorSenales);
+    close(escucha);
+    unlink(ruta.c_str());
+    pthread_sigmask(SIG_SETMASK, &anteriores, nullptr);
+    std::cout << "Servidor detenido: " << respondidas << " consultas respondidas a " << clientes << " clientes.\n";
+    return error.empty();
+}
+
+bool consultarServidor(const std::string& ruta, int consulta, double umbral, std::string& error) {
+    int fd = conectar(ruta, error);
+    if (fd < 0) return false;
+
+    EscritorBinario solicitud;
+    uint32_t longitud = consulta == 18 ? sizeof(uint8_t) + sizeof(double) : sizeof(uint8_t);
+    solicitud.valor(longitud);
+    solicitud.valor(static_cast<uint8_t>(consulta));
+    if (consulta == 18) solicitud.valor(umbral);
+
+    // Envía la solicitud completa y lee la respuesta hasta su longitud
+    auto transferir = [&](char* datos, size_t n, bool enviar) {
+        size_t hechos = 0;
+        while (hechos < n) {
+            ssize_t r = enviar ? send(fd, datos + hechos, n - hechos, MSG_NOSIGNAL) : read(fd, datos + hechos, n - hechos);
+            if (r < 0 && errno == EINTR) continue;
+            if (r <= 0) return false;
+            hechos += static_cast<size_t>(r);
+        }
+        return true;
+    };
+    std::string respuesta;
+    uint32_t largo = 0;
+    bool completa = transferir(solicitud.bytes.data(), solicitud.bytes.size(), true) &&
+                    transferir(reinterpret_cast<char*>(&largo), sizeof(largo), false);
+    if (completa) {
+        respuesta.resize(largo);
+        completa = transferir(respuesta.data(), largo, false);
+    }
+    close(fd);
+    if (!completa) {
+        error = "El servidor cerró la conexión";
+        return false;
+    }
+
+    LectorBinario lector(respuesta.data(), respuesta.size());
+    uint8_t estado;
+    uint64_t version;
+    if (!lector.valor(estado) || !lector.valor(version)) {
+        error = "Respuesta inválida";
+        return false;
+    }
+    switch (static_cast<EstadoRespuesta>(estado)) {
+        case EstadoRespuesta::Ok: break;
+        case EstadoRespuesta::SinDatos: error = "El servidor no tiene datos cargados"; return false;
+        case EstadoRespuesta::ConsultaDesconocida: error = "Consulta no disponible en el servidor: " + std::to_string(consulta); return false;
+        default: error = "El servidor rechazó la solicitud"; return false;
+    }
+
+    bool valida = true;
+    Persona persona;
+    std::string llave, nombre, apellido;
+    uint32_t n = 0;
+    // El mismo formato de las consultas locales (Persona::mostrar)
+    std::cout << std::fixed << std::setprecision(2);
+    switch (consulta) {
+        case 0: {
+            uint64_t personas = 0;
+            valida = lector.valor(personas);
+            if (valida) std::cout << "Personas en el servidor: " << personas << " (versión " << version << ")\n";
+            break;
+        }
+        case 2:
+        case 6:
+        case 14:
+            valida = lector.persona(persona);
+            if (valida) persona.mostrar();
+            break;
+        case 4:
+        case 8:
+        case 10:
+            valida = lector.valor(n);
+            for (uint32_t i = 0; valida && i < n; ++i) {
+                valida = lector.texto(llave) && lector.persona(persona);
+                if (valida) {
+                    std::cout << "\n" << llave << ":";
+                    persona.mostrar();
+                }
+            }
+            break;
+        case 16: {
+            long double total = 0;
+            valida = lector.texto(llave) && lector.valor(total);
+            if (valida) std::cout << "Ciudad con mayor patrimonio: " << llave << " = " << total << "\n";
+            break;
+        }
+        case 18: {
+            valida = lector.valor(n);
+            std::cout << "Personas con patrimonio superior a " << umbral << "\n";
+            for (uint32_t i = 0; valida && i < n; ++i) {
+                uint32_t filas = 0;
+                valida = lector.texto(llave) && lector.valor(filas);
+                if (valida) std::cout << "Ciudad:" << llave << "\n";
+                for (uint32_t j = 0; valida && j < filas; ++j) {
+                    double patrimonio = 0;
+                    valida = lector.texto(nombre) && lector.texto(apellido) && lector.valor(patrimonio);
+                    if (valida) std::cout << nombre << " " << apellido << " Patrimonio: " << patrimonio << "\n";
+                }
+            }
+            break;
+        }
+    }
+    if (!valida) error = "Respuesta incompleta";
+    return valida;
+}
@@ -0,0 +1,55 @@
+#ifndef SERVIDOR_H
+#define SERVIDOR_H
+
+#include "instantaneas.h"
+#include <cstdint>
+#include <string>
+
+// Servidor de consultas sobre un socket de dominio Unix y su cliente.
+//
+// Protocolo (enteros y doubles en el orden de bytes del anfitrión; el socket es local):
+//   Solicitud: u32 longitud | u8 consulta | parámetros
+//   Respuesta: u32 longitud | u8 estado | u64 versión del conjunto | resultado
+// La longitud cuenta los bytes que la siguen. Las consultas usan el número de la
+// opción del menú; la 18 acepta un f64 opcional con el umbral (por defecto 1.000
+// millones). Textos: u16 longitud y bytes. Persona: id, nombre, apellido, ciudad,
+// grupo (textos), i32 fecha AAAAMMDD, f64 ingresos, patrimonio y deudas.
+//   0  -> u64 personas
+//   2, 6, 14 -> persona
+//   4, 8, 10 -> u32 n y n veces (texto llave, persona)
+//   16 -> texto ciudad, long double total (16 bytes en x86-64, sin redondear a f64)
+//   18 -> u32 ciudades y por cada una: texto ciudad, u32 n, n veces (texto nombre,
+//         texto apellido, f64 patrimonio)
+
+/**
+ * Estado de una respuesta del servidor.
+ */
+enum class EstadoRespuesta : uint8_t { Ok = 0, SinDatos = 1, ConsultaDesconocida = 2, SolicitudInvalida = 3 };
+
+/**
+ * Atiende consultas sobre la versión publicada hasta recibir SIGINT o SIGTERM.
+ *
+ * POR QUÉ: Cada analista corría su propia copia del programa y cargaba gigabytes de
+ *          datos; un proceso residente los carga una vez para todos.
+ * CÓMO: Un hilo con epoll acepta conexiones, lee solicitudes completas y escribe
+ *       respuestas sin bloquearse; las consultas las calcula un grupo de trabajadores
+ *       que toman tareas de una cola y avisan al bucle con un eventfd. Cada consulta
+ *       fija la versión vigente del publicador, así que una recarga no la afecta.
+ *       Las señales llegan al bucle por un signalfd.
+ * PARA QUÉ: Muchos clientes a la vez con latencias de milisegundos y los datos en
+ *           memoria una sola vez.
+ * @param trabajadores Hilos de consulta (0 = todos los núcleos).
+ * @return false si no se pudo abrir el socket; el motivo queda en error.
+ */
+bool ejecutarServidor(const std::string& ruta, unsigned trabajadores, const PublicadorDatos& datos,
+                      std::string& error);
+
+/**
+ * Envía una consulta al servidor e imprime la respuesta con el formato del menú.
+ *
+ * @param umbral Umbral de la consulta 18 (se ignora en las demás).
+ * @return false si no hubo respuesta válida; el motivo queda en error.
+ */
+bool consultarServidor(const std::string& ruta, int consulta, double umbral, std::string& error);
+
+#endif // SERVIDOR_H
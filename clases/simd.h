@@ -0,0 +1,34 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+/**
+ * Detección de extensiones SIMD en tiempo de ejecución.
+ *
+ * POR QUÉ: El programa se compila para x86-64 genérico (sin -march), pero las
+ *          máquinas donde se mide tienen AVX2 y a veces AVX-512.
+ * CÓMO: __builtin_cpu_supports consulta CPUID una sola vez; las rutas vectoriales
+ *       se compilan con __attribute__((target(...))) y se eligen con estas funciones.
+ * PARA QUÉ: Un solo binario que usa la mejor ruta disponible y sigue funcionando
+ *           (con la ruta escalar) en procesadores sin esas extensiones.
+ */
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMD_X86 1
+
+inline bool tieneAvx2() {
+    static const bool disponible = __builtin_cpu_supports("avx2");
+    return disponible;
+}
+
+inline bool tieneAvx512() {
+    static const bool disponible = __builtin_cpu_supports("avx512f");
+    return disponible;
+}
+
+#else
+
+inline bool tieneAvx2() { return false; }
+inline bool tieneAvx512() { return false; }
+
+#endif
+
+#endif // SIMD_H
@@ -0,0 +1,38 @@
+#include "vistas.h"
+
+CacheResultados::CacheResultados(size_t limiteBytes) : limite(limiteBytes) {}
+
+std::string CacheResultados::llave(int consulta, std::string_view parametros) {
+    std::string texto = std::to_string(consulta);
+    texto += '|';
+    texto += parametros;
+    return texto;
+}
+
+const std::string* CacheResultados::buscar(int consulta, std::string_view parametros, uint64_t version) {
+    auto* entrada = vistas.buscar(llave(consulta, parametros));
+    if (entrada == nullptr || entrada->second.version != version) {
+        ++contadorFallos;
+        return nullptr;
+    }
+    ++contadorAciertos;
+    return &entrada->second.texto;
+}
+
+void CacheResultados::guardar(int consulta, std::string_view parametros, uint64_t version, std::string resultado) {
+    std::string clave = llave(consulta, parametros);
+    if (auto* anterior = vistas.buscar(clave)) {
+        bytesGuardados -= anterior->second.texto.size();
+        vistas.borrar(clave);
+    }
+    if (resultado.size() > limite) return;
+    // Sin política de reemplazo fina: si no cabe, se vacía todo (las vistas son pocas)
+    if (bytesGuardados + resultado.size() > limite) invalidar();
+    bytesGuardados += resultado.size();
+    vistas.insertar(clave, Vista{version, std::move(resultado)});
+}
+
+void CacheResultados::invalidar() {
+    vistas = MapaPlano<std::string, Vista>();
+    bytesGuardados = 0;
+}
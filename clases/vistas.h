@@ -0,0 +1,58 @@
+#ifndef VISTAS_H
+#define VISTAS_H
+
+#include "mapa_plano.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * Resultados ya impresos de las consultas, válidos para una versión del conjunto.
+ *
+ * POR QUÉ: Los tableros piden la ciudad con mayor patrimonio y los máximos por
+ *          ciudad cada pocos segundos, y cada vez se recorría todo el conjunto
+ *          aunque los datos no hubieran cambiado.
+ * CÓMO: Cada vista guarda el texto de una consulta con sus parámetros y la versión
+ *       del conjunto con la que se calculó. La sesión sube la versión al crear,
+ *       importar o modificar datos, así que una vista vieja simplemente no coincide
+ *       y se reemplaza al recalcularla; no hace falta avisar a la caché de cada cambio.
+ * PARA QUÉ: Repetir una consulta sin cambios en los datos cuesta lo que imprimir su
+ *           resultado. Un resultado que no cabe en el límite (p. ej. el listado de
+ *           todos los declarantes) no se guarda.
+ */
+class CacheResultados {
+public:
+    explicit CacheResultados(size_t limiteBytes = 64u << 20);
+
+    /**
+     * Texto guardado de la consulta para esa versión, o nullptr si no hay.
+     */
+    const std::string* buscar(int consulta, std::string_view parametros, uint64_t version);
+
+    /**
+     * Guarda (o reemplaza) el resultado de la consulta para esa versión.
+     */
+    void guardar(int consulta, std::string_view parametros, uint64_t version, std::string resultado);
+
+    void invalidar();
+
+    size_t aciertos() const { return contadorAciertos; }
+    size_t fallos() const { return contadorFallos; }
+    size_t bytes() const { return bytesGuardados; }
+
+private:
+    struct Vista {
+        uint64_t version = 0;
+        std::string texto;
+    };
+
+    static std::string llave(int consulta, std::string_view parametros);
+
+    MapaPlano<std::string, Vista> vistas;
+    size_t limite;
+    size_t bytesGuardados = 0;
+    size_t contadorAciertos = 0;
+    size_t contadorFallos = 0;
+};
+
+#endif // VISTAS_H